@@ -115,6 +115,10 @@ class iter::impl::Accumulator {
     return {get_end(std::as_const(container_)),
         get_end(std::as_const(container_)), accumulate_func_};
   }
+
+  SizeHint size_hint() const {
+    return size_hint_of(std::as_const(container_));
+  }
 };
 
 #endif
@@ -0,0 +1,70 @@
+#ifndef ITER_ASSUME_SORTED_HPP_
+#define ITER_ASSUME_SORTED_HPP_
+
+#include "internal/iterbase.hpp"
+
+#include <type_traits>
+#include <utility>
+
+namespace iter {
+  namespace impl {
+    template <typename Container>
+    class AssumeSorted;
+
+    using AssumeSortedFn = IterToolFn<AssumeSorted>;
+
+    template <typename T>
+    struct is_assumed_sorted_impl : std::false_type {};
+
+    template <typename Container>
+    struct is_assumed_sorted_impl<AssumeSorted<Container>> : std::true_type {};
+
+    // true if the iterable T was wrapped in assume_sorted
+    template <typename T>
+    constexpr bool is_assumed_sorted =
+        is_assumed_sorted_impl<std::remove_cv_t<std::remove_reference_t<T>>>{};
+  }
+  inline constexpr impl::AssumeSortedFn assume_sorted{};
+}
+
+// Yields the elements of the underlying iterable unchanged, and tells the
+// tools given it that the iterable is sorted.  With random access
+// iterators, takewhile and dropwhile then find where the predicate changes
+// with a galloping search, so the predicate must be true for a prefix of
+// the iterable and false for the rest.  groupby finds the end of each
+// group the same way, so each key must form a single run.
+template <typename Container>
+class iter::impl::AssumeSorted {
+ private:
+  Container container_;
+
+  friend AssumeSortedFn;
+
+  AssumeSorted(Container&& container)
+      : container_(std::forward<Container>(container)) {}
+
+ public:
+  AssumeSorted(AssumeSorted&&) = default;
+
+  auto begin() {
+    return get_begin(container_);
+  }
+
+  auto end() {
+    return get_end(container_);
+  }
+
+  auto begin() const {
+    return get_begin(std::as_const(container_));
+  }
+
+  auto end() const {
+    return get_end(std::as_const(container_));
+  }
+
+  SizeHint size_hint() const {
+    return size_hint_of(std::as_const(container_));
+  }
+};
+
+#endif
@@ -78,34 +78,13 @@ class iter::impl::Batcher {
     using pointer = value_type*;
     using reference = value_type&;
 
-    template <typename Iter1, typename Iter2, typename = void>
-    struct distance_helper {
-      static constexpr difference_type distance(Iter1 it1, Iter2 it2) {
-        difference_type dist(0);
-        for (; it1 != it2; ++it1)
-          ++dist;
-        return dist;
-      } 
-    };
-
-    template <typename Iter1, typename Iter2>
-    struct distance_helper<Iter1, Iter2, typename std::enable_if_t<std::is_arithmetic_v<typename Iter1::difference_type> && std::is_arithmetic_v<typename Iter2::difference_type>>> {
-      static constexpr difference_type distance(Iter1 it1, Iter2 it2) {
-        return std::distance(it1, it2);
-      }
-    };
-
-    template <typename Iter1, typename Iter2>
-    difference_type distance(Iter1 it1, Iter2 it2) const {
-      return distance_helper<Iter1, Iter2>::distance(it1, it2);
-    }
-
     Iterator(IteratorWrapper<ContainerT>&& sub_iter,
-        IteratorWrapper<ContainerT>&& sub_end, std::size_t num_batches)
+        IteratorWrapper<ContainerT>&& sub_end, std::size_t num_batches,
+        std::size_t size)
         : sub_iter_{std::move(sub_iter)},
           sub_end_{std::move(sub_end)},
           num_batches_{num_batches},
-          size_{static_cast<std::size_t>(distance(sub_iter_, sub_end_))},
+          size_{size},
           count_{0} {
       refill_batch();
     }
@@ -141,22 +120,31 @@ class iter::impl::Batcher {
     }
   };
 
+  // the size is only needed to begin, and comes from the size hint when
+  // it's exact rather than from an extra pass over the iterable
   Iterator<Container> begin() {
-    return {get_begin(container_), get_end(container_), num_batches_};
+    return {get_begin(container_), get_end(container_), num_batches_,
+        exact_size(container_)};
   }
 
   Iterator<Container> end() {
-    return {get_end(container_), get_end(container_), num_batches_};
+    return {get_end(container_), get_end(container_), num_batches_, 0};
   }
 
   Iterator<AsConst<Container>> begin() const {
     return {get_begin(std::as_const(container_)),
-        get_end(std::as_const(container_)), num_batches_};
+        get_end(std::as_const(container_)), num_batches_,
+        exact_size(std::as_const(container_))};
   }
 
   Iterator<AsConst<Container>> end() const {
     return {get_end(std::as_const(container_)),
-        get_end(std::as_const(container_)), num_batches_};
+        get_end(std::as_const(container_)), num_batches_, 0};
+  }
+
+  SizeHint size_hint() const {
+    return size_hints::min(size_hint_of(std::as_const(container_)),
+        size_hints::exactly(num_batches_));
   }
 };
 
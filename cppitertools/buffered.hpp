@@ -0,0 +1,161 @@
+#ifndef ITER_BUFFERED_HPP_
+#define ITER_BUFFERED_HPP_
+
+#include "internal/iterator_wrapper.hpp"
+#include "internal/iterbase.hpp"
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace iter {
+  namespace impl {
+    template <typename Container>
+    class Buffered;
+
+    using BufferedFn = IterToolFnBindSizeTSecond<Buffered>;
+  }
+  inline constexpr impl::BufferedFn buffered{};
+}
+
+// Pulls elements from the underlying iterable n at a time into a buffer,
+// and yields them from there.  The underlying iterable's work is done in
+// bursts rather than interleaved with the consumer's, which keeps each
+// side's code and data in cache for longer.
+template <typename Container>
+class iter::impl::Buffered {
+ private:
+  Container container_;
+  std::size_t buffer_size_;
+
+  friend BufferedFn;
+
+  Buffered(Container&& container, std::size_t buffer_size)
+      : container_(std::forward<Container>(container)),
+        buffer_size_{buffer_size > 0 ? buffer_size : 1} {}
+
+ public:
+  Buffered(Buffered&&) = default;
+
+  template <typename ContainerT>
+  class Iterator {
+   private:
+    template <typename>
+    friend class Iterator;
+    using Value = std::remove_cv_t<iterator_traits_deref<ContainerT>>;
+
+    IteratorWrapper<ContainerT> sub_iter_;
+    IteratorWrapper<ContainerT> sub_end_;
+    // null for an iterator which starts exhausted, such as end()
+    std::shared_ptr<std::vector<Value>> buffer_;
+    std::size_t buffer_size_;
+    std::size_t index_{};
+
+    void refill() {
+      buffer_->clear();
+      index_ = 0;
+      for (; buffer_->size() < buffer_size_ && sub_iter_ != sub_end_;
+           ++sub_iter_) {
+        buffer_->push_back(*sub_iter_);
+      }
+    }
+
+    bool done() const {
+      return !buffer_ || index_ == buffer_->size();
+    }
+
+   public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = Value;
+    using difference_type = std::ptrdiff_t;
+    using pointer = value_type*;
+    using reference = value_type&;
+
+    Iterator(IteratorWrapper<ContainerT>&& sub_iter,
+        IteratorWrapper<ContainerT>&& sub_end, std::size_t buffer_size)
+        : sub_iter_{std::move(sub_iter)},
+          sub_end_{std::move(sub_end)},
+          buffer_size_{buffer_size} {
+      if (sub_iter_ != sub_end_) {
+        buffer_ = std::make_shared<std::vector<Value>>();
+        buffer_->reserve(buffer_size_);
+        refill();
+      }
+    }
+
+    Value& operator*() {
+      return (*buffer_)[index_];
+    }
+
+    Value* operator->() {
+      return &**this;
+    }
+
+    Iterator& operator++() {
+      ++index_;
+      if (done()) {
+        refill();
+      }
+      return *this;
+    }
+
+    // The buffer is refilled in place, so a postfix increment keeps the old
+    // element in a proxy for *it++
+    class PostIncrement {
+     private:
+      Value value_;
+
+     public:
+      PostIncrement(Value&& value) : value_(std::move(value)) {}
+      Value& operator*() {
+        return value_;
+      }
+    };
+
+    PostIncrement operator++(int) {
+      PostIncrement ret{std::move(**this)};
+      ++*this;
+      return ret;
+    }
+
+    template <typename T>
+    bool operator!=(const Iterator<T>& other) const {
+      if (done() || other.done()) {
+        return done() != other.done();
+      }
+      return sub_iter_ != other.sub_iter_ || index_ != other.index_;
+    }
+
+    template <typename T>
+    bool operator==(const Iterator<T>& other) const {
+      return !(*this != other);
+    }
+  };
+
+  Iterator<Container> begin() {
+    return {get_begin(container_), get_end(container_), buffer_size_};
+  }
+
+  Iterator<Container> end() {
+    return {get_end(container_), get_end(container_), buffer_size_};
+  }
+
+  Iterator<AsConst<Container>> begin() const {
+    return {get_begin(std::as_const(container_)),
+        get_end(std::as_const(container_)), buffer_size_};
+  }
+
+  Iterator<AsConst<Container>> end() const {
+    return {get_end(std::as_const(container_)),
+        get_end(std::as_const(container_)), buffer_size_};
+  }
+
+  SizeHint size_hint() const {
+    return size_hint_of(std::as_const(container_));
+  }
+};
+
+#endif
@@ -2,6 +2,7 @@
 #define ITER_CHAIN_HPP_
 
 #include <array>
+#include <functional>
 #include <iterator>
 #include <optional>
 #include <tuple>
@@ -20,21 +21,14 @@ namespace iter {
     template <typename Container>
     class ChainedFromIterable;
 
+    template <typename Iter>
+    class MaybeIter;
+
     using ChainFromIterableFn = IterToolFn<ChainedFromIterable>;
 
     // rather than a chain function, use a callable object to support
     // from_iterable
     class ChainMaker;
-
-    template <typename>
-    struct AsTupleOfConstImpl;
-
-    template <typename... Ts>
-    struct AsTupleOfConstImpl<std::tuple<Ts...>>
-        : type_is<std::tuple<AsConst<Ts>...>> {};
-
-    template <typename T>
-    using AsTupleOfConst = typename AsTupleOfConstImpl<T>::type;
   }
 }
 
@@ -204,6 +198,93 @@ class iter::impl::Chained {
     return {sizeof...(Is), {get_end(std::as_const(std::get<Is>(tup_)))...},
         {get_end(std::as_const(std::get<Is>(tup_)))...}};
   }
+
+  // Calls func with each chained iterable in turn.  Every call is its own
+  // instantiation with the iterable's real type, so algorithms run on a
+  // segment (std::copy, std::accumulate, ...) see plain iterators rather
+  // than the chain's runtime dispatch.
+  template <typename Func>
+  void for_each_segment(Func&& func) {
+    (static_cast<void>(std::invoke(func, std::get<Is>(tup_))), ...);
+  }
+
+  template <typename Func>
+  void for_each_segment(Func&& func) const {
+    (static_cast<void>(
+        std::invoke(func, std::as_const(std::get<Is>(tup_)))),
+        ...);
+  }
+
+  SizeHint size_hint() const {
+    auto hint = size_hints::exactly(0);
+    ((hint = size_hints::sum(
+          hint, size_hint_of(std::as_const(std::get<Is>(tup_))))),
+        ...);
+    return hint;
+  }
+
+  // Calls func on every element, with a separate typed loop per iterable
+  template <typename Func>
+  Func for_each(Func func) {
+    for_each_segment([&func](auto& segment) { for_each_in(segment, func); });
+    return func;
+  }
+
+  template <typename Func>
+  Func for_each(Func func) const {
+    for_each_segment([&func](auto& segment) { for_each_in(segment, func); });
+    return func;
+  }
+
+ private:
+  template <typename Segment, typename Func>
+  static void for_each_in(Segment& segment, Func& func) {
+    auto sub_end = get_end(segment);
+    for (auto it = get_begin(segment); it != sub_end; ++it) {
+      std::invoke(func, *it);
+    }
+  }
+};
+
+// An iterator which may be absent, held directly next to a flag rather
+// than in a std::optional.  Copying an absent std::optional copies its
+// uninitialized storage, which optimized builds warn about when the copy
+// is used.  Iter must be default constructible.
+template <typename Iter>
+class iter::impl::MaybeIter {
+ private:
+  template <typename>
+  friend class MaybeIter;
+  Iter iter_{};
+  bool engaged_{false};
+
+ public:
+  template <typename T>
+  void emplace(T&& t) {
+    iter_ = Iter(std::forward<T>(t));
+    engaged_ = true;
+  }
+
+  void reset() {
+    engaged_ = false;
+  }
+
+  explicit operator bool() const {
+    return engaged_;
+  }
+
+  Iter& operator*() {
+    return iter_;
+  }
+
+  const Iter& operator*() const {
+    return iter_;
+  }
+
+  template <typename T>
+  bool operator!=(const MaybeIter<T>& other) const {
+    return engaged_ != other.engaged_ || (engaged_ && iter_ != other.iter_);
+  }
 };
 
 template <typename Container>
@@ -224,14 +305,41 @@ class iter::impl::ChainedFromIterable {
     using SubContainer = iterator_deref<ContainerT>;
     using SubIter = IteratorWrapper<SubContainer>;
 
+    // Several passes are only possible when the sub iterables live in the
+    // outer iterable, rather than being produced anew on each dereference.
+    template <typename Tag>
+    static constexpr bool both_levels_are =
+        std::is_lvalue_reference_v<SubContainer>
+        && std::is_reference_v<iterator_deref<SubContainer>>
+        && is_iterator_at_least<iterator_type<ContainerT>, Tag>
+        && is_iterator_at_least<iterator_type<SubContainer>, Tag>;
+
+    // stepping back needs the begin of each sub iterable, and an outer
+    // iterator that can be decremented from the end
+    static constexpr bool is_bidirectional =
+        both_levels_are<std::bidirectional_iterator_tag>
+        && std::is_same_v<iterator_type<ContainerT>,
+               iterator_end_type<ContainerT>>
+        && std::is_same_v<iterator_type<SubContainer>,
+               iterator_end_type<SubContainer>>;
+
+    // forward iterators can be default constructed, so they don't need
+    // std::optional, whose copies optimized builds warn may be read
+    // uninitialized
+    using SubIterHolder = std::conditional_t<
+        is_iterator_at_least<iterator_type<SubContainer>,
+            std::forward_iterator_tag>,
+        MaybeIter<SubIter>, std::optional<SubIter>>;
+
     IteratorWrapper<ContainerT> top_level_iter_;
     IteratorWrapper<ContainerT> top_level_end_;
     DerefHolder<SubContainer> sub_iterable_;
-    std::optional<SubIter> sub_iter_p_;
-    std::optional<SubIter> sub_end_p_;
+    SubIterHolder sub_iter_p_;
+    SubIterHolder sub_end_p_;
 
     void advance_while_empty_sub_iterable() {
-      while (top_level_iter_ != top_level_end_ && sub_iter_p_ == sub_end_p_) {
+      while (top_level_iter_ != top_level_end_
+             && !(*sub_iter_p_ != *sub_end_p_)) {
         ++top_level_iter_;
         update_sub_iterable();
       }
@@ -240,9 +348,8 @@ class iter::impl::ChainedFromIterable {
     void update_sub_iterable() {
       if (top_level_iter_ != top_level_end_) {
         sub_iterable_.reset(*top_level_iter_);
-        sub_iter_p_ =
-            std::make_optional<SubIter>(get_begin(sub_iterable_.get()));
-        sub_end_p_ = std::make_optional<SubIter>(get_end(sub_iterable_.get()));
+        sub_iter_p_.emplace(get_begin(sub_iterable_.get()));
+        sub_end_p_.emplace(get_end(sub_iterable_.get()));
       } else {
         sub_iter_p_.reset();
         sub_end_p_.reset();
@@ -255,7 +362,10 @@ class iter::impl::ChainedFromIterable {
     }
 
    public:
-    using iterator_category = std::input_iterator_tag;
+    using iterator_category = std::conditional_t<is_bidirectional,
+        std::bidirectional_iterator_tag,
+        std::conditional_t<both_levels_are<std::forward_iterator_tag>,
+            std::forward_iterator_tag, std::input_iterator_tag>>;
     using value_type = iterator_traits_deref<iterator_deref<ContainerT>>;
     using difference_type = std::ptrdiff_t;
     using pointer = value_type*;
@@ -283,6 +393,26 @@ class iter::impl::ChainedFromIterable {
       return ret;
     }
 
+    Iterator& operator--() {
+      static_assert(is_bidirectional,
+          "chain.from_iterable can only be decremented when both levels "
+          "are bidirectional and the sub iterables are stored");
+      while (!sub_iter_p_
+             || !(*sub_iter_p_ != get_begin(sub_iterable_.get()))) {
+        --top_level_iter_;
+        update_sub_iterable();
+        sub_iter_p_ = sub_end_p_;
+      }
+      --*sub_iter_p_;
+      return *this;
+    }
+
+    Iterator operator--(int) {
+      auto ret = *this;
+      --*this;
+      return ret;
+    }
+
     template <typename T>
     bool operator!=(const Iterator<T>& other) const {
       return top_level_iter_ != other.top_level_iter_
@@ -320,6 +450,48 @@ class iter::impl::ChainedFromIterable {
     return {
         get_end(std::as_const(container_)), get_end(std::as_const(container_))};
   }
+
+  // Calls func with each sub iterable in turn, so that the inner loop of an
+  // algorithm run on it is an ordinary loop over that iterable.
+  template <typename Func>
+  void for_each_segment(Func&& func) {
+    for_each_segment_in(container_, func);
+  }
+
+  template <typename Func>
+  void for_each_segment(Func&& func) const {
+    for_each_segment_in(std::as_const(container_), func);
+  }
+
+  // Calls func on every element, as a nested loop over both levels
+  template <typename Func>
+  Func for_each(Func func) {
+    for_each_segment([&func](auto&& segment) { for_each_in(segment, func); });
+    return func;
+  }
+
+  template <typename Func>
+  Func for_each(Func func) const {
+    for_each_segment([&func](auto&& segment) { for_each_in(segment, func); });
+    return func;
+  }
+
+ private:
+  template <typename Top, typename Func>
+  static void for_each_segment_in(Top& top, Func& func) {
+    auto top_end = get_end(top);
+    for (auto it = get_begin(top); it != top_end; ++it) {
+      std::invoke(func, *it);
+    }
+  }
+
+  template <typename Segment, typename Func>
+  static void for_each_in(Segment&& segment, Func& func) {
+    auto sub_end = get_end(segment);
+    for (auto it = get_begin(segment); it != sub_end; ++it) {
+      std::invoke(func, *it);
+    }
+  }
 };
 
 class iter::impl::ChainMaker {
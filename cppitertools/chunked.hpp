@@ -4,6 +4,7 @@
 #include "internal/iterator_wrapper.hpp"
 #include "internal/iteratoriterator.hpp"
 #include "internal/iterbase.hpp"
+#include "range.hpp"
 
 #include <algorithm>
 #include <functional>
@@ -18,9 +19,8 @@ namespace iter {
     template <typename Container>
     class Chunker;
 
-    using ChunkedFn = IterToolFnBindSizeTSecond<Chunker>;
+    struct ChunkedFn;
   }
-  inline constexpr impl::ChunkedFn chunked{};
 }
 
 template <typename Container>
@@ -130,6 +130,47 @@ class iter::impl::Chunker {
     return {get_end(std::as_const(container_)),
         get_end(std::as_const(container_)), chunk_size_};
   }
+
+  SizeHint size_hint() const {
+    return size_hints::map(size_hint_of(std::as_const(container_)),
+        [k = chunk_size_](std::size_t n) -> std::optional<std::size_t> {
+          return k == 0 ? 0 : n / k + (n % k != 0);
+        });
+  }
+};
+
+// like IterToolFnBindSizeTSecond, but integral ranges are routed to
+// Range::chunked, which produces a sequence of ranges directly
+struct iter::impl::ChunkedFn {
+ private:
+  struct FnPartial : Pipeable<FnPartial> {
+    std::size_t sz{};
+    constexpr FnPartial(std::size_t in_sz) : sz{in_sz} {}
+
+    template <typename Container>
+    auto operator()(Container&& container) const {
+      return ChunkedFn{}(std::forward<Container>(container), sz);
+    }
+  };
+
+ public:
+  FnPartial operator()(std::size_t sz) const {
+    return {sz};
+  }
+
+  template <typename Container,
+      typename = std::enable_if_t<is_iterable<Container>>>
+  auto operator()(Container&& container, std::size_t sz) const {
+    if constexpr (is_integral_range<Container>) {
+      return container.chunked(sz);
+    } else {
+      return Chunker<Container>{std::forward<Container>(container), sz};
+    }
+  }
 };
 
+namespace iter {
+  inline constexpr impl::ChunkedFn chunked{};
+}
+
 #endif
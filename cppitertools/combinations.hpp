@@ -164,6 +164,11 @@ class iter::impl::Combinator {
     }
     return {std::as_const(container_), 0};
   }
+
+  SizeHint size_hint() const {
+    return size_hints::map(size_hint_of(std::as_const(container_)),
+        [k = length_](std::size_t n) { return size_hints::choose(n, k); });
+  }
 };
 
 #endif
@@ -5,6 +5,7 @@
 #include "internal/iterbase.hpp"
 
 #include <iterator>
+#include <optional>
 #include <type_traits>
 #include <vector>
 
@@ -143,6 +144,23 @@ class iter::impl::CombinatorWithReplacement {
     }
     return {std::as_const(container_), 0};
   }
+
+  // n + k - 1 choose k
+  SizeHint size_hint() const {
+    return size_hints::map(size_hint_of(std::as_const(container_)),
+        [k = length_](std::size_t n) -> std::optional<std::size_t> {
+          if (k == 0) {
+            return 1;
+          }
+          if (n == 0) {
+            return 0;
+          }
+          if (n - 1 > size_hints::Unbounded - k) {
+            return std::nullopt;
+          }
+          return size_hints::choose(n - 1 + k, k);
+        });
+  }
 };
 
 #endif
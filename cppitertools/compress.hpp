@@ -4,17 +4,62 @@
 #include "internal/iterator_wrapper.hpp"
 #include "internal/iterbase.hpp"
 
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
 #include <iterator>
+#include <limits>
+#include <type_traits>
 #include <utility>
 
 namespace iter {
   namespace impl {
     template <typename Container, typename Selector>
     class Compressed;
+
+    template <typename Words>
+    class BitMask;
+
+    template <typename Indices>
+    class IndexList;
+
+    template <typename Bits>
+    class BitsetMask;
+
+    template <typename Container, typename Selector>
+    class IndexCompressed;
+
+    // Selectors of one truthy value per element make a Compressed, and
+    // those of the positions to yield make an IndexCompressed
+    template <typename Container, typename Selector,
+        typename Plain = std::remove_cv_t<std::remove_reference_t<Selector>>>
+    struct CompressedTypeFor : type_is<Compressed<Container, Selector>> {};
+
+    template <typename Container, typename Selector, typename Words>
+    struct CompressedTypeFor<Container, Selector, BitMask<Words>>
+        : type_is<IndexCompressed<Container, Selector>> {};
+
+    template <typename Container, typename Selector, typename Indices>
+    struct CompressedTypeFor<Container, Selector, IndexList<Indices>>
+        : type_is<IndexCompressed<Container, Selector>> {};
+
+    template <typename Container, typename Selector, std::size_t N>
+    struct CompressedTypeFor<Container, Selector, std::bitset<N>>
+        : type_is<IndexCompressed<Container, BitsetMask<Selector>>> {};
+
+    template <typename Container, typename Selector>
+    using CompressedType =
+        typename CompressedTypeFor<Container, Selector>::type;
   }
 
   template <typename Container, typename Selector>
-  impl::Compressed<Container, Selector> compress(Container&&, Selector&&);
+  impl::CompressedType<Container, Selector> compress(Container&&, Selector&&);
+
+  template <typename Words>
+  impl::BitMask<Words> bitmask(Words&&);
+
+  template <typename Indices>
+  impl::IndexList<Indices> indices(Indices&&);
 }
 
 template <typename Container, typename Selector>
@@ -128,13 +173,326 @@ class iter::impl::Compressed {
         get_end(std::as_const(selectors_)),
         get_end(std::as_const(selectors_))};
   }
+
+  SizeHint size_hint() const {
+    return size_hints::at_most(
+        size_hints::min(size_hint_of(std::as_const(container_)),
+            size_hint_of(std::as_const(selectors_))));
+  }
+};
+
+// A selector made of packed words of an unsigned integer type, where bit j
+// of word i selects element i * digits + j, with the lowest bit first.
+// Only the set bits are visited, so sparse masks skip zero words whole.
+template <typename Words>
+class iter::impl::BitMask {
+ private:
+  Words words_;
+
+  friend BitMask iter::bitmask<Words>(Words&&);
+
+  BitMask(Words&& words) : words_(std::forward<Words>(words)) {}
+
+ public:
+  BitMask(BitMask&&) = default;
+
+  template <typename WordsT>
+  class Cursor {
+   private:
+    using Word = std::remove_cv_t<std::remove_reference_t<
+        iterator_deref<WordsT>>>;
+    static_assert(std::is_unsigned_v<Word>
+                      && std::numeric_limits<Word>::digits <= 64,
+        "bitmask words must be unsigned integers of at most 64 bits");
+    static constexpr std::size_t WordBits = std::numeric_limits<Word>::digits;
+
+    IteratorWrapper<WordsT> word_iter_;
+    IteratorWrapper<WordsT> word_end_;
+    // the unvisited set bits of the current word
+    std::uint64_t bits_{0};
+    std::size_t word_start_{0};
+    std::size_t next_word_start_{0};
+
+   public:
+    Cursor(WordsT& words)
+        : word_iter_{get_begin(words)}, word_end_{get_end(words)} {}
+
+    // sets index to the next selected index, or returns false
+    bool next(std::size_t& index) {
+      while (bits_ == 0) {
+        if (word_iter_ == word_end_) {
+          return false;
+        }
+        bits_ = static_cast<std::uint64_t>(*word_iter_);
+        ++word_iter_;
+        word_start_ = next_word_start_;
+        next_word_start_ += WordBits;
+      }
+      index = word_start_ + lowest_bit(bits_);
+      bits_ &= bits_ - 1;
+      return true;
+    }
+  };
+
+  Cursor<Words> cursor() {
+    return {words_};
+  }
+
+  Cursor<AsConst<Words>> cursor() const {
+    return {std::as_const(words_)};
+  }
+};
+
+// A selector over a std::bitset, which doesn't expose its words, so each
+// bit is tested in turn.  The data is still only visited at the set bits.
+template <typename Bits>
+class iter::impl::BitsetMask {
+ private:
+  Bits bits_;
+
+  template <typename C, typename S>
+  friend CompressedType<C, S> iter::compress(C&&, S&&);
+
+  BitsetMask(Bits&& bits) : bits_(std::forward<Bits>(bits)) {}
+
+ public:
+  BitsetMask(BitsetMask&&) = default;
+
+  class Cursor {
+   private:
+    const std::remove_reference_t<Bits>* bits_;
+    std::size_t pos_{0};
+
+   public:
+    Cursor(const std::remove_reference_t<Bits>& bits) : bits_{&bits} {}
+
+    bool next(std::size_t& index) {
+      while (pos_ < bits_->size()) {
+        if (bits_->test(pos_++)) {
+          index = pos_ - 1;
+          return true;
+        }
+      }
+      return false;
+    }
+  };
+
+  Cursor cursor() const {
+    return {bits_};
+  }
+};
+
+// A selector made of the indices of the elements to yield
+template <typename Indices>
+class iter::impl::IndexList {
+ private:
+  Indices indices_;
+
+  friend IndexList iter::indices<Indices>(Indices&&);
+
+  IndexList(Indices&& indices) : indices_(std::forward<Indices>(indices)) {}
+
+ public:
+  IndexList(IndexList&&) = default;
+
+  template <typename IndicesT>
+  class Cursor {
+   private:
+    IteratorWrapper<IndicesT> index_iter_;
+    IteratorWrapper<IndicesT> index_end_;
+
+   public:
+    Cursor(IndicesT& indices)
+        : index_iter_{get_begin(indices)}, index_end_{get_end(indices)} {}
+
+    bool next(std::size_t& index) {
+      if (index_iter_ == index_end_) {
+        return false;
+      }
+      index = static_cast<std::size_t>(*index_iter_);
+      ++index_iter_;
+      return true;
+    }
+  };
+
+  Cursor<Indices> cursor() {
+    return {indices_};
+  }
+
+  Cursor<AsConst<Indices>> cursor() const {
+    return {std::as_const(indices_)};
+  }
+};
+
+// compress with a bitmask, a std::bitset or an index list, each held by
+// reference if it was an lvalue.  On random access data each
+// selected element is reached directly, indices may come in any order, and
+// those past the end are skipped.  Otherwise the data is walked forward to
+// each index in turn, so they must be ascending, and the first one past the
+// end, or smaller than the one before it, ends the iteration.
+template <typename Container, typename Selector>
+class iter::impl::IndexCompressed {
+ private:
+  Container container_;
+  Selector selector_;
+
+  template <typename C, typename S>
+  friend CompressedType<C, S> iter::compress(C&&, S&&);
+
+  IndexCompressed(Container&& container, Selector&& selector)
+      : container_(std::forward<Container>(container)),
+        selector_(std::forward<Selector>(selector)) {}
+
+ public:
+  IndexCompressed(IndexCompressed&&) = default;
+
+  template <typename ContainerT, typename CursorT>
+  class Iterator {
+   private:
+    template <typename, typename>
+    friend class Iterator;
+
+    static constexpr bool RandomAccess =
+        is_iterator_at_least<IteratorWrapper<ContainerT>,
+            std::random_access_iterator_tag>;
+
+    IteratorWrapper<ContainerT> first_;
+    IteratorWrapper<ContainerT> sub_iter_;
+    IteratorWrapper<ContainerT> sub_end_;
+    CursorT cursor_;
+    // the index of sub_iter_
+    std::size_t pos_{0};
+    bool done_;
+
+    void advance() {
+      std::size_t target;
+      if constexpr (RandomAccess) {
+        const auto size = static_cast<std::size_t>(sub_end_ - first_);
+        do {
+          if (!cursor_.next(target)) {
+            done_ = true;
+            return;
+          }
+        } while (target >= size);
+        sub_iter_ = first_ + static_cast<std::ptrdiff_t>(target);
+      } else {
+        if (!cursor_.next(target) || target < pos_) {
+          done_ = true;
+          return;
+        }
+        dumb_advance(sub_iter_, sub_end_, target - pos_);
+        if (sub_iter_ == sub_end_) {
+          done_ = true;
+          return;
+        }
+      }
+      pos_ = target;
+    }
+
+   public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = iterator_traits_deref<ContainerT>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = value_type*;
+    using reference = value_type&;
+
+    Iterator(IteratorWrapper<ContainerT>&& sub_iter,
+        IteratorWrapper<ContainerT>&& sub_end, CursorT&& cursor, bool done)
+        : first_{sub_iter},
+          sub_iter_{std::move(sub_iter)},
+          sub_end_{std::move(sub_end)},
+          cursor_(std::move(cursor)),
+          done_{done} {
+      if (!done_) {
+        advance();
+      }
+    }
+
+    iterator_deref<ContainerT> operator*() {
+      return *sub_iter_;
+    }
+
+    iterator_arrow<ContainerT> operator->() {
+      return apply_arrow(sub_iter_);
+    }
+
+    Iterator& operator++() {
+      advance();
+      return *this;
+    }
+
+    Iterator operator++(int) {
+      auto ret = *this;
+      ++*this;
+      return ret;
+    }
+
+    template <typename T, typename U>
+    bool operator!=(const Iterator<T, U>& other) const {
+      return done_ != other.done_ || (!done_ && pos_ != other.pos_);
+    }
+
+    template <typename T, typename U>
+    bool operator==(const Iterator<T, U>& other) const {
+      return !(*this != other);
+    }
+  };
+
+ private:
+  using CursorType = decltype(std::declval<Selector&>().cursor());
+  using ConstCursorType = decltype(
+      std::declval<const std::remove_reference_t<Selector>&>().cursor());
+
+ public:
+  Iterator<Container, CursorType> begin() {
+    return {get_begin(container_), get_end(container_), selector_.cursor(),
+        false};
+  }
+
+  Iterator<Container, CursorType> end() {
+    return {get_end(container_), get_end(container_), selector_.cursor(),
+        true};
+  }
+
+  Iterator<AsConst<Container>, ConstCursorType> begin() const {
+    return {get_begin(std::as_const(container_)),
+        get_end(std::as_const(container_)), std::as_const(selector_).cursor(),
+        false};
+  }
+
+  Iterator<AsConst<Container>, ConstCursorType> end() const {
+    return {get_end(std::as_const(container_)),
+        get_end(std::as_const(container_)), std::as_const(selector_).cursor(),
+        true};
+  }
+
+  SizeHint size_hint() const {
+    return size_hints::at_most(size_hint_of(std::as_const(container_)));
+  }
 };
 
 template <typename Container, typename Selector>
-iter::impl::Compressed<Container, Selector> iter::compress(
+iter::impl::CompressedType<Container, Selector> iter::compress(
     Container&& container_, Selector&& selectors_) {
-  return {
-      std::forward<Container>(container_), std::forward<Selector>(selectors_)};
+  using Bitset = impl::BitsetMask<Selector>;
+  if constexpr (std::is_same_v<impl::CompressedType<Container, Selector>,
+                    impl::IndexCompressed<Container, Bitset>>) {
+    return {std::forward<Container>(container_),
+        Bitset{std::forward<Selector>(selectors_)}};
+  } else {
+    return {std::forward<Container>(container_),
+        std::forward<Selector>(selectors_)};
+  }
+}
+
+template <typename Words>
+iter::impl::BitMask<Words> iter::bitmask(Words&& words) {
+  return {std::forward<Words>(words)};
+}
+
+template <typename Indices>
+iter::impl::IndexList<Indices> iter::indices(Indices&& indices) {
+  return {std::forward<Indices>(indices)};
 }
 
 #endif
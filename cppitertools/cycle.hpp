@@ -103,6 +103,18 @@ class iter::impl::Cycler {
     return {get_end(std::as_const(container_)),
         get_end(std::as_const(container_))};
   }
+
+  // endless unless the iterable is empty
+  SizeHint size_hint() const {
+    auto hint = size_hint_of(std::as_const(container_));
+    if (hint.upper == std::optional<std::size_t>{0}) {
+      return hint;
+    }
+    if (hint.lower > 0) {
+      return size_hints::infinite();
+    }
+    return {};
+  }
 };
 
 #endif
@@ -1,6 +1,7 @@
 #ifndef ITER_DROPWHILE_H_
 #define ITER_DROPWHILE_H_
 
+#include "assume_sorted.hpp"
 #include "filter.hpp"
 #include "internal/iterator_wrapper.hpp"
 #include "internal/iterbase.hpp"
@@ -61,8 +62,19 @@ class iter::impl::Dropper {
 
     void init_if_first_use() const {
       if (!item_ && sub_iter_ != sub_end_) {
-        item_.reset(*sub_iter_);
-        skip_passes();
+        // a sorted random access iterable is searched instead
+        if constexpr (is_assumed_sorted<ContainerT>
+                      && is_random_access_iter<
+                          IteratorWrapper<ContainerT>>{}) {
+          sub_iter_ =
+              gallop_partition_point(sub_iter_, sub_end_, *filter_func_);
+          if (sub_iter_ != sub_end_) {
+            item_.reset(*sub_iter_);
+          }
+        } else {
+          item_.reset(*sub_iter_);
+          skip_passes();
+        }
       }
     }
 
@@ -131,6 +143,10 @@ class iter::impl::Dropper {
     return {get_end(std::as_const(container_)),
         get_end(std::as_const(container_)), filter_func_};
   }
+
+  SizeHint size_hint() const {
+    return size_hints::at_most(size_hint_of(std::as_const(container_)));
+  }
 };
 
 #endif
@@ -131,5 +131,9 @@ class iter::impl::Enumerable {
   Iterator<AsConst<Container>> end() const {
     return {get_end(std::as_const(container_)), start_};
   }
+
+  SizeHint size_hint() const {
+    return size_hint_of(std::as_const(container_));
+  }
 };
 #endif
@@ -4,9 +4,14 @@
 #include "internal/iterator_wrapper.hpp"
 #include "internal/iterbase.hpp"
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <functional>
 #include <initializer_list>
 #include <iterator>
+#include <type_traits>
 #include <utility>
 
 namespace iter {
@@ -14,6 +19,9 @@ namespace iter {
     template <typename FilterFunc, typename Container>
     class Filtered;
 
+    template <typename FilterFunc, typename Container>
+    class BlockFiltered;
+
     struct BoolTester {
       template <typename T>
       constexpr bool operator()(const T& item_) const {
@@ -22,9 +30,16 @@ namespace iter {
     };
 
     using FilterFn = IterToolFnOptionalBindFirst<Filtered, BoolTester>;
+    using BlockFilterFn =
+        IterToolFnOptionalBindFirst<BlockFiltered, BoolTester>;
+
+    // filter, with filter.blocked for contiguous iterables
+    struct FilterMaker : FilterFn {
+      BlockFilterFn blocked;
+    };
   }
 
-  inline constexpr impl::FilterFn filter{};
+  inline constexpr impl::FilterMaker filter{};
 }
 
 template <typename FilterFunc, typename Container>
@@ -148,6 +163,178 @@ class iter::impl::Filtered {
     return {get_end(std::as_const(container_)),
         get_end(std::as_const(container_)), filter_func_};
   }
+
+  SizeHint size_hint() const {
+    return size_hints::at_most(size_hint_of(std::as_const(container_)));
+  }
+};
+
+// filter.blocked(pred, seq) filters an iterable whose elements are stored
+// contiguously, such as a vector or an array, a block of 64 elements at a
+// time.  The predicate is called for the whole block in one loop, which
+// the compiler can vectorize for simple predicates, and the results are
+// kept as a bit mask from which the survivors are yielded.  Elements are
+// yielded by reference, as with filter, but the predicate can be called up
+// to 63 elements ahead of the element being yielded.
+template <typename FilterFunc, typename Container>
+class iter::impl::BlockFiltered {
+  static_assert(!std::is_reference_v<FilterFunc>);
+
+ private:
+  Container container_;
+  mutable FilterFunc filter_func_;
+
+  friend BlockFilterFn;
+
+ protected:
+  BlockFiltered(FilterFunc filter_func, Container&& container)
+      : container_(std::forward<Container>(container)),
+        filter_func_(std::move(filter_func)) {}
+
+ public:
+  BlockFiltered(BlockFiltered&&) = default;
+
+  template <typename ContainerT>
+  class Iterator {
+   private:
+    template <typename>
+    friend class Iterator;
+
+    static constexpr std::size_t BlockSize = 64;
+    using Data = decltype(std::data(std::declval<ContainerT&>()));
+
+    Data data_{};
+    std::size_t size_{};
+    FilterFunc* filter_func_{};
+    std::size_t block_start_{};
+    // the survivors of the current block not yet yielded, and the index of
+    // the current one, which is size_ at the end
+    std::uint64_t mask_{};
+    std::size_t index_{};
+
+    // packs 8 bools into the bits of a byte, the first into the lowest
+    static unsigned gather_bits(const bool* keep) {
+#if defined(_MSC_VER) \
+    || (defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+      if constexpr (sizeof(bool) == 1) {
+        // each byte is 0 or 1, and the multiply moves bit 8j to bit 56 + j
+        std::uint64_t bytes;
+        std::memcpy(&bytes, keep, sizeof(bytes));
+        return static_cast<unsigned>((bytes * 0x0102040810204080u) >> 56);
+      }
+#endif
+      unsigned bits = 0;
+      for (unsigned j = 0; j < 8; ++j) {
+        bits |= unsigned{keep[j]} << j;
+      }
+      return bits;
+    }
+
+    // finds the first block from start on with a survivor
+    void scan_from(std::size_t start) {
+      for (; start < size_; start += BlockSize) {
+        const auto n = std::min(BlockSize, size_ - start);
+        const auto block = data_ + start;
+        bool keep[BlockSize] = {};
+        auto& func = *filter_func_;
+        if (n == BlockSize) {
+          for (std::size_t i = 0; i < BlockSize; ++i) {
+            keep[i] = bool(std::invoke(func, block[i]));
+          }
+        } else {
+          for (std::size_t i = 0; i < n; ++i) {
+            keep[i] = bool(std::invoke(func, block[i]));
+          }
+        }
+        std::uint64_t mask = 0;
+        for (std::size_t i = 0; i < BlockSize; i += 8) {
+          mask |= std::uint64_t{gather_bits(keep + i)} << i;
+        }
+        if (mask != 0) {
+          block_start_ = start;
+          mask_ = mask;
+          index_ = start + lowest_bit(mask);
+          return;
+        }
+      }
+      mask_ = 0;
+      index_ = size_;
+    }
+
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = std::remove_cv_t<std::remove_reference_t<decltype(
+        *std::declval<Data>())>>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = Data;
+    using reference = decltype(*std::declval<Data>());
+
+    Iterator() = default;
+
+    Iterator(ContainerT& container, FilterFunc& filter_func, bool is_end)
+        : data_{std::data(container)},
+          size_{static_cast<std::size_t>(std::size(container))},
+          filter_func_{&filter_func},
+          index_{size_} {
+      if (!is_end) {
+        scan_from(0);
+      }
+    }
+
+    reference operator*() const {
+      return data_[index_];
+    }
+
+    pointer operator->() const {
+      return data_ + index_;
+    }
+
+    Iterator& operator++() {
+      mask_ &= mask_ - 1;
+      if (mask_ != 0) {
+        index_ = block_start_ + lowest_bit(mask_);
+      } else {
+        scan_from(block_start_ + BlockSize);
+      }
+      return *this;
+    }
+
+    Iterator operator++(int) {
+      auto ret = *this;
+      ++*this;
+      return ret;
+    }
+
+    template <typename T>
+    bool operator!=(const Iterator<T>& other) const {
+      return index_ != other.index_;
+    }
+
+    template <typename T>
+    bool operator==(const Iterator<T>& other) const {
+      return !(*this != other);
+    }
+  };
+
+  Iterator<Container> begin() {
+    return {container_, filter_func_, false};
+  }
+
+  Iterator<Container> end() {
+    return {container_, filter_func_, true};
+  }
+
+  Iterator<AsConst<Container>> begin() const {
+    return {std::as_const(container_), filter_func_, false};
+  }
+
+  Iterator<AsConst<Container>> end() const {
+    return {std::as_const(container_), filter_func_, true};
+  }
+
+  SizeHint size_hint() const {
+    return size_hints::at_most(size_hint_of(std::as_const(container_)));
+  }
 };
 
 #endif
@@ -36,9 +36,19 @@ namespace iter {
     template <typename FilterFunc, typename Container>
     class FilterFalsed;
 
+    template <typename FilterFunc, typename Container>
+    class BlockFilterFalsed;
+
     using FilterFalseFn = IterToolFnOptionalBindFirst<FilterFalsed, BoolTester>;
+    using BlockFilterFalseFn =
+        IterToolFnOptionalBindFirst<BlockFilterFalsed, BoolTester>;
+
+    // filterfalse, with filterfalse.blocked for contiguous iterables
+    struct FilterFalseMaker : FilterFalseFn {
+      BlockFilterFalseFn blocked;
+    };
   }
-  inline constexpr impl::FilterFalseFn filterfalse{};
+  inline constexpr impl::FilterFalseMaker filterfalse{};
 }
 
 // Delegates to Filtered with PredicateFlipper<FilterFunc>
@@ -52,4 +62,15 @@ class iter::impl::FilterFalsed
             std::forward<Container>(in_container)) {}
 };
 
+// Delegates to BlockFiltered with PredicateFlipper<FilterFunc>
+template <typename FilterFunc, typename Container>
+class iter::impl::BlockFilterFalsed
+    : public BlockFiltered<PredicateFlipper<FilterFunc>, Container> {
+  friend BlockFilterFalseFn;
+  BlockFilterFalsed(FilterFunc in_filter_func, Container&& in_container)
+      : BlockFiltered<PredicateFlipper<FilterFunc>, Container>(
+            {std::move(in_filter_func)},
+            std::forward<Container>(in_container)) {}
+};
+
 #endif
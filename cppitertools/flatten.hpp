@@ -0,0 +1,237 @@
+#ifndef ITER_FLATTEN_HPP_
+#define ITER_FLATTEN_HPP_
+
+#include "internal/iterbase.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace iter {
+  namespace impl {
+    template <typename Container>
+    class Flattened;
+
+    using FlattenFn = IterToolFn<Flattened>;
+  }
+  inline constexpr impl::FlattenFn flatten{};
+}
+
+// A random access iterable of random access rows, viewed as one sequence.
+// The number of elements before each row is counted once on construction,
+// so the row holding any element is found with a binary search.  The rows
+// may be modified but not resized while the Flattened object is in use.
+template <typename Container>
+class iter::impl::Flattened {
+ private:
+  using Row = iterator_deref<Container>;
+
+  static_assert(has_random_access_iter<Container>{},
+      "flatten requires a random access iterable");
+  static_assert(std::is_lvalue_reference_v<Row>,
+      "flatten requires an iterable whose rows are stored in it");
+  static_assert(has_random_access_iter<Row>{},
+      "flatten requires rows that are random access iterables");
+
+  friend FlattenFn;
+
+  Container container_;
+  // offsets_[i] is the number of elements in the rows before row i, and
+  // offsets_.back() is the total
+  std::vector<std::size_t> offsets_;
+
+  Flattened(Container&& container)
+      : container_(std::forward<Container>(container)) {
+    offsets_.push_back(0);
+    auto top_end = get_end(container_);
+    for (auto it = get_begin(container_); it != top_end; ++it) {
+      auto&& row = *it;
+      offsets_.push_back(offsets_.back()
+                         + static_cast<std::size_t>(
+                               get_end(row) - get_begin(row)));
+    }
+  }
+
+  // the row holding element i, skipping empty rows, or the number of rows
+  // when i is the total
+  static std::size_t row_of(
+      const std::size_t* offsets, std::size_t num_rows, std::size_t i) {
+    return static_cast<std::size_t>(
+               std::upper_bound(offsets, offsets + num_rows + 1, i) - offsets)
+           - 1;
+  }
+
+ public:
+  Flattened(Flattened&&) = default;
+
+  template <typename ContainerT>
+  class Iterator {
+   private:
+    template <typename>
+    friend class Iterator;
+    using RowT = iterator_deref<ContainerT>;
+
+    iterator_type<ContainerT> rows_;
+    // points into the Flattened object's offsets_, which stays put when the
+    // Flattened object is moved
+    const std::size_t* offsets_;
+    std::size_t num_rows_;
+    std::size_t row_;
+    std::size_t index_;
+
+   public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = iterator_traits_deref<RowT>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = value_type*;
+    using reference = iterator_deref<RowT>;
+
+    Iterator(iterator_type<ContainerT>&& rows, const std::size_t* offsets,
+        std::size_t num_rows, std::size_t index)
+        : rows_{std::move(rows)},
+          offsets_{offsets},
+          num_rows_{num_rows},
+          row_{row_of(offsets, num_rows, index)},
+          index_{index} {}
+
+    iterator_deref<RowT> operator*() const {
+      return get_begin(rows_[static_cast<difference_type>(row_)])
+          [static_cast<difference_type>(index_ - offsets_[row_])];
+    }
+
+    iterator_arrow<RowT> operator->() const {
+      auto it = get_begin(rows_[static_cast<difference_type>(row_)])
+                + static_cast<difference_type>(index_ - offsets_[row_]);
+      return apply_arrow(it);
+    }
+
+    iterator_deref<RowT> operator[](difference_type n) const {
+      return *(*this + n);
+    }
+
+    Iterator& operator++() {
+      ++index_;
+      while (row_ < num_rows_ && offsets_[row_ + 1] <= index_) {
+        ++row_;
+      }
+      return *this;
+    }
+
+    Iterator operator++(int) {
+      auto ret = *this;
+      ++*this;
+      return ret;
+    }
+
+    Iterator& operator--() {
+      --index_;
+      while (offsets_[row_] > index_) {
+        --row_;
+      }
+      return *this;
+    }
+
+    Iterator operator--(int) {
+      auto ret = *this;
+      --*this;
+      return ret;
+    }
+
+    Iterator& operator+=(difference_type n) {
+      index_ += static_cast<std::size_t>(n);
+      row_ = row_of(offsets_, num_rows_, index_);
+      return *this;
+    }
+
+    Iterator& operator-=(difference_type n) {
+      return *this += -n;
+    }
+
+    friend Iterator operator+(Iterator it, difference_type n) {
+      return it += n;
+    }
+
+    friend Iterator operator+(difference_type n, Iterator it) {
+      return it += n;
+    }
+
+    friend Iterator operator-(Iterator it, difference_type n) {
+      return it -= n;
+    }
+
+    template <typename T>
+    difference_type operator-(const Iterator<T>& other) const {
+      return static_cast<difference_type>(index_)
+             - static_cast<difference_type>(other.index_);
+    }
+
+    template <typename T>
+    bool operator==(const Iterator<T>& other) const {
+      return index_ == other.index_;
+    }
+
+    template <typename T>
+    bool operator!=(const Iterator<T>& other) const {
+      return !(*this == other);
+    }
+
+    template <typename T>
+    bool operator<(const Iterator<T>& other) const {
+      return index_ < other.index_;
+    }
+
+    template <typename T>
+    bool operator>(const Iterator<T>& other) const {
+      return other < *this;
+    }
+
+    template <typename T>
+    bool operator<=(const Iterator<T>& other) const {
+      return !(other < *this);
+    }
+
+    template <typename T>
+    bool operator>=(const Iterator<T>& other) const {
+      return !(*this < other);
+    }
+  };
+
+  Iterator<Container> begin() {
+    return {get_begin(container_), offsets_.data(), offsets_.size() - 1, 0};
+  }
+
+  Iterator<Container> end() {
+    return {get_begin(container_), offsets_.data(), offsets_.size() - 1,
+        size()};
+  }
+
+  Iterator<AsConst<Container>> begin() const {
+    return {get_begin(std::as_const(container_)), offsets_.data(),
+        offsets_.size() - 1, 0};
+  }
+
+  Iterator<AsConst<Container>> end() const {
+    return {get_begin(std::as_const(container_)), offsets_.data(),
+        offsets_.size() - 1, size()};
+  }
+
+  std::size_t size() const {
+    return offsets_.back();
+  }
+
+  iterator_deref<Row> operator[](std::size_t i) {
+    return *Iterator<Container>{
+        get_begin(container_), offsets_.data(), offsets_.size() - 1, i};
+  }
+
+  iterator_deref<iterator_deref<AsConst<Container>>> operator[](
+      std::size_t i) const {
+    return *Iterator<AsConst<Container>>{get_begin(std::as_const(container_)),
+        offsets_.data(), offsets_.size() - 1, i};
+  }
+};
+
+#endif
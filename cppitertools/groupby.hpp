@@ -3,6 +3,7 @@
 
 // this is easily the most functionally complex itertool
 
+#include "assume_sorted.hpp"
 #include "internal/iterator_wrapper.hpp"
 #include "internal/iterbase.hpp"
 
@@ -47,10 +48,18 @@ class iter::impl::GroupProducer {
   class Group;
 
  private:
-  template <typename T>
-  using KeyGroupPair = std::pair<key_func_ret<T>, Group<T>>;
   template <typename T>
   using Holder = DerefHolder<iterator_deref<T>>;
+  // When the held item is a value, a reference returned by the key function
+  // may point into it, and the item is replaced on increment, so the key is
+  // copied out.
+  template <typename T>
+  using key_type = std::conditional_t<
+      Holder<T>::stores_value && std::is_reference_v<key_func_ret<T>>,
+      std::remove_cv_t<std::remove_reference_t<key_func_ret<T>>>,
+      key_func_ret<T>>;
+  template <typename T>
+  using KeyGroupPair = std::pair<key_type<T>, Group<T>>;
 
  public:
   template <typename ContainerT>
@@ -58,8 +67,14 @@ class iter::impl::GroupProducer {
    private:
     template <typename>
     friend class Iterator;
+    // with a sorted random access iterable, the end of the current group
+    // is searched for when the group is made and kept in group_end_
+    static constexpr bool Sorted =
+        is_assumed_sorted<ContainerT>
+        && is_random_access_iter<IteratorWrapper<ContainerT>>{};
     IteratorWrapper<ContainerT> sub_iter_;
     IteratorWrapper<ContainerT> sub_end_;
+    IteratorWrapper<ContainerT> group_end_;
     Holder<ContainerT> item_;
     KeyFunc* key_func_;
     std::optional<KeyGroupPair<ContainerT>> current_key_group_pair_;
@@ -75,6 +90,7 @@ class iter::impl::GroupProducer {
         IteratorWrapper<ContainerT>&& sub_end, KeyFunc& key_func)
         : sub_iter_{std::move(sub_iter)},
           sub_end_{std::move(sub_end)},
+          group_end_{sub_end_},
           key_func_(&key_func) {
       if (sub_iter_ != sub_end_) {
         item_.reset(*sub_iter_);
@@ -84,6 +100,7 @@ class iter::impl::GroupProducer {
     Iterator(const Iterator& other)
         : sub_iter_{other.sub_iter_},
           sub_end_{other.sub_end_},
+          group_end_{other.group_end_},
           item_{other.item_},
           key_func_{other.key_func_} {}
 
@@ -93,6 +110,7 @@ class iter::impl::GroupProducer {
       }
       sub_iter_ = other.sub_iter_;
       sub_end_ = other.sub_end_;
+      group_end_ = other.group_end_;
       item_ = other.item_;
       key_func_ = other.key_func_;
       current_key_group_pair_.reset();
@@ -163,10 +181,43 @@ class iter::impl::GroupProducer {
       return std::invoke(*key_func_, item_.get());
     }
 
+    // whether the current element belongs to the group with this key
+    template <typename Key>
+    bool in_group(const Key& key) {
+      if constexpr (Sorted) {
+        return sub_iter_ != group_end_;
+      } else {
+        return !exhausted() && next_key() == key;
+      }
+    }
+
+    // moves past the rest of the group, if its end is known
+    bool skip_group() {
+      if constexpr (Sorted) {
+        sub_iter_ = group_end_;
+        if (sub_iter_ != sub_end_) {
+          item_.reset(*sub_iter_);
+        }
+        return true;
+      } else {
+        return false;
+      }
+    }
+
     void set_key_group_pair() {
       if (!current_key_group_pair_) {
         current_key_group_pair_.emplace(std::invoke(*key_func_, item_.get()),
             Group<ContainerT>{*this, next_key()});
+        if constexpr (Sorted) {
+          auto& key = current_key_group_pair_->first;
+          auto same_key = [this, &key](auto&& item) {
+            return std::invoke(*key_func_,
+                       std::forward<decltype(item)>(item))
+                   == key;
+          };
+          group_end_ =
+              gallop_partition_point(sub_iter_ + 1, sub_end_, same_key);
+        }
       }
     }
   };
@@ -180,7 +231,7 @@ class iter::impl::GroupProducer {
     Iterator<ContainerT>& owner_;
     // The key function may return a reference, so we need to call forward, not
     // move, when going for efficiency.
-    key_func_ret<ContainerT> key_;
+    key_type<ContainerT> key_;
 
     // completed is set if a Group is iterated through
     // completely.  It is checked in the destructor, and
@@ -193,12 +244,12 @@ class iter::impl::GroupProducer {
     // when called.
     bool completed = false;
 
-    Group(Iterator<ContainerT>& owner, key_func_ret<ContainerT> key)
-        : owner_(owner), key_(std::forward<key_func_ret<ContainerT>>(key)) {}
+    Group(Iterator<ContainerT>& owner, key_type<ContainerT> key)
+        : owner_(owner), key_(std::forward<key_type<ContainerT>>(key)) {}
 
    public:
     ~Group() {
-      if (!completed) {
+      if (!completed && !owner_.skip_group()) {
         for (auto iter = begin(), end_it = end(); iter != end_it; ++iter) {
         }
       }
@@ -207,19 +258,18 @@ class iter::impl::GroupProducer {
     // move-constructible, non-copy-constructible, non-assignable
     Group(Group&& other) noexcept
         : owner_(other.owner_),
-          key_{std::forward<key_func_ret<ContainerT>>(other.key_)},
+          key_{std::forward<key_type<ContainerT>>(other.key_)},
           completed{other.completed} {
       other.completed = true;
     }
 
     class GroupIterator {
      private:
-      std::remove_reference_t<key_func_ret<ContainerT>>* key_;
+      std::remove_reference_t<key_type<ContainerT>>* key_;
       Group* group_p_;
 
       bool not_at_end() {
-        return !group_p_->owner_.exhausted()
-               && group_p_->owner_.next_key() == *key_;
+        return group_p_->owner_.in_group(*key_);
       }
 
      public:
@@ -230,7 +280,7 @@ class iter::impl::GroupProducer {
       using reference = value_type&;
 
       // TODO template this? idk if it's relevant here
-      GroupIterator(Group* group_p, key_func_ret<ContainerT>& key)
+      GroupIterator(Group* group_p, key_type<ContainerT>& key)
           : key_{&key}, group_p_{group_p} {}
 
       bool operator!=(const GroupIterator& other) const {
@@ -291,6 +341,10 @@ class iter::impl::GroupProducer {
     return {get_end(std::as_const(container_)),
         get_end(std::as_const(container_)), key_func_};
   }
+
+  SizeHint size_hint() const {
+    return size_hints::at_most(size_hint_of(std::as_const(container_)));
+  }
 };
 
 #endif
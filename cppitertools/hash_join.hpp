@@ -0,0 +1,342 @@
+#ifndef ITER_HASH_JOIN_HPP_
+#define ITER_HASH_JOIN_HPP_
+
+#include "internal/iterator_wrapper.hpp"
+#include "internal/iterbase.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace iter {
+  namespace impl {
+    template <typename Build, typename Probe, typename BuildKey,
+        typename ProbeKey>
+    class HashJoined;
+
+    struct HashJoinFn;
+  }
+}
+
+// Yields a pair of references for each element of the build iterable and
+// element of the probe iterable whose keys are equal, in the order of the
+// probe iterable and then of the build iterable.  The build iterable is
+// read into a hash table on the first call to begin(), which later calls
+// reuse, and the probe iterable is then streamed, so the build iterable
+// should be the smaller one.
+//
+// The table is flat, with open addressing, and holds the hash of each
+// key along with the index of its element.  Elements are held by pointer
+// when the build iterable's references stay valid, and copied otherwise;
+// keys are computed again when hashes match rather than being stored.
+// Keys are hashed with std::hash of the build key's type.
+template <typename Build, typename Probe, typename BuildKey, typename ProbeKey>
+class iter::impl::HashJoined {
+ private:
+  Build build_;
+  Probe probe_;
+  mutable BuildKey build_key_;
+  mutable ProbeKey probe_key_;
+
+  friend HashJoinFn;
+
+  HashJoined(Build&& build, Probe&& probe, BuildKey build_key,
+      ProbeKey probe_key)
+      : build_(std::forward<Build>(build)),
+        probe_(std::forward<Probe>(probe)),
+        build_key_(std::move(build_key)),
+        probe_key_(std::move(probe_key)) {}
+
+ public:
+  template <typename BuildT>
+  class Table {
+   private:
+    using Arg = iterator_deref<BuildT>;
+    static constexpr bool KeepsRefs =
+        std::is_lvalue_reference_v<Arg>
+        && is_iterator_at_least<iterator_type<BuildT>,
+            std::forward_iterator_tag>;
+    using Value = std::remove_cv_t<std::remove_reference_t<Arg>>;
+    using Stored =
+        std::conditional_t<KeepsRefs, std::remove_reference_t<Arg>*, Value>;
+
+   public:
+    using reference =
+        std::conditional_t<KeepsRefs, std::remove_reference_t<Arg>&, Value&>;
+    using Key = std::invoke_result_t<BuildKey&, reference>;
+    using Hasher = std::hash<std::remove_cv_t<std::remove_reference_t<Key>>>;
+
+   private:
+    // index is one past the element's, so 0 is an empty slot
+    struct Slot {
+      std::size_t hash;
+      std::size_t index;
+    };
+
+    std::vector<Stored> items_;
+    std::vector<Slot> slots_;
+    unsigned shift_{64};
+
+   public:
+    Table(BuildT& build, BuildKey& build_key) {
+      for (auto it = get_begin(build), end = get_end(build); it != end; ++it) {
+        if constexpr (KeepsRefs) {
+          items_.push_back(&*it);
+        } else {
+          items_.push_back(Value(*it));
+        }
+      }
+      if (items_.empty()) {
+        return;
+      }
+      // at most half full
+      std::size_t capacity = 8;
+      shift_ = 61;
+      while (capacity < 2 * items_.size()) {
+        capacity *= 2;
+        --shift_;
+      }
+      slots_.resize(capacity);
+      for (std::size_t i = 0; i < items_.size(); ++i) {
+        auto hash = Hasher{}(std::invoke(build_key, item(i)));
+        auto pos = bucket(hash);
+        while (slots_[pos].index != 0) {
+          pos = next(pos);
+        }
+        slots_[pos] = {hash, i + 1};
+      }
+    }
+
+    bool empty() const {
+      return items_.empty();
+    }
+
+    reference item(std::size_t i) {
+      if constexpr (KeepsRefs) {
+        return *items_[i];
+      } else {
+        return items_[i];
+      }
+    }
+
+    // Fibonacci hashing, as std::hash is often the identity
+    std::size_t bucket(std::size_t hash) const {
+      return static_cast<std::size_t>(
+          (static_cast<std::uint64_t>(hash) * 0x9E3779B97F4A7C15ull)
+          >> shift_);
+    }
+
+    std::size_t next(std::size_t pos) const {
+      return (pos + 1) & (slots_.size() - 1);
+    }
+
+    // a chain of slots ends at one with an index of 0
+    const Slot& slot(std::size_t pos) const {
+      return slots_[pos];
+    }
+  };
+
+  template <typename BuildT, typename ProbeT>
+  class Iterator {
+   private:
+    template <typename, typename>
+    friend class Iterator;
+
+    using TableT = Table<BuildT>;
+    using ProbeHolder = DerefHolder<iterator_deref<ProbeT>>;
+    using Key = std::invoke_result_t<ProbeKey&,
+        typename ProbeHolder::reference>;
+
+    TableT* table_;
+    BuildKey* build_key_;
+    ProbeKey* probe_key_;
+    IteratorWrapper<ProbeT> sub_iter_;
+    IteratorWrapper<ProbeT> sub_end_;
+    ProbeHolder item_;
+    DerefHolder<Key> key_;
+    std::size_t hash_{0};
+    std::size_t pos_{0};
+
+    void load_probe() {
+      item_.reset(*sub_iter_);
+      key_.reset(std::invoke(*probe_key_, item_.get()));
+      hash_ = typename TableT::Hasher{}(key_.get());
+      pos_ = table_->bucket(hash_);
+    }
+
+    // moves pos_ to the next match, starting with the slot it's at
+    void find_match() {
+      for (;;) {
+        for (; table_->slot(pos_).index != 0; pos_ = table_->next(pos_)) {
+          const auto& s = table_->slot(pos_);
+          if (s.hash == hash_
+              && std::invoke(*build_key_, table_->item(s.index - 1))
+                     == key_.get()) {
+            return;
+          }
+        }
+        ++sub_iter_;
+        if (!(sub_iter_ != sub_end_)) {
+          return;
+        }
+        load_probe();
+      }
+    }
+
+   public:
+    using value_type = std::pair<typename TableT::reference,
+        typename ProbeHolder::reference>;
+    using iterator_category = std::input_iterator_tag;
+    using difference_type = std::ptrdiff_t;
+    using pointer = value_type*;
+    using reference = value_type;
+
+    Iterator(TableT& table, BuildKey& build_key, ProbeKey& probe_key,
+        IteratorWrapper<ProbeT>&& sub_iter, IteratorWrapper<ProbeT>&& sub_end)
+        : table_{&table},
+          build_key_{&build_key},
+          probe_key_{&probe_key},
+          sub_iter_{std::move(sub_iter)},
+          sub_end_{std::move(sub_end)} {
+      // nothing can match an empty table
+      if (table_->empty()) {
+        sub_iter_ = sub_end_;
+      }
+      if (sub_iter_ != sub_end_) {
+        load_probe();
+        find_match();
+      }
+    }
+
+    reference operator*() {
+      return {table_->item(table_->slot(pos_).index - 1), item_.get()};
+    }
+
+    ArrowProxy<reference> operator->() {
+      return {**this};
+    }
+
+    Iterator& operator++() {
+      pos_ = table_->next(pos_);
+      find_match();
+      return *this;
+    }
+
+    Iterator operator++(int) {
+      auto ret = *this;
+      ++*this;
+      return ret;
+    }
+
+    template <typename T, typename U>
+    bool operator!=(const Iterator<T, U>& other) const {
+      if (!(sub_iter_ != sub_end_) || !(other.sub_iter_ != other.sub_end_)) {
+        return (sub_iter_ != sub_end_) != (other.sub_iter_ != other.sub_end_);
+      }
+      return sub_iter_ != other.sub_iter_ || pos_ != other.pos_;
+    }
+
+    template <typename T, typename U>
+    bool operator==(const Iterator<T, U>& other) const {
+      return !(*this != other);
+    }
+  };
+
+ private:
+  // a table for const iteration is only named if it could be built, so
+  // build iterables that can't be iterated as const still work otherwise
+  using ConstTable = std::conditional_t<is_iterable<AsConst<Build>>,
+      Table<AsConst<Build>>, Table<Build>>;
+
+  std::optional<Table<Build>> table_;
+  mutable std::optional<ConstTable> const_table_;
+
+ public:
+  HashJoined(HashJoined&&) = default;
+
+  Iterator<Build, Probe> begin() {
+    if (!table_) {
+      table_.emplace(build_, build_key_);
+    }
+    return {*table_, build_key_, probe_key_, get_begin(probe_),
+        get_end(probe_)};
+  }
+
+  Iterator<Build, Probe> end() {
+    if (!table_) {
+      table_.emplace(build_, build_key_);
+    }
+    return {*table_, build_key_, probe_key_, get_end(probe_),
+        get_end(probe_)};
+  }
+
+  Iterator<AsConst<Build>, AsConst<Probe>> begin() const {
+    if (!const_table_) {
+      const_table_.emplace(std::as_const(build_), build_key_);
+    }
+    return {*const_table_, build_key_, probe_key_,
+        get_begin(std::as_const(probe_)), get_end(std::as_const(probe_))};
+  }
+
+  Iterator<AsConst<Build>, AsConst<Probe>> end() const {
+    if (!const_table_) {
+      const_table_.emplace(std::as_const(build_), build_key_);
+    }
+    return {*const_table_, build_key_, probe_key_,
+        get_end(std::as_const(probe_)), get_end(std::as_const(probe_))};
+  }
+};
+
+// hash_join(build, probe, build_key, probe_key), or
+// probe | hash_join(build, build_key, probe_key)
+struct iter::impl::HashJoinFn {
+ private:
+  template <typename Build, typename BuildKey, typename ProbeKey>
+  struct FnPartial : Pipeable<FnPartial<Build, BuildKey, ProbeKey>> {
+    // held by reference if it was an lvalue, and copied for each call
+    // otherwise
+    Build build;
+    BuildKey build_key;
+    ProbeKey probe_key;
+
+    template <typename Probe>
+    HashJoined<Build, Probe, BuildKey, ProbeKey> operator()(
+        Probe&& probe) const& {
+      return {static_cast<Build>(build), std::forward<Probe>(probe),
+          build_key, probe_key};
+    }
+
+    template <typename Probe>
+    HashJoined<Build, Probe, BuildKey, ProbeKey> operator()(Probe&& probe) && {
+      return {std::forward<Build>(build), std::forward<Probe>(probe),
+          std::move(build_key), std::move(probe_key)};
+    }
+  };
+
+ public:
+  template <typename Build, typename Probe, typename BuildKey,
+      typename ProbeKey>
+  HashJoined<Build, Probe, BuildKey, ProbeKey> operator()(Build&& build,
+      Probe&& probe, BuildKey build_key, ProbeKey probe_key) const {
+    return {std::forward<Build>(build), std::forward<Probe>(probe),
+        std::move(build_key), std::move(probe_key)};
+  }
+
+  template <typename Build, typename BuildKey, typename ProbeKey>
+  FnPartial<Build, BuildKey, ProbeKey> operator()(
+      Build&& build, BuildKey build_key, ProbeKey probe_key) const {
+    return {{}, std::forward<Build>(build), std::move(build_key),
+        std::move(probe_key)};
+  }
+};
+
+namespace iter {
+  inline constexpr impl::HashJoinFn hash_join{};
+}
+
+#endif
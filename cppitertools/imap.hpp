@@ -8,6 +8,19 @@
 
 namespace iter {
   namespace impl {
+    // imap.cached(func, containers...) holds each result until the next
+    // increment, as starmap.cached does
+    struct CachedIMapFn : PipeableAndBindFirst<CachedIMapFn> {
+      template <typename MapFunc, typename... Containers>
+      auto operator()(MapFunc map_func, Containers&&... containers) const
+          -> StarMapper<MapFunc,
+              decltype(zip(std::forward<Containers>(containers)...)), true> {
+        return starmap.cached(
+            std::move(map_func), zip(std::forward<Containers>(containers)...));
+      }
+      using PipeableAndBindFirst<CachedIMapFn>::operator();
+    };
+
     struct IMapFn : PipeableAndBindFirst<IMapFn> {
       template <typename MapFunc, typename... Containers>
       auto operator()(MapFunc map_func, Containers&&... containers) const
@@ -20,6 +33,8 @@ namespace iter {
             std::move(map_func), zip(std::forward<Containers>(containers)...));
       }
       using PipeableAndBindFirst<IMapFn>::operator();
+
+      CachedIMapFn cached;
     };
   }
   inline constexpr impl::IMapFn imap{};
@@ -46,6 +46,18 @@ namespace iter {
     using const_iterator_deref_tuple = decltype(
         detail::const_iterator_tuple_deref_helper(std::declval<TupleType>()));
 
+    template <typename>
+    struct AsTupleOfConstImpl;
+
+    template <typename... Ts>
+    struct AsTupleOfConstImpl<std::tuple<Ts...>>
+        : type_is<std::tuple<AsConst<Ts>...>> {};
+
+    // Given a tuple of container types, evaluates to a tuple of the const
+    // versions of those types
+    template <typename T>
+    using AsTupleOfConst = typename AsTupleOfConstImpl<T>::type;
+
     // function absorbing all arguments passed to it. used when
     // applying a function to a parameter pack but not passing the evaluated
     // results anywhere
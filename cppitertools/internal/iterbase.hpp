@@ -7,15 +7,22 @@
 // also applies to the name of the file.  No user code should include
 // this file directly.
 
+#include <algorithm>
 #include <cassert>
 #include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <iterator>
+#include <numeric>
 #include <optional>
 #include <tuple>
 #include <type_traits>
 #include <utility>
 
+#if __has_include(<bit>)
+#include <bit>
+#endif
+
 // see gcc bug 87651
 // https://gcc.gnu.org/bugzilla/show_bug.cgi?id=87651
 #ifdef __GNUC__
@@ -204,8 +211,57 @@ namespace iter {
 
     template <typename T>
     using has_random_access_iter = is_random_access_iter<iterator_type<T>>;
-    // because std::advance assumes a lot and is actually smart, I need a dumb
 
+    // the iterator_category of T, or input_iterator_tag if T doesn't have one
+    template <typename, typename = void>
+    struct IteratorCategory : type_is<std::input_iterator_tag> {};
+
+    template <typename T>
+    struct IteratorCategory<T,
+        std::void_t<typename std::iterator_traits<T>::iterator_category>>
+        : type_is<typename std::iterator_traits<T>::iterator_category> {};
+
+    // true if T's iterator_category is Tag or refines it
+    template <typename T, typename Tag>
+    constexpr bool is_iterator_at_least =
+        std::is_base_of_v<Tag, typename IteratorCategory<T>::type>;
+
+    // index of the lowest set bit, mask must not be 0
+    inline unsigned lowest_bit(std::uint64_t mask) {
+#if defined(__cpp_lib_bitops)
+      return static_cast<unsigned>(std::countr_zero(mask));
+#elif defined(__GNUC__)
+      return static_cast<unsigned>(__builtin_ctzll(mask));
+#else
+      unsigned i = 0;
+      for (; (mask & 1) == 0; mask >>= 1) {
+        ++i;
+      }
+      return i;
+#endif
+    }
+
+    // The first element in [first, last) for which pred is false, given
+    // that it is true for a prefix of the range and false for the rest.
+    // The range is probed at offsets 0, 1, 3, 7, ... before a binary search,
+    // so an answer k places in takes O(log k) calls to pred.
+    template <typename RandomIt, typename Pred>
+    RandomIt gallop_partition_point(RandomIt first, RandomIt last, Pred& pred) {
+      auto test = [&pred](auto&& item) -> bool {
+        return std::invoke(pred, std::forward<decltype(item)>(item));
+      };
+      const auto size = last - first;
+      decltype(last - first) lo = 0;
+      decltype(last - first) step = 1;
+      while (step <= size && test(first[step - 1])) {
+        lo = step;
+        step *= 2;
+      }
+      auto hi = step <= size ? step - 1 : size;
+      return std::partition_point(first + lo, first + hi, test);
+    }
+
+    // because std::advance assumes a lot and is actually smart, I need a dumb
     // version that will work with most things
     template <typename InputIt, typename Distance = std::size_t>
     void dumb_advance_unsafe(InputIt& iter, Distance distance) {
@@ -253,6 +309,223 @@ namespace iter {
       return d;
     }
 
+    // Bounds on the number of elements an iterable yields, known without
+    // iterating it.  An empty upper bound means the iterable may never end,
+    // or that nothing is known about its end.
+    struct SizeHint {
+      std::size_t lower{0};
+      std::optional<std::size_t> upper{};
+
+      // the number of elements, if it's known exactly
+      constexpr std::optional<std::size_t> exact() const noexcept {
+        if (upper && *upper == lower) {
+          return lower;
+        }
+        return std::nullopt;
+      }
+
+      constexpr bool operator==(const SizeHint& other) const noexcept {
+        return lower == other.lower && upper == other.upper;
+      }
+
+      constexpr bool operator!=(const SizeHint& other) const noexcept {
+        return !(*this == other);
+      }
+    };
+
+    namespace size_hints {
+      constexpr std::size_t Unbounded = static_cast<std::size_t>(-1);
+
+      constexpr SizeHint exactly(std::size_t n) noexcept {
+        return {n, n};
+      }
+
+      // an iterable which never ends
+      constexpr SizeHint infinite() noexcept {
+        return {Unbounded, std::nullopt};
+      }
+
+      // the result saturates, so an overflowing lower bound stays a bound
+      constexpr std::size_t saturating_add(
+          std::size_t a, std::size_t b) noexcept {
+        return a > Unbounded - b ? Unbounded : a + b;
+      }
+
+      constexpr std::size_t saturating_mul(
+          std::size_t a, std::size_t b) noexcept {
+        return a != 0 && b > Unbounded / a ? Unbounded : a * b;
+      }
+
+      // an upper bound is only kept if it doesn't overflow
+      constexpr std::optional<std::size_t> checked_add(
+          std::optional<std::size_t> a, std::optional<std::size_t> b) noexcept {
+        if (!a || !b || *a > Unbounded - *b) {
+          return std::nullopt;
+        }
+        return *a + *b;
+      }
+
+      constexpr std::optional<std::size_t> checked_mul(
+          std::optional<std::size_t> a, std::optional<std::size_t> b) noexcept {
+        if (a && *a == 0) {
+          return a;
+        }
+        if (b && *b == 0) {
+          return b;
+        }
+        if (!a || !b || *b > Unbounded / *a) {
+          return std::nullopt;
+        }
+        return *a * *b;
+      }
+
+      // the length of one iterable after another
+      constexpr SizeHint sum(SizeHint a, SizeHint b) noexcept {
+        return {
+            saturating_add(a.lower, b.lower), checked_add(a.upper, b.upper)};
+      }
+
+      // the length of iterables walked together until the shortest ends
+      constexpr SizeHint min(SizeHint a, SizeHint b) noexcept {
+        std::optional<std::size_t> upper;
+        if (a.upper && b.upper) {
+          upper = std::min(*a.upper, *b.upper);
+        } else {
+          upper = a.upper ? a.upper : b.upper;
+        }
+        return {std::min(a.lower, b.lower), upper};
+      }
+
+      // the length of iterables walked together until the longest ends
+      constexpr SizeHint max(SizeHint a, SizeHint b) noexcept {
+        std::optional<std::size_t> upper;
+        if (a.upper && b.upper) {
+          upper = std::max(*a.upper, *b.upper);
+        }
+        return {std::max(a.lower, b.lower), upper};
+      }
+
+      // the number of pairs of an element of each
+      constexpr SizeHint product(SizeHint a, SizeHint b) noexcept {
+        return {
+            saturating_mul(a.lower, b.lower), checked_mul(a.upper, b.upper)};
+      }
+
+      // an iterable yielding some of the elements of one with this hint
+      constexpr SizeHint at_most(SizeHint a) noexcept {
+        return {0, a.upper};
+      }
+
+      // applies f, which must not decrease as its argument grows, to both
+      // bounds.  f returns nothing when its result doesn't fit.
+      template <typename F>
+      constexpr SizeHint map(SizeHint a, F f) {
+        std::optional<std::size_t> upper;
+        if (a.upper) {
+          upper = f(*a.upper);
+        }
+        return {f(a.lower).value_or(Unbounded), upper};
+      }
+
+      // n choose k, or nothing if it doesn't fit in a std::size_t
+      constexpr std::optional<std::size_t> choose(
+          std::size_t n, std::size_t k) noexcept {
+        if (k > n) {
+          return 0;
+        }
+        k = std::min(k, n - k);
+        std::size_t result = 1;
+        for (std::size_t i = 1; i <= k; ++i) {
+          // result * (n - k + i) is divisible by i, so dividing by the
+          // common factors first keeps the intermediate value small
+          auto g = std::gcd(result, i);
+          auto factor = (n - k + i) / (i / g);
+          result /= g;
+          if (result > Unbounded / factor) {
+            return std::nullopt;
+          }
+          result *= factor;
+        }
+        return result;
+      }
+
+      template <typename T, typename = void>
+      struct HasSizeHint : std::false_type {};
+
+      template <typename T>
+      struct HasSizeHint<T,
+          std::void_t<decltype(std::declval<T&>().size_hint())>>
+          : std::true_type {};
+
+      template <typename T, typename = void>
+      struct HasSize : std::false_type {};
+
+      template <typename T>
+      struct HasSize<T, std::void_t<decltype(std::size(std::declval<T&>()))>>
+          : std::true_type {};
+
+      template <typename T, typename = void>
+      struct HasReserve : std::false_type {};
+
+      template <typename T>
+      struct HasReserve<T,
+          std::void_t<decltype(std::declval<T&>().reserve(std::size_t{}))>>
+          : std::true_type {};
+
+      template <typename T, typename = void>
+      struct HasRandomAccess : std::false_type {};
+
+      template <typename T>
+      struct HasRandomAccess<T,
+          std::void_t<decltype(get_end(std::declval<T&>())
+                               - get_begin(std::declval<T&>()))>>
+          : std::integral_constant<bool,
+                std::is_same_v<decltype(get_begin(std::declval<T&>())),
+                    decltype(get_end(std::declval<T&>()))>
+                    && is_iterator_at_least<
+                        decltype(get_begin(std::declval<T&>())),
+                        std::random_access_iterator_tag>> {};
+    }
+
+    // The size hint of an iterable: its own size_hint() if it has one, its
+    // size if std::size works with it or its iterators are random access,
+    // and otherwise nothing.
+    template <typename Container>
+    SizeHint size_hint_of(Container& container) {
+      using namespace size_hints;
+      if constexpr (HasSizeHint<Container>{}) {
+        return container.size_hint();
+      } else if constexpr (HasSize<Container>{}) {
+        return exactly(static_cast<std::size_t>(std::size(container)));
+      } else if constexpr (HasRandomAccess<Container>{}) {
+        return exactly(static_cast<std::size_t>(
+            get_end(container) - get_begin(container)));
+      } else {
+        return {};
+      }
+    }
+
+    // The number of elements, from the size hint when it's exact and by
+    // walking the iterable otherwise.
+    template <typename Container>
+    std::size_t exact_size(Container& container) {
+      if (auto n = size_hint_of(container).exact()) {
+        return *n;
+      }
+      return dumb_size(container);
+    }
+
+    // Reserves room for the elements an iterable with this hint is sure to
+    // yield, if the collection has a reserve() and the iterable ends.
+    template <typename Collection>
+    void reserve_for(Collection& collection, const SizeHint& hint) {
+      if constexpr (size_hints::HasReserve<Collection>{}) {
+        if (hint.lower != size_hints::Unbounded) {
+          collection.reserve(hint.lower);
+        }
+      }
+    }
+
     template <typename... Ts>
     struct are_same : std::true_type {};
 
@@ -299,6 +572,10 @@ namespace iter {
         item_p_.emplace(std::move(item));
       }
 
+      void reset() {
+        item_p_.reset();
+      }
+
       explicit operator bool() const {
         return static_cast<bool>(item_p_);
       }
@@ -333,6 +610,10 @@ namespace iter {
         item_p_ = &item;
       }
 
+      void reset() {
+        item_p_ = nullptr;
+      }
+
       explicit operator bool() const {
         return item_p_ != nullptr;
       }
@@ -0,0 +1,140 @@
+#ifndef ITERTOOLS_MAPPED_FILE_HPP_
+#define ITERTOOLS_MAPPED_FILE_HPP_
+
+#include <cerrno>
+#include <cstddef>
+#include <string>
+#include <system_error>
+#include <utility>
+
+#if __has_include(<sys/mman.h>) && __has_include(<sys/stat.h>) \
+    && __has_include(<fcntl.h>) && __has_include(<unistd.h>)
+#define ITER_HAS_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <fstream>
+#include <iterator>
+#include <vector>
+#endif
+
+namespace iter {
+  namespace impl {
+    class MappedFile;
+  }
+}
+
+// The contents of a file, read only.  Where mmap is available the file is
+// mapped rather than read, and the kernel is told it will be read
+// sequentially.  Elsewhere the file is read into a buffer.  A file that
+// can't be opened gives no data, and the reason is kept in error().
+// The data stays where it is when a MappedFile is moved.
+class iter::impl::MappedFile {
+ private:
+  const char* data_{};
+  std::size_t size_{};
+  std::error_code error_;
+#ifndef ITER_HAS_MMAP
+  std::vector<char> buffer_;
+#endif
+
+  void release() noexcept {
+#ifdef ITER_HAS_MMAP
+    if (data_) {
+      ::munmap(const_cast<char*>(data_), size_);
+    }
+#endif
+    data_ = nullptr;
+    size_ = 0;
+  }
+
+ public:
+  explicit MappedFile(const std::string& path) {
+#ifdef ITER_HAS_MMAP
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd == -1) {
+      error_.assign(errno, std::generic_category());
+      return;
+    }
+    struct stat st {};
+    if (::fstat(fd, &st) == -1) {
+      error_.assign(errno, std::generic_category());
+      ::close(fd);
+      return;
+    }
+    // mmap rejects a length of 0, and an empty file has nothing to map
+    if (st.st_size > 0) {
+      auto size = static_cast<std::size_t>(st.st_size);
+      void* p = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (p == MAP_FAILED) {
+        error_.assign(errno, std::generic_category());
+      } else {
+#ifdef MADV_SEQUENTIAL
+        ::madvise(p, size, MADV_SEQUENTIAL);
+#endif
+        data_ = static_cast<const char*>(p);
+        size_ = size;
+      }
+    }
+    ::close(fd);
+#else
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+      error_ = std::make_error_code(std::errc::no_such_file_or_directory);
+      return;
+    }
+    buffer_.assign(std::istreambuf_iterator<char>{in},
+        std::istreambuf_iterator<char>{});
+    data_ = buffer_.data();
+    size_ = buffer_.size();
+#endif
+  }
+
+  MappedFile(MappedFile&& other) noexcept
+      : data_{std::exchange(other.data_, nullptr)},
+        size_{std::exchange(other.size_, 0)},
+        error_{other.error_}
+#ifndef ITER_HAS_MMAP
+        ,
+        buffer_{std::move(other.buffer_)}
+#endif
+  {
+  }
+
+  MappedFile& operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+      release();
+      data_ = std::exchange(other.data_, nullptr);
+      size_ = std::exchange(other.size_, 0);
+      error_ = other.error_;
+#ifndef ITER_HAS_MMAP
+      buffer_ = std::move(other.buffer_);
+#endif
+    }
+    return *this;
+  }
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  ~MappedFile() {
+    release();
+  }
+
+  const char* data() const noexcept {
+    return data_;
+  }
+
+  std::size_t size() const noexcept {
+    return size_;
+  }
+
+  // set if the file couldn't be opened, read or mapped
+  const std::error_code& error() const noexcept {
+    return error_;
+  }
+};
+
+#endif
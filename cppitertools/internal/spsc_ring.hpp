@@ -0,0 +1,140 @@
+#ifndef ITERTOOLS_SPSC_RING_HPP_
+#define ITERTOOLS_SPSC_RING_HPP_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace iter {
+  namespace impl {
+    template <typename T>
+    class SpscRing;
+  }
+}
+
+// A bounded queue between exactly one producer thread and one consumer
+// thread.  Elements are handed over through head_ and tail_ without a
+// lock.  A side that has to wait spins briefly and then sleeps on a
+// condition variable, which the other side only touches when it knows
+// someone is sleeping.
+//
+// The producer calls push() for each element and then close(), or fail()
+// if it stopped because of an exception.  The consumer calls wait(), uses
+// front(), then pop(), and calls cancel() if it stops early.
+template <typename T>
+class iter::impl::SpscRing {
+ private:
+  static constexpr int SpinLimit = 64;
+
+  std::vector<std::optional<T>> slots_;
+  // head_ is the next slot to pop and is only written by the consumer,
+  // tail_ is the next slot to push and is only written by the producer
+  alignas(64) std::atomic<std::size_t> head_{0};
+  alignas(64) std::atomic<std::size_t> tail_{0};
+  std::atomic<bool> closed_{false};
+  std::atomic<bool> cancelled_{false};
+  // written before closed_ is set, read after it is seen
+  std::exception_ptr error_;
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::atomic<int> sleepers_{0};
+
+  template <typename Pred>
+  void wait_until(Pred pred) {
+    for (int i = 0; i < SpinLimit; ++i) {
+      if (pred()) {
+        return;
+      }
+      std::this_thread::yield();
+    }
+    std::unique_lock<std::mutex> lock{mutex_};
+    ++sleepers_;
+    cv_.wait(lock, pred);
+    --sleepers_;
+  }
+
+  void wake() {
+    if (sleepers_ > 0) {
+      std::lock_guard<std::mutex> lock{mutex_};
+      cv_.notify_all();
+    }
+  }
+
+ public:
+  explicit SpscRing(std::size_t capacity)
+      : slots_(capacity > 0 ? capacity : 1) {}
+
+  SpscRing(const SpscRing&) = delete;
+  SpscRing& operator=(const SpscRing&) = delete;
+
+  // Producer side.  Blocks while the ring is full, and returns false
+  // without pushing if the consumer has gone away.
+  template <typename U>
+  bool push(U&& value) {
+    const auto tail = tail_.load(std::memory_order_relaxed);
+    wait_until([this, tail] {
+      return tail - head_.load() < slots_.size() || cancelled_.load();
+    });
+    if (cancelled_) {
+      return false;
+    }
+    slots_[tail % slots_.size()].emplace(std::forward<U>(value));
+    tail_ = tail + 1;
+    wake();
+    return true;
+  }
+
+  void close() {
+    closed_ = true;
+    wake();
+  }
+
+  void fail(std::exception_ptr error) {
+    error_ = std::move(error);
+    close();
+  }
+
+  bool cancelled() const {
+    return cancelled_;
+  }
+
+  // Consumer side.  Blocks until there is an element or the producer is
+  // done, and returns false in the second case.  If the producer failed,
+  // its exception is rethrown here instead.
+  bool wait() {
+    const auto head = head_.load(std::memory_order_relaxed);
+    wait_until([this, head] { return tail_.load() != head || closed_.load(); });
+    if (tail_.load() != head) {
+      return true;
+    }
+    if (error_) {
+      std::rethrow_exception(error_);
+    }
+    return false;
+  }
+
+  T& front() {
+    return *slots_[head_.load(std::memory_order_relaxed) % slots_.size()];
+  }
+
+  void pop() {
+    const auto head = head_.load(std::memory_order_relaxed);
+    slots_[head % slots_.size()].reset();
+    head_ = head + 1;
+    wake();
+  }
+
+  void cancel() {
+    cancelled_ = true;
+    wake();
+  }
+};
+
+#endif
@@ -2,7 +2,9 @@
 #define ITERTOOLS_ALL_HPP_
 
 #include "accumulate.hpp"
+#include "assume_sorted.hpp"
 #include "batched.hpp"
+#include "buffered.hpp"
 #include "chain.hpp"
 #include "chunked.hpp"
 #include "combinations.hpp"
@@ -14,19 +16,41 @@
 #include "enumerate.hpp"
 #include "filter.hpp"
 #include "filterfalse.hpp"
+#include "flatten.hpp"
 #include "groupby.hpp"
+#include "hash_join.hpp"
 #include "imap.hpp"
+#include "lines.hpp"
+#include "linspace.hpp"
+#include "merge.hpp"
+#include "merge_join.hpp"
+#include "pairwise.hpp"
+#include "par_imap.hpp"
+#include "peekable.hpp"
 #include "permutations.hpp"
+#include "pipeline.hpp"
 #include "powerset.hpp"
+#include "prefetch.hpp"
 #include "product.hpp"
 #include "range.hpp"
+#include "records.hpp"
 #include "repeat.hpp"
 #include "reversed.hpp"
+#include "sample.hpp"
+#include "set_operations.hpp"
+#include "shared_source.hpp"
+#include "shuffled.hpp"
+#include "size_hint.hpp"
 #include "slice.hpp"
 #include "sliding_window.hpp"
+#include "soa.hpp"
+#include "sort_zipped.hpp"
 #include "sorted.hpp"
 #include "starmap.hpp"
 #include "takewhile.hpp"
+#include "tee.hpp"
+#include "thread_pool.hpp"
+#include "to.hpp"
 #include "unique_everseen.hpp"
 #include "unique_justseen.hpp"
 #include "zip.hpp"
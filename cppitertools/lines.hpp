@@ -0,0 +1,118 @@
+#ifndef ITER_LINES_HPP_
+#define ITER_LINES_HPP_
+
+#include "internal/iterbase.hpp"
+#include "internal/mapped_file.hpp"
+
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+namespace iter {
+  namespace impl {
+    class Lines;
+  }
+  impl::Lines lines(const std::string& path);
+}
+
+// The lines of a file, as string_views into the file's contents.  Lines are
+// split on '\n', which isn't included, the same as std::getline.  A final
+// line without a '\n' is still a line.  The string_views stay valid while
+// the Lines object is alive, including after it has been moved.
+class iter::impl::Lines {
+ private:
+  MappedFile file_;
+
+  friend Lines iter::lines(const std::string&);
+
+  Lines(const std::string& path) : file_(path) {}
+
+ public:
+  Lines(Lines&&) = default;
+
+  class Iterator {
+   private:
+    const char* line_{};
+    const char* line_end_{};
+    const char* file_end_{};
+
+    void find_line_end() {
+      auto* nl = static_cast<const char*>(std::memchr(
+          line_, '\n', static_cast<std::size_t>(file_end_ - line_)));
+      line_end_ = nl ? nl : file_end_;
+    }
+
+   public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = std::string_view;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const std::string_view*;
+    using reference = std::string_view;
+
+    Iterator(const char* line, const char* file_end)
+        : line_{line}, file_end_{file_end} {
+      if (line_ != file_end_) {
+        find_line_end();
+      }
+    }
+
+    std::string_view operator*() const {
+      return {line_, static_cast<std::size_t>(line_end_ - line_)};
+    }
+
+    ArrowProxy<std::string_view> operator->() const {
+      return {**this};
+    }
+
+    Iterator& operator++() {
+      // a '\n' at the very end doesn't start another line
+      line_ = line_end_ == file_end_ ? file_end_ : line_end_ + 1;
+      if (line_ != file_end_) {
+        find_line_end();
+      }
+      return *this;
+    }
+
+    Iterator operator++(int) {
+      auto ret = *this;
+      ++*this;
+      return ret;
+    }
+
+    bool operator!=(const Iterator& other) const {
+      return line_ != other.line_;
+    }
+
+    bool operator==(const Iterator& other) const {
+      return !(*this != other);
+    }
+  };
+
+  Iterator begin() const {
+    return {file_.data(), file_.data() + file_.size()};
+  }
+
+  Iterator end() const {
+    return {file_.data() + file_.size(), file_.data() + file_.size()};
+  }
+
+  // the whole file
+  std::string_view contents() const {
+    return {file_.data(), file_.size()};
+  }
+
+  // set if the file couldn't be read, in which case there are no lines
+  const std::error_code& error() const {
+    return file_.error();
+  }
+};
+
+inline iter::impl::Lines iter::lines(const std::string& path) {
+  return {path};
+}
+
+#endif
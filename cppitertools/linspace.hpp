@@ -0,0 +1,96 @@
+#ifndef ITER_LINSPACE_HPP_
+#define ITER_LINSPACE_HPP_
+
+#include "internal/iterbase.hpp"
+#include "range.hpp"
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+namespace iter {
+  namespace impl {
+    template <typename T>
+    class Linspace;
+  }
+
+  template <typename T>
+  constexpr impl::Linspace<T> linspace(T, T, std::size_t) noexcept;
+}
+
+// n evenly spaced values from start to stop, both included.  Each value is
+// computed from its position and the last one is exactly stop, so there is
+// no accumulated error and no tolerance is needed to find the end.
+template <typename T>
+class iter::impl::Linspace {
+  static_assert(std::is_floating_point_v<T>,
+      "linspace only supported with floating point types");
+
+  template <typename U>
+  friend constexpr Linspace<U> iter::linspace(U, U, std::size_t) noexcept;
+
+ private:
+  T start_;
+  T stop_;
+  T step_;
+  std::size_t size_;
+
+  constexpr Linspace(T start, T stop, std::size_t n) noexcept
+      : start_{start},
+        stop_{stop},
+        step_{n > 1 ? (stop - start) / static_cast<T>(n - 1) : T(0)},
+        size_{n} {}
+
+ public:
+  using Iterator = IndexedIterator<Linspace>;
+
+  constexpr T start() const noexcept {
+    return start_;
+  }
+
+  constexpr T stop() const noexcept {
+    return stop_;
+  }
+
+  constexpr T step() const noexcept {
+    return step_;
+  }
+
+  constexpr std::size_t size() const noexcept {
+    return size_;
+  }
+
+  constexpr bool empty() const noexcept {
+    return size_ == 0;
+  }
+
+  constexpr T operator[](std::size_t index) const noexcept {
+    if (index != 0 && index + 1 == size_) {
+      return stop_;
+    }
+    return start_ + step_ * static_cast<T>(index);
+  }
+
+  // Consecutive groups of N values, each held contiguously so that SIMD
+  // kernels can load them directly.
+  template <std::size_t N>
+  constexpr Blocked<Linspace, N> blocks() const noexcept {
+    return {*this};
+  }
+
+  constexpr Iterator begin() const noexcept {
+    return {this, 0};
+  }
+
+  constexpr Iterator end() const noexcept {
+    return {this, static_cast<std::ptrdiff_t>(size_)};
+  }
+};
+
+template <typename T>
+constexpr iter::impl::Linspace<T> iter::linspace(
+    T start, T stop, std::size_t n) noexcept {
+  return {start, stop, n};
+}
+
+#endif
@@ -0,0 +1,549 @@
+#ifndef ITER_MERGE_HPP_
+#define ITER_MERGE_HPP_
+
+#include "internal/iter_tuples.hpp"
+#include "internal/iterator_wrapper.hpp"
+#include "internal/iterbase.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace iter {
+  namespace impl {
+    template <typename Deref, typename CompareFunc>
+    class MergeHeads;
+
+    template <typename CompareFunc, typename TupType, std::size_t... Is>
+    class Merged;
+
+    template <typename CompareFunc, typename Container>
+    class MergedFromIterable;
+
+    using MergeFromIterableFn =
+        IterToolFnOptionalBindFirst<MergedFromIterable, std::less<>>;
+
+    // rather than a merge function, use a callable object to support
+    // from_iterable
+    class MergeMaker;
+  }
+}
+
+// The current element of each of k sorted sources, arranged in a loser tree.
+// Each internal node holds the loser of the match played there, so when the
+// winning source advances only the matches on its path to the root are
+// replayed, about log2(k) comparisons per element.  Ties go to the source
+// that comes first, which keeps the merge stable.
+template <typename Deref, typename CompareFunc>
+class iter::impl::MergeHeads {
+ private:
+  using Holder = DerefHolder<Deref>;
+  std::vector<Holder> heads_;
+  std::vector<bool> exhausted_;
+  std::vector<std::size_t> losers_;
+  std::size_t winner_{};
+  CompareFunc* compare_func_;
+
+  // true if source i's head should come out before source j's
+  bool beats(std::size_t i, std::size_t j) {
+    if (exhausted_[i]) {
+      return false;
+    }
+    if (exhausted_[j]) {
+      return true;
+    }
+    if (i < j) {
+      return !std::invoke(*compare_func_, heads_[j].get(), heads_[i].get());
+    }
+    return std::invoke(*compare_func_, heads_[i].get(), heads_[j].get());
+  }
+
+ public:
+  using reference = typename Holder::reference;
+  using pointer = typename Holder::pointer;
+
+  MergeHeads(std::size_t num_sources, CompareFunc& compare_func)
+      : heads_(num_sources),
+        exhausted_(num_sources, true),
+        losers_(num_sources),
+        compare_func_(&compare_func) {}
+
+  // sets source i's head to *it, or marks the source as exhausted
+  template <typename Iter, typename EndIter>
+  void load(std::size_t i, Iter& it, const EndIter& end) {
+    if (it != end) {
+      heads_[i].reset(*it);
+      exhausted_[i] = false;
+    } else {
+      exhausted_[i] = true;
+    }
+  }
+
+  // plays every match, once all of the heads have been loaded
+  void build() {
+    const auto k = heads_.size();
+    if (k == 0) {
+      return;
+    }
+    // leaf i is node k + i, and node n's children are 2n and 2n + 1
+    std::vector<std::size_t> winners(2 * k);
+    for (std::size_t i = 0; i < k; ++i) {
+      winners[k + i] = i;
+    }
+    for (std::size_t n = k - 1; n > 0; --n) {
+      auto lhs = winners[2 * n];
+      auto rhs = winners[2 * n + 1];
+      if (beats(lhs, rhs)) {
+        winners[n] = lhs;
+        losers_[n] = rhs;
+      } else {
+        winners[n] = rhs;
+        losers_[n] = lhs;
+      }
+    }
+    winner_ = winners[1];
+  }
+
+  // replays the matches of the winner, after its head has been reloaded
+  void replay() {
+    const auto k = heads_.size();
+    auto current = winner_;
+    for (auto n = (current + k) / 2; n > 0; n /= 2) {
+      if (beats(losers_[n], current)) {
+        std::swap(losers_[n], current);
+      }
+    }
+    winner_ = current;
+  }
+
+  std::size_t winner() const {
+    return winner_;
+  }
+
+  bool done() const {
+    return heads_.empty() || exhausted_[winner_];
+  }
+
+  reference get() {
+    return heads_[winner_].get();
+  }
+
+  pointer get_ptr() {
+    return heads_[winner_].get_ptr();
+  }
+};
+
+template <typename CompareFunc, typename TupType, std::size_t... Is>
+class iter::impl::Merged {
+ private:
+  static_assert(sizeof...(Is) > 0, "merge requires at least one iterable");
+  friend MergeMaker;
+
+  TupType tup_;
+  mutable CompareFunc compare_func_;
+
+  Merged(CompareFunc compare_func, TupType&& t)
+      : tup_(std::move(t)), compare_func_(std::move(compare_func)) {}
+
+  using Counts = std::array<std::size_t, sizeof...(Is)>;
+
+  static std::size_t total(const Counts& counts) {
+    std::size_t n = 0;
+    for (auto c : counts) {
+      n += c;
+    }
+    return n;
+  }
+
+  // The number of elements of an iterable which come out of the merge
+  // before x, given that x is from a later iterable if Earlier and from an
+  // earlier one otherwise, since ties go to the earlier iterable.
+  template <bool Earlier, typename Iter, typename T>
+  static std::size_t count_before(
+      Iter first, std::size_t n, const T& x, CompareFunc& compare_func) {
+    auto last = first + static_cast<std::ptrdiff_t>(n);
+    auto compare = [&compare_func](const auto& a, const auto& b) {
+      return std::invoke(compare_func, a, b);
+    };
+    if constexpr (Earlier) {
+      return static_cast<std::size_t>(
+          std::upper_bound(first, last, x, compare) - first);
+    } else {
+      return static_cast<std::size_t>(
+          std::lower_bound(first, last, x, compare) - first);
+    }
+  }
+
+  // how many elements of each iterable come out before element j of
+  // iterable S
+  template <std::size_t S, typename Firsts>
+  static Counts counts_before(const Firsts& firsts, const Counts& sizes,
+      std::size_t j, CompareFunc& compare_func) {
+    const auto& x = std::get<S>(firsts)[static_cast<std::ptrdiff_t>(j)];
+    Counts counts{};
+    ((counts[Is] = Is == S ? j
+                           : count_before<(Is < S)>(std::get<Is>(firsts),
+                                 sizes[Is], x, compare_func)),
+        ...);
+    return counts;
+  }
+
+  // If the element at position p of the merge is from iterable S, sets
+  // counts to the number of elements of each iterable before it.  The
+  // number before element j of S only grows with j, so it's found by a
+  // binary search.
+  template <std::size_t S, typename Firsts>
+  static bool find_position(const Firsts& firsts, const Counts& sizes,
+      std::size_t p, CompareFunc& compare_func, Counts& counts) {
+    std::size_t lo = 0;
+    std::size_t hi = sizes[S];
+    while (lo < hi) {
+      auto mid = lo + (hi - lo) / 2;
+      if (total(counts_before<S>(firsts, sizes, mid, compare_func)) < p) {
+        lo = mid + 1;
+      } else {
+        hi = mid;
+      }
+    }
+    if (lo == sizes[S]) {
+      return false;
+    }
+    auto found = counts_before<S>(firsts, sizes, lo, compare_func);
+    if (total(found) != p) {
+      return false;
+    }
+    counts = found;
+    return true;
+  }
+
+  // The number of elements each iterable gives to the first p elements of
+  // the merge: a merge path through k iterables rather than two.
+  template <typename Firsts>
+  static Counts merge_path(const Firsts& firsts, const Counts& sizes,
+      std::size_t p, CompareFunc& compare_func) {
+    if (p >= total(sizes)) {
+      return sizes;
+    }
+    Counts counts{};
+    bool found = false;
+    ((found = found
+              || find_position<Is>(firsts, sizes, p, compare_func, counts)),
+        ...);
+    return counts;
+  }
+
+ public:
+  Merged(Merged&&) = default;
+
+  template <typename TupTypeT>
+  class Iterator {
+   private:
+    template <typename>
+    friend class Iterator;
+
+    static_assert(
+        are_same<iterator_deref<std::tuple_element_t<Is, TupTypeT>>...>::value,
+        "All merged iterables must have iterators that "
+        "dereference to the same type, including cv-qualifiers "
+        "and references.");
+
+    using IterTupType = iterator_tuple_type<TupTypeT>;
+    using Deref = iterator_deref<std::tuple_element_t<0, TupTypeT>>;
+    using Heads = MergeHeads<Deref, CompareFunc>;
+
+    IterTupType iters_;
+    IterTupType ends_;
+    Heads heads_;
+
+    template <std::size_t Idx>
+    void load() {
+      heads_.load(Idx, std::get<Idx>(iters_), std::get<Idx>(ends_));
+    }
+
+    // the iterators are different types, so find the winner's by comparing
+    // against each index
+    void advance_winner() {
+      const auto w = heads_.winner();
+      absorb((w == Is ? (++std::get<Is>(iters_), load<Is>(), 0) : 0)...);
+    }
+
+   public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = iterator_traits_deref<std::tuple_element_t<0, TupTypeT>>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = typename Heads::pointer;
+    using reference = typename Heads::reference;
+
+    Iterator(IterTupType&& iters, IterTupType&& ends, CompareFunc& compare_func)
+        : iters_(std::move(iters)),
+          ends_(std::move(ends)),
+          heads_(sizeof...(Is), compare_func) {
+      absorb((load<Is>(), 0)...);
+      heads_.build();
+    }
+
+    reference operator*() {
+      return heads_.get();
+    }
+
+    pointer operator->() {
+      return heads_.get_ptr();
+    }
+
+    Iterator& operator++() {
+      advance_winner();
+      heads_.replay();
+      return *this;
+    }
+
+    Iterator operator++(int) {
+      auto ret = *this;
+      ++*this;
+      return ret;
+    }
+
+    template <typename T>
+    bool operator!=(const Iterator<T>& other) const {
+      if (heads_.done() || other.heads_.done()) {
+        return heads_.done() != other.heads_.done();
+      }
+      return (... || (std::get<Is>(iters_) != std::get<Is>(other.iters_)));
+    }
+
+    template <typename T>
+    bool operator==(const Iterator<T>& other) const {
+      return !(*this != other);
+    }
+  };
+
+  Iterator<TupType> begin() {
+    return {{get_begin(std::get<Is>(tup_))...},
+        {get_end(std::get<Is>(tup_))...}, compare_func_};
+  }
+
+  Iterator<TupType> end() {
+    return {{get_end(std::get<Is>(tup_))...},
+        {get_end(std::get<Is>(tup_))...}, compare_func_};
+  }
+
+  Iterator<AsTupleOfConst<TupType>> begin() const {
+    return {{get_begin(std::as_const(std::get<Is>(tup_)))...},
+        {get_end(std::as_const(std::get<Is>(tup_)))...}, compare_func_};
+  }
+
+  Iterator<AsTupleOfConst<TupType>> end() const {
+    return {{get_end(std::as_const(std::get<Is>(tup_)))...},
+        {get_end(std::as_const(std::get<Is>(tup_)))...}, compare_func_};
+  }
+
+  SizeHint size_hint() const {
+    auto hint = size_hints::exactly(0);
+    ((hint = size_hints::sum(
+          hint, size_hint_of(std::as_const(std::get<Is>(tup_))))),
+        ...);
+    return hint;
+  }
+
+  // Calls f with each element at positions [lo, hi) of the merge, in order,
+  // when every iterable is random access.  Where each iterable's part
+  // starts is found by binary searches rather than by merging the elements
+  // before lo, so that pieces of one merge can be made on different
+  // threads, as to<Container>(pool) does.  Each call compares with its own
+  // copy of the comparison function.
+  template <typename F>
+  void for_each_in(std::size_t lo, std::size_t hi, F f) const {
+    static_assert(
+        (... && has_random_access_iter<AsConst<std::tuple_element_t<Is,
+                    TupType>>>{}),
+        "merging in pieces requires random access iterables");
+    using Deref = iterator_deref<AsConst<std::tuple_element_t<0, TupType>>>;
+    auto compare_func = compare_func_;
+    auto firsts =
+        std::make_tuple(get_begin(std::as_const(std::get<Is>(tup_)))...);
+    const Counts sizes{{static_cast<std::size_t>(
+        get_end(std::as_const(std::get<Is>(tup_))) - std::get<Is>(firsts))...}};
+    const auto starts = merge_path(firsts, sizes, lo, compare_func);
+    const auto stops = merge_path(firsts, sizes, hi, compare_func);
+
+    auto iters = std::make_tuple(
+        (std::get<Is>(firsts) + static_cast<std::ptrdiff_t>(starts[Is]))...);
+    auto ends = std::make_tuple(
+        (std::get<Is>(firsts) + static_cast<std::ptrdiff_t>(stops[Is]))...);
+    MergeHeads<Deref, decltype(compare_func)> heads(
+        sizeof...(Is), compare_func);
+    (heads.load(Is, std::get<Is>(iters), std::get<Is>(ends)), ...);
+    heads.build();
+    while (!heads.done()) {
+      f(heads.get());
+      const auto w = heads.winner();
+      ((w == Is ? (++std::get<Is>(iters),
+                      heads.load(Is, std::get<Is>(iters), std::get<Is>(ends)))
+                : void()),
+          ...);
+      heads.replay();
+    }
+  }
+};
+
+template <typename CompareFunc, typename Container>
+class iter::impl::MergedFromIterable {
+ private:
+  friend MergeFromIterableFn;
+
+  Container container_;
+  mutable CompareFunc compare_func_;
+
+  MergedFromIterable(CompareFunc compare_func, Container&& container)
+      : container_(std::forward<Container>(container)),
+        compare_func_(std::move(compare_func)) {}
+
+ public:
+  MergedFromIterable(MergedFromIterable&&) = default;
+
+  template <typename ContainerT>
+  class Iterator {
+   private:
+    template <typename>
+    friend class Iterator;
+    using SubContainer = iterator_deref<ContainerT>;
+    using SubIter = IteratorWrapper<SubContainer>;
+    using Heads = MergeHeads<iterator_deref<SubContainer>, CompareFunc>;
+
+    // Sub iterables that are produced as values are kept alive here.  They
+    // don't change after begin(), so copies of the iterator share them.
+    std::shared_ptr<std::deque<DerefHolder<SubContainer>>> sub_iterables_;
+    std::vector<SubIter> sub_iters_;
+    std::vector<SubIter> sub_ends_;
+    Heads heads_;
+
+   public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = iterator_traits_deref<SubContainer>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = typename Heads::pointer;
+    using reference = typename Heads::reference;
+
+    // the end iterator, which has no sources
+    Iterator(CompareFunc& compare_func) : heads_(0, compare_func) {}
+
+    Iterator(IteratorWrapper<ContainerT>&& top_iter,
+        IteratorWrapper<ContainerT>&& top_end, CompareFunc& compare_func)
+        : sub_iterables_{std::make_shared<
+              std::deque<DerefHolder<SubContainer>>>()},
+          heads_(0, compare_func) {
+      for (; top_iter != top_end; ++top_iter) {
+        auto& sub_iterable = sub_iterables_->emplace_back();
+        sub_iterable.reset(*top_iter);
+        sub_iters_.push_back(get_begin(sub_iterable.get()));
+        sub_ends_.push_back(get_end(sub_iterable.get()));
+      }
+      heads_ = Heads(sub_iters_.size(), compare_func);
+      for (std::size_t i = 0; i < sub_iters_.size(); ++i) {
+        heads_.load(i, sub_iters_[i], sub_ends_[i]);
+      }
+      heads_.build();
+    }
+
+    reference operator*() {
+      return heads_.get();
+    }
+
+    pointer operator->() {
+      return heads_.get_ptr();
+    }
+
+    Iterator& operator++() {
+      const auto w = heads_.winner();
+      ++sub_iters_[w];
+      heads_.load(w, sub_iters_[w], sub_ends_[w]);
+      heads_.replay();
+      return *this;
+    }
+
+    Iterator operator++(int) {
+      auto ret = *this;
+      ++*this;
+      return ret;
+    }
+
+    template <typename T>
+    bool operator!=(const Iterator<T>& other) const {
+      if (heads_.done() || other.heads_.done()) {
+        return heads_.done() != other.heads_.done();
+      }
+      if (sub_iters_.size() != other.sub_iters_.size()) {
+        return true;
+      }
+      for (std::size_t i = 0; i < sub_iters_.size(); ++i) {
+        if (sub_iters_[i] != other.sub_iters_[i]) {
+          return true;
+        }
+      }
+      return false;
+    }
+
+    template <typename T>
+    bool operator==(const Iterator<T>& other) const {
+      return !(*this != other);
+    }
+  };
+
+  Iterator<Container> begin() {
+    return {get_begin(container_), get_end(container_), compare_func_};
+  }
+
+  Iterator<Container> end() {
+    return {compare_func_};
+  }
+
+  Iterator<AsConst<Container>> begin() const {
+    return {get_begin(std::as_const(container_)),
+        get_end(std::as_const(container_)), compare_func_};
+  }
+
+  Iterator<AsConst<Container>> end() const {
+    return {compare_func_};
+  }
+};
+
+class iter::impl::MergeMaker {
+ private:
+  template <typename CompareFunc, typename TupleType, std::size_t... Is>
+  Merged<CompareFunc, TupleType, Is...> merge_impl(CompareFunc compare_func,
+      TupleType&& containers, std::index_sequence<Is...>) const {
+    return {std::move(compare_func), std::move(containers)};
+  }
+
+ public:
+  // merge(containers...) compares elements with <, and
+  // merge(compare_func, containers...) compares them with compare_func
+  template <typename T, typename... Containers>
+  auto operator()(T&& t, Containers&&... cs) const {
+    if constexpr (is_iterable<T>) {
+      return merge_impl(std::less<>{},
+          std::tuple<T, Containers...>{
+              std::forward<T>(t), std::forward<Containers>(cs)...},
+          std::index_sequence_for<T, Containers...>{});
+    } else {
+      return merge_impl(std::decay_t<T>(std::forward<T>(t)),
+          std::tuple<Containers...>{std::forward<Containers>(cs)...},
+          std::index_sequence_for<Containers...>{});
+    }
+  }
+
+  MergeFromIterableFn from_iterable;
+};
+
+namespace iter {
+  inline constexpr auto merge = iter::impl::MergeMaker{};
+}
+
+#endif
@@ -0,0 +1,264 @@
+#ifndef ITER_MERGE_JOIN_HPP_
+#define ITER_MERGE_JOIN_HPP_
+
+#include "internal/iterator_wrapper.hpp"
+#include "internal/iterbase.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace iter {
+  namespace impl {
+    template <typename Left, typename Right, typename LeftKey,
+        typename RightKey>
+    class MergeJoined;
+
+    struct MergeJoinFn;
+  }
+}
+
+// Yields a pair of references for each element of the left iterable and
+// element of the right iterable whose keys are equal, given that both are
+// sorted by key with <.  The pairs come in the order of the left iterable
+// and then of the right.  Nothing is buffered: when several left elements
+// share a key, the right iterable's run of that key is walked again for
+// each of them, so its iterators must be forward iterators.
+template <typename Left, typename Right, typename LeftKey, typename RightKey>
+class iter::impl::MergeJoined {
+ private:
+  Left left_;
+  Right right_;
+  mutable LeftKey left_key_;
+  mutable RightKey right_key_;
+
+  friend MergeJoinFn;
+
+  MergeJoined(Left&& left, Right&& right, LeftKey left_key,
+      RightKey right_key)
+      : left_(std::forward<Left>(left)),
+        right_(std::forward<Right>(right)),
+        left_key_(std::move(left_key)),
+        right_key_(std::move(right_key)) {}
+
+ public:
+  MergeJoined(MergeJoined&&) = default;
+
+  template <typename LeftT, typename RightT>
+  class Iterator {
+   private:
+    template <typename, typename>
+    friend class Iterator;
+
+    static_assert(
+        is_iterator_at_least<iterator_type<RightT>, std::forward_iterator_tag>,
+        "The right iterable given to merge_join must have forward "
+        "iterators, since runs of it are walked again.");
+
+    using LeftHolder = DerefHolder<iterator_deref<LeftT>>;
+    using RightHolder = DerefHolder<iterator_deref<RightT>>;
+    using Key =
+        std::invoke_result_t<LeftKey&, typename LeftHolder::reference>;
+
+    IteratorWrapper<LeftT> left_iter_;
+    IteratorWrapper<LeftT> left_end_;
+    // right_iter_ is the start of the run matching the left element, and
+    // right_cur_ the element paired with it
+    IteratorWrapper<RightT> right_iter_;
+    IteratorWrapper<RightT> right_cur_;
+    IteratorWrapper<RightT> right_end_;
+    LeftHolder left_item_;
+    DerefHolder<Key> key_;
+    RightHolder right_item_;
+    LeftKey* left_key_;
+    RightKey* right_key_;
+
+    void load_left() {
+      left_item_.reset(*left_iter_);
+      key_.reset(std::invoke(*left_key_, left_item_.get()));
+    }
+
+    void load_right(IteratorWrapper<RightT>& it) {
+      right_item_.reset(*it);
+    }
+
+    bool right_before_key() {
+      return std::invoke(*right_key_, right_item_.get()) < key_.get();
+    }
+
+    bool key_before_right() {
+      return key_.get() < std::invoke(*right_key_, right_item_.get());
+    }
+
+    // moves both sides forward to the next pair of equal keys
+    void find_match() {
+      while (left_iter_ != left_end_ && right_iter_ != right_end_) {
+        load_right(right_iter_);
+        if (key_before_right()) {
+          ++left_iter_;
+          if (left_iter_ != left_end_) {
+            load_left();
+          }
+        } else if (right_before_key()) {
+          ++right_iter_;
+        } else {
+          right_cur_ = right_iter_;
+          return;
+        }
+      }
+      left_iter_ = left_end_;
+    }
+
+   public:
+    using value_type = std::pair<typename LeftHolder::reference,
+        typename RightHolder::reference>;
+    using iterator_category = std::input_iterator_tag;
+    using difference_type = std::ptrdiff_t;
+    using pointer = value_type*;
+    using reference = value_type;
+
+    Iterator(IteratorWrapper<LeftT>&& left_iter,
+        IteratorWrapper<LeftT>&& left_end,
+        IteratorWrapper<RightT>&& right_iter,
+        IteratorWrapper<RightT>&& right_end, LeftKey& left_key,
+        RightKey& right_key)
+        : left_iter_{std::move(left_iter)},
+          left_end_{std::move(left_end)},
+          right_iter_{right_iter},
+          right_cur_{std::move(right_iter)},
+          right_end_{std::move(right_end)},
+          left_key_{&left_key},
+          right_key_{&right_key} {
+      if (left_iter_ != left_end_) {
+        load_left();
+      }
+      find_match();
+    }
+
+    reference operator*() {
+      return {left_item_.get(), right_item_.get()};
+    }
+
+    ArrowProxy<reference> operator->() {
+      return {**this};
+    }
+
+    Iterator& operator++() {
+      ++right_cur_;
+      if (right_cur_ != right_end_) {
+        load_right(right_cur_);
+        if (!key_before_right()) {
+          return *this;
+        }
+      }
+      // the run is over for this left element, so try the next one on it
+      auto run_end = right_cur_;
+      ++left_iter_;
+      if (left_iter_ != left_end_) {
+        load_left();
+        right_cur_ = right_iter_;
+        load_right(right_cur_);
+        if (!right_before_key()) {
+          return *this;
+        }
+      }
+      right_iter_ = run_end;
+      find_match();
+      return *this;
+    }
+
+    Iterator operator++(int) {
+      auto ret = *this;
+      ++*this;
+      return ret;
+    }
+
+    template <typename T, typename U>
+    bool operator!=(const Iterator<T, U>& other) const {
+      bool live = left_iter_ != left_end_;
+      bool other_live = other.left_iter_ != other.left_end_;
+      if (!live || !other_live) {
+        return live != other_live;
+      }
+      return left_iter_ != other.left_iter_ || right_cur_ != other.right_cur_;
+    }
+
+    template <typename T, typename U>
+    bool operator==(const Iterator<T, U>& other) const {
+      return !(*this != other);
+    }
+  };
+
+  Iterator<Left, Right> begin() {
+    return {get_begin(left_), get_end(left_), get_begin(right_),
+        get_end(right_), left_key_, right_key_};
+  }
+
+  Iterator<Left, Right> end() {
+    return {get_end(left_), get_end(left_), get_end(right_), get_end(right_),
+        left_key_, right_key_};
+  }
+
+  Iterator<AsConst<Left>, AsConst<Right>> begin() const {
+    return {get_begin(std::as_const(left_)), get_end(std::as_const(left_)),
+        get_begin(std::as_const(right_)), get_end(std::as_const(right_)),
+        left_key_, right_key_};
+  }
+
+  Iterator<AsConst<Left>, AsConst<Right>> end() const {
+    return {get_end(std::as_const(left_)), get_end(std::as_const(left_)),
+        get_end(std::as_const(right_)), get_end(std::as_const(right_)),
+        left_key_, right_key_};
+  }
+};
+
+// merge_join(left, right, left_key, right_key), or
+// left | merge_join(right, left_key, right_key)
+struct iter::impl::MergeJoinFn {
+ private:
+  template <typename Right, typename LeftKey, typename RightKey>
+  struct FnPartial : Pipeable<FnPartial<Right, LeftKey, RightKey>> {
+    // held by reference if it was an lvalue, and copied for each call
+    // otherwise
+    Right right;
+    LeftKey left_key;
+    RightKey right_key;
+
+    template <typename Left>
+    MergeJoined<Left, Right, LeftKey, RightKey> operator()(
+        Left&& left) const& {
+      return {std::forward<Left>(left), static_cast<Right>(right), left_key,
+          right_key};
+    }
+
+    template <typename Left>
+    MergeJoined<Left, Right, LeftKey, RightKey> operator()(Left&& left) && {
+      return {std::forward<Left>(left), std::forward<Right>(right),
+          std::move(left_key), std::move(right_key)};
+    }
+  };
+
+ public:
+  template <typename Left, typename Right, typename LeftKey,
+      typename RightKey>
+  MergeJoined<Left, Right, LeftKey, RightKey> operator()(Left&& left,
+      Right&& right, LeftKey left_key, RightKey right_key) const {
+    return {std::forward<Left>(left), std::forward<Right>(right),
+        std::move(left_key), std::move(right_key)};
+  }
+
+  template <typename Right, typename LeftKey, typename RightKey>
+  FnPartial<Right, LeftKey, RightKey> operator()(
+      Right&& right, LeftKey left_key, RightKey right_key) const {
+    return {{}, std::forward<Right>(right), std::move(left_key),
+        std::move(right_key)};
+  }
+};
+
+namespace iter {
+  inline constexpr impl::MergeJoinFn merge_join{};
+}
+
+#endif
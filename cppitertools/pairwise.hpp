@@ -0,0 +1,11 @@
+#ifndef ITER_PAIRWISE_HPP_
+#define ITER_PAIRWISE_HPP_
+
+#include "sliding_window.hpp"
+
+namespace iter {
+  // each two consecutive elements, the same as sliding_window.fixed<2>
+  inline constexpr impl::FixedWindowFn<2> pairwise{};
+}
+
+#endif
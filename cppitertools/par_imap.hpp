@@ -0,0 +1,330 @@
+#ifndef ITER_PAR_IMAP_HPP_
+#define ITER_PAR_IMAP_HPP_
+
+#include "internal/iterator_wrapper.hpp"
+#include "internal/iterbase.hpp"
+#include "thread_pool.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+
+namespace iter {
+  namespace impl {
+    template <typename Func, typename Container>
+    class ParIMapper;
+
+    struct ParIMapFn;
+  }
+}
+
+// Like imap with a single iterable, but calls the function on a thread
+// pool.  The consumer takes up to window elements ahead from the
+// underlying iterable and submits a call for each, and the results are
+// yielded in the order of the elements.  Each result is computed once and
+// held until the iterator moves past it.  The function is called from
+// several threads at once.
+//
+// Elements are passed to the function by reference when the underlying
+// iterable yields references that stay valid, and copied otherwise.  An
+// exception thrown by the function is rethrown when its result is reached.
+// Stopping early waits for the calls already running, and skips the rest.
+template <typename Func, typename Container>
+class iter::impl::ParIMapper {
+ private:
+  mutable Func func_;
+  Container container_;
+  ThreadPool* pool_;
+  std::size_t window_;
+
+  friend ParIMapFn;
+
+  ParIMapper(Func f, Container&& container, ThreadPool& pool,
+      std::size_t window)
+      : func_(std::move(f)),
+        container_(std::forward<Container>(container)),
+        pool_{&pool},
+        window_{window > 0 ? window : 2 * pool.size()} {}
+
+  // The window of submitted calls.  Only the consumer's thread touches
+  // slots_ itself, the pool's threads only touch the slot they were given.
+  template <typename ContainerT>
+  class Run {
+   private:
+    using Arg = iterator_deref<ContainerT>;
+    static constexpr bool KeepsRefs =
+        std::is_lvalue_reference_v<Arg>
+        && is_iterator_at_least<iterator_type<ContainerT>,
+               std::forward_iterator_tag>;
+    using ArgHolder =
+        DerefHolder<std::conditional_t<KeepsRefs, Arg, std::decay_t<Arg>>>;
+
+   public:
+    using Result = std::invoke_result_t<Func&,
+        std::conditional_t<std::is_lvalue_reference_v<Arg>, Arg,
+            std::decay_t<Arg>&&>>;
+
+   private:
+    struct Slot {
+      ArgHolder arg;
+      DerefHolder<Result> result;
+      std::exception_ptr error;
+      bool done{false};
+    };
+
+    Func* func_;
+    ThreadPool* pool_;
+    std::size_t window_;
+    IteratorWrapper<ContainerT> sub_iter_;
+    IteratorWrapper<ContainerT> sub_end_;
+    std::deque<Slot> slots_;
+    bool front_ready_{false};
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::size_t pending_{0};
+    std::atomic<bool> cancelled_{false};
+
+    void compute(Slot& slot) {
+      if constexpr (std::is_lvalue_reference_v<Arg>) {
+        slot.result.reset(std::invoke(*func_, slot.arg.get()));
+      } else {
+        slot.result.reset(std::invoke(*func_, std::move(slot.arg.get())));
+      }
+    }
+
+    void run_task(Slot& slot) {
+      if (!cancelled_) {
+        try {
+          compute(slot);
+        } catch (...) {
+          slot.error = std::current_exception();
+        }
+      }
+      std::lock_guard<std::mutex> lock{mutex_};
+      slot.done = true;
+      --pending_;
+      cv_.notify_all();
+    }
+
+    void submit_next() {
+      auto& slot = slots_.emplace_back();
+      try {
+        if constexpr (ArgHolder::stores_value) {
+          slot.arg.reset(std::decay_t<Arg>(*sub_iter_));
+        } else {
+          slot.arg.reset(*sub_iter_);
+        }
+      } catch (...) {
+        slots_.pop_back();
+        throw;
+      }
+      {
+        std::lock_guard<std::mutex> lock{mutex_};
+        ++pending_;
+      }
+      pool_->submit([this, &slot] { run_task(slot); });
+      ++sub_iter_;
+    }
+
+   public:
+    Run(ContainerT& container, Func& f, ThreadPool& pool, std::size_t window)
+        : func_{&f},
+          pool_{&pool},
+          window_{window},
+          sub_iter_{get_begin(container)},
+          sub_end_{get_end(container)} {}
+
+    Run(const Run&) = delete;
+    Run& operator=(const Run&) = delete;
+
+    ~Run() {
+      cancelled_ = true;
+      std::unique_lock<std::mutex> lock{mutex_};
+      cv_.wait(lock, [this] { return pending_ == 0; });
+    }
+
+    void fill() {
+      while (slots_.size() < window_ && sub_iter_ != sub_end_) {
+        submit_next();
+      }
+    }
+
+    bool empty() const {
+      return slots_.empty();
+    }
+
+    void wait_for_front() {
+      if (!front_ready_) {
+        auto& slot = slots_.front();
+        std::unique_lock<std::mutex> lock{mutex_};
+        cv_.wait(lock, [&slot] { return slot.done; });
+        front_ready_ = true;
+      }
+    }
+
+    // waits for the oldest call, and rethrows its exception if it had one
+    DerefHolder<Result>& front() {
+      wait_for_front();
+      auto& slot = slots_.front();
+      if (slot.error) {
+        std::rethrow_exception(slot.error);
+      }
+      return slot.result;
+    }
+
+    // the oldest call may still be running if its result wasn't used
+    void pop() {
+      wait_for_front();
+      slots_.pop_front();
+      front_ready_ = false;
+      fill();
+    }
+  };
+
+ public:
+  ParIMapper(ParIMapper&&) = default;
+
+  template <typename ContainerT>
+  class Iterator {
+   private:
+    template <typename>
+    friend class Iterator;
+    using RunT = Run<ContainerT>;
+    using Holder = DerefHolder<typename RunT::Result>;
+
+    // null at the end
+    std::shared_ptr<RunT> run_;
+
+    void finish_if_empty() {
+      if (run_->empty()) {
+        run_.reset();
+      }
+    }
+
+   public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = std::decay_t<typename RunT::Result>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = typename Holder::pointer;
+    using reference = typename Holder::reference;
+
+    // the end iterator
+    Iterator() = default;
+
+    Iterator(ContainerT& container, Func& f, ThreadPool& pool,
+        std::size_t window)
+        : run_{std::make_shared<RunT>(container, f, pool, window)} {
+      run_->fill();
+      finish_if_empty();
+    }
+
+    reference operator*() {
+      return run_->front().get();
+    }
+
+    pointer operator->() {
+      return run_->front().get_ptr();
+    }
+
+    Iterator& operator++() {
+      run_->pop();
+      finish_if_empty();
+      return *this;
+    }
+
+    // The result is dropped once the iterator moves past it, so a postfix
+    // increment keeps it in a proxy for *it++
+    class PostIncrement {
+     private:
+      Holder item_;
+
+     public:
+      PostIncrement(Holder&& item) : item_(std::move(item)) {}
+      reference operator*() {
+        return item_.get();
+      }
+    };
+
+    PostIncrement operator++(int) {
+      PostIncrement ret{std::move(run_->front())};
+      ++*this;
+      return ret;
+    }
+
+    template <typename T>
+    bool operator!=(const Iterator<T>& other) const {
+      return static_cast<bool>(run_) != static_cast<bool>(other.run_);
+    }
+
+    template <typename T>
+    bool operator==(const Iterator<T>& other) const {
+      return !(*this != other);
+    }
+  };
+
+  Iterator<Container> begin() {
+    return {container_, func_, *pool_, window_};
+  }
+
+  Iterator<Container> end() {
+    return {};
+  }
+
+  Iterator<AsConst<Container>> begin() const {
+    return {std::as_const(container_), func_, *pool_, window_};
+  }
+
+  Iterator<AsConst<Container>> end() const {
+    return {};
+  }
+
+  SizeHint size_hint() const {
+    return size_hint_of(std::as_const(container_));
+  }
+};
+
+// par_imap(f, iterable, pool, window), or iterable | par_imap(f, pool,
+// window).  A window of 0 means twice the number of threads in the pool.
+struct iter::impl::ParIMapFn {
+ private:
+  template <typename Func>
+  struct FnPartial : Pipeable<FnPartial<Func>> {
+    Func func;
+    ThreadPool* pool;
+    std::size_t window;
+
+    template <typename Container>
+    ParIMapper<Func, Container> operator()(Container&& container) const {
+      return {func, std::forward<Container>(container), *pool, window};
+    }
+  };
+
+ public:
+  template <typename Func, typename Container>
+  ParIMapper<Func, Container> operator()(Func func, Container&& container,
+      ThreadPool& pool, std::size_t window = 0) const {
+    return {std::move(func), std::forward<Container>(container), pool,
+        window};
+  }
+
+  template <typename Func>
+  FnPartial<Func> operator()(
+      Func func, ThreadPool& pool, std::size_t window = 0) const {
+    return {{}, std::move(func), &pool, window};
+  }
+};
+
+namespace iter {
+  inline constexpr impl::ParIMapFn par_imap{};
+}
+
+#endif
@@ -0,0 +1,150 @@
+#ifndef ITER_PEEKABLE_HPP_
+#define ITER_PEEKABLE_HPP_
+
+#include "internal/iterator_wrapper.hpp"
+#include "internal/iterbase.hpp"
+
+#include <cstddef>
+#include <deque>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace iter {
+  namespace impl {
+    template <typename Container>
+    class Peekable;
+
+    using PeekableFn = IterToolFn<Peekable>;
+  }
+  inline constexpr impl::PeekableFn peekable{};
+}
+
+// Yields the elements of the underlying iterable, with iterators that can
+// look ahead.  it.peek(k) is a pointer to the element k places after *it,
+// or null if there aren't that many, so it.peek(0) is &*it.  Elements that
+// have been looked at are held by the iterator until it reaches them.
+// They are held by reference when the underlying iterable's references
+// stay valid, and copied otherwise.
+template <typename Container>
+class iter::impl::Peekable {
+ private:
+  Container container_;
+
+  friend PeekableFn;
+
+  Peekable(Container&& container)
+      : container_(std::forward<Container>(container)) {}
+
+ public:
+  Peekable(Peekable&&) = default;
+
+  template <typename ContainerT>
+  class Iterator {
+   private:
+    template <typename>
+    friend class Iterator;
+
+    using Arg = iterator_deref<ContainerT>;
+    static constexpr bool KeepsRefs =
+        std::is_lvalue_reference_v<Arg>
+        && is_iterator_at_least<iterator_type<ContainerT>,
+               std::forward_iterator_tag>;
+    using Value = std::remove_cv_t<std::remove_reference_t<Arg>>;
+    using Holder = DerefHolder<std::conditional_t<KeepsRefs, Arg, Value>>;
+
+    IteratorWrapper<ContainerT> sub_iter_;
+    IteratorWrapper<ContainerT> sub_end_;
+    // ahead_[0] is the current element, and sub_iter_ is past the last
+    std::deque<Holder> ahead_;
+
+    // returns false if there are fewer than n elements left
+    bool fill(std::size_t n) {
+      while (ahead_.size() < n && sub_iter_ != sub_end_) {
+        auto& item = ahead_.emplace_back();
+        if constexpr (KeepsRefs) {
+          item.reset(*sub_iter_);
+        } else {
+          item.reset(Value(*sub_iter_));
+        }
+        ++sub_iter_;
+      }
+      return ahead_.size() >= n;
+    }
+
+   public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = Value;
+    using difference_type = std::ptrdiff_t;
+    using pointer = typename Holder::pointer;
+    using reference = typename Holder::reference;
+
+    Iterator(IteratorWrapper<ContainerT>&& sub_iter,
+        IteratorWrapper<ContainerT>&& sub_end)
+        : sub_iter_{std::move(sub_iter)}, sub_end_{std::move(sub_end)} {
+      fill(1);
+    }
+
+    reference operator*() {
+      return ahead_.front().get();
+    }
+
+    pointer operator->() {
+      return ahead_.front().get_ptr();
+    }
+
+    pointer peek(std::size_t k = 1) {
+      return fill(k + 1) ? ahead_[k].get_ptr() : nullptr;
+    }
+
+    Iterator& operator++() {
+      ahead_.pop_front();
+      fill(1);
+      return *this;
+    }
+
+    Iterator operator++(int) {
+      auto ret = *this;
+      ++*this;
+      return ret;
+    }
+
+    template <typename T>
+    bool operator!=(const Iterator<T>& other) const {
+      if (ahead_.empty() || other.ahead_.empty()) {
+        return ahead_.empty() != other.ahead_.empty();
+      }
+      return sub_iter_ != other.sub_iter_
+             || ahead_.size() != other.ahead_.size();
+    }
+
+    template <typename T>
+    bool operator==(const Iterator<T>& other) const {
+      return !(*this != other);
+    }
+  };
+
+  Iterator<Container> begin() {
+    return {get_begin(container_), get_end(container_)};
+  }
+
+  Iterator<Container> end() {
+    return {get_end(container_), get_end(container_)};
+  }
+
+  Iterator<AsConst<Container>> begin() const {
+    return {get_begin(std::as_const(container_)),
+        get_end(std::as_const(container_))};
+  }
+
+  Iterator<AsConst<Container>> end() const {
+    return {get_end(std::as_const(container_)),
+        get_end(std::as_const(container_))};
+  }
+
+  SizeHint size_hint() const {
+    return size_hint_of(std::as_const(container_));
+  }
+};
+
+#endif
@@ -8,6 +8,7 @@
 #include <algorithm>
 #include <initializer_list>
 #include <iterator>
+#include <optional>
 #include <utility>
 #include <vector>
 
@@ -123,6 +124,23 @@ class iter::impl::Permuter {
     return {get_end(std::as_const(container_)),
         get_end(std::as_const(container_))};
   }
+
+  // at most n!, and fewer when elements repeat since equal ones aren't
+  // reordered
+  SizeHint size_hint() const {
+    auto hint = size_hint_of(std::as_const(container_));
+    std::optional<std::size_t> upper;
+    if (hint.upper) {
+      upper = 1;
+      for (std::size_t i = 2; upper && i <= *hint.upper; ++i) {
+        upper = size_hints::checked_mul(upper, i);
+      }
+      if (*hint.upper == 0) {
+        upper = 0;
+      }
+    }
+    return {std::min<std::size_t>(hint.lower, 1), upper};
+  }
 };
 
 #endif
@@ -0,0 +1,576 @@
+#ifndef ITER_PIPELINE_HPP_
+#define ITER_PIPELINE_HPP_
+
+#include "internal/iterator_wrapper.hpp"
+#include "internal/iterbase.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace iter {
+  namespace impl {
+    template <typename Container, typename Adaptor, bool Ordered>
+    class Staged;
+
+    template <bool Ordered>
+    struct StageFn;
+
+    struct StageStats;
+  }
+}
+
+// Totals for every run of a stage so far.  busy is the time the stage's
+// threads spent in the adaptor, not counting time spent waiting on the
+// upstream iterable or for room in the output queue.
+struct iter::impl::StageStats {
+  std::size_t items_in;
+  std::size_t items_out;
+  std::chrono::nanoseconds busy;
+};
+
+// Runs an adaptor such as imap(f) or filter(pred) over the underlying
+// iterable on threads of its own, and yields the adaptor's output.  Each
+// thread applies its own copy of the adaptor to an iterable that takes
+// elements from the shared underlying iterable, one at a time under a
+// lock.  At most queue_size elements can be waiting between the stage and
+// whatever consumes it, after which the stage's threads wait.
+//
+// When ordered, output comes in the order of the elements it came from.
+// This relies on the adaptor producing all output for an element before
+// taking the next, which element-wise adaptors such as imap, filter and
+// filterfalse do.  Unordered output comes as soon as it is ready.
+//
+// An exception thrown in a stage thread stops the stage, and is rethrown
+// from the consumer's iterator once the output before it has been used.
+// When ordered, that is the output of every element before the one which
+// threw, which is still finished by the threads working on it.
+// Each call to begin() starts new threads, which stop when the last copy
+// of that iterator is destroyed.  The Staged object must not be moved
+// while it's being iterated over.
+template <typename Container, typename Adaptor, bool Ordered>
+class iter::impl::Staged {
+ private:
+  friend StageFn<Ordered>;
+
+  struct Counters {
+    std::atomic<std::size_t> items_in{0};
+    std::atomic<std::size_t> items_out{0};
+    std::atomic<std::chrono::nanoseconds::rep> busy_ns{0};
+  };
+
+  Container container_;
+  Adaptor adaptor_;
+  std::size_t num_threads_;
+  std::size_t queue_size_;
+  std::unique_ptr<Counters> counters_ = std::make_unique<Counters>();
+
+  Staged(Container&& container, Adaptor adaptor, std::size_t num_threads,
+      std::size_t queue_size)
+      : container_(std::forward<Container>(container)),
+        adaptor_(std::move(adaptor)),
+        num_threads_{num_threads > 0 ? num_threads : 1},
+        queue_size_{queue_size > 0 ? queue_size : 1} {}
+
+  // the threads and queues of one iteration
+  template <typename ContainerT>
+  class Run {
+   private:
+    using Clock = std::chrono::steady_clock;
+    using InValue = std::remove_cv_t<iterator_traits_deref<ContainerT>>;
+
+    // what each thread knows about the element it's working on
+    struct Worker {
+      std::optional<InValue> value;
+      std::optional<std::size_t> seq;
+      Clock::duration waiting{};
+    };
+
+    // the iterable a thread's adaptor is applied to
+    class Source {
+     private:
+      Run* run_;
+      Worker* worker_;
+
+     public:
+      Source(Run* run, Worker* worker) : run_{run}, worker_{worker} {}
+
+      class Iterator {
+       private:
+        Source* source_{};
+
+       public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = InValue;
+        using difference_type = std::ptrdiff_t;
+        using pointer = InValue*;
+        using reference = InValue&;
+
+        Iterator() = default;
+
+        Iterator(Source* source) : source_{source} {
+          ++*this;
+        }
+
+        InValue& operator*() const {
+          return *source_->worker_->value;
+        }
+
+        InValue* operator->() const {
+          return &**this;
+        }
+
+        Iterator& operator++() {
+          if (!source_->run_->pull(*source_->worker_)) {
+            source_ = nullptr;
+          }
+          return *this;
+        }
+
+        // the worker's value is replaced by the next pull, so a postfix
+        // increment keeps the old one in a proxy for *it++
+        class PostIncrement {
+         private:
+          InValue value_;
+
+         public:
+          PostIncrement(InValue&& value) : value_(std::move(value)) {}
+          InValue& operator*() {
+            return value_;
+          }
+        };
+
+        PostIncrement operator++(int) {
+          PostIncrement ret{std::move(**this)};
+          ++*this;
+          return ret;
+        }
+
+        bool operator!=(const Iterator& other) const {
+          return source_ != other.source_;
+        }
+
+        bool operator==(const Iterator& other) const {
+          return !(*this != other);
+        }
+      };
+
+      Iterator begin() {
+        return {this};
+      }
+
+      Iterator end() {
+        return {};
+      }
+    };
+
+    using View = decltype(std::declval<const Adaptor&>()(
+        std::declval<Source&>()));
+
+   public:
+    using Value = std::remove_cv_t<iterator_traits_deref<View>>;
+
+   private:
+    // an element's output, complete once the thread has moved on
+    struct Slot {
+      std::vector<Value> values;
+      bool done = false;
+    };
+
+    const Adaptor* adaptor_;
+    Counters* counters_;
+    std::size_t queue_size_;
+
+    std::mutex upstream_mutex_;
+    IteratorWrapper<ContainerT> sub_iter_;
+    IteratorWrapper<ContainerT> sub_end_;
+    bool started_ = false;
+    bool exhausted_ = false;
+
+    std::mutex mutex_;
+    std::condition_variable ready_cv_;
+    std::condition_variable room_cv_;
+    // ordered output, slots_.front() is for element base_seq_
+    std::deque<Slot> slots_;
+    std::size_t base_seq_ = 0;
+    std::size_t cursor_ = 0;
+    // unordered output
+    std::deque<Value> queue_;
+    // whether the consumer is holding an output from the last call to next
+    bool holding_ = false;
+    std::size_t active_workers_ = 0;
+    bool cancelled_ = false;
+    std::exception_ptr error_;
+    // ordered, the element error_ came from.  Output for the elements
+    // before it is still yielded first.
+    std::size_t error_seq_ = 0;
+
+    std::vector<std::thread> threads_;
+
+    // the element a thread was working on has had all of its output
+    void finish_element(Worker& worker) {
+      if constexpr (Ordered) {
+        if (worker.seq) {
+          std::lock_guard<std::mutex> lock{mutex_};
+          slots_[*worker.seq - base_seq_].done = true;
+          if (*worker.seq == base_seq_) {
+            ready_cv_.notify_all();
+          }
+        }
+      }
+      worker.seq.reset();
+    }
+
+    // Takes the next element of the underlying iterable for worker, or
+    // returns false if there are no more or the stage is stopping.
+    bool pull(Worker& worker) {
+      finish_element(worker);
+      worker.value.reset();
+      const auto start = Clock::now();
+      std::lock_guard<std::mutex> upstream_lock{upstream_mutex_};
+      {
+        std::unique_lock<std::mutex> lock{mutex_};
+        if constexpr (Ordered) {
+          room_cv_.wait(lock, [this] {
+            return slots_.size() < queue_size_ || cancelled_;
+          });
+        }
+        if (cancelled_) {
+          return false;
+        }
+      }
+      if (exhausted_) {
+        return false;
+      }
+      try {
+        if (started_) {
+          ++sub_iter_;
+        }
+        started_ = true;
+        if (!(sub_iter_ != sub_end_)) {
+          exhausted_ = true;
+          worker.waiting += Clock::now() - start;
+          return false;
+        }
+        worker.value.emplace(*sub_iter_);
+      } catch (...) {
+        if constexpr (Ordered) {
+          // the element that failed to arrive is the one that would have
+          // come next
+          std::lock_guard<std::mutex> lock{mutex_};
+          worker.seq = base_seq_ + slots_.size();
+          slots_.emplace_back();
+        }
+        throw;
+      }
+      if constexpr (Ordered) {
+        std::lock_guard<std::mutex> lock{mutex_};
+        worker.seq = base_seq_ + slots_.size();
+        slots_.emplace_back();
+      }
+      ++counters_->items_in;
+      worker.waiting += Clock::now() - start;
+      return true;
+    }
+
+    template <typename T>
+    void push(Worker& worker, T&& value) {
+      const auto start = Clock::now();
+      {
+        std::unique_lock<std::mutex> lock{mutex_};
+        if constexpr (Ordered) {
+          slots_[*worker.seq - base_seq_].values.emplace_back(
+              std::forward<T>(value));
+        } else {
+          room_cv_.wait(lock, [this] {
+            return queue_.size() < queue_size_ || cancelled_;
+          });
+          if (cancelled_) {
+            return;
+          }
+          queue_.emplace_back(std::forward<T>(value));
+          ready_cv_.notify_all();
+        }
+      }
+      ++counters_->items_out;
+      worker.waiting += Clock::now() - start;
+    }
+
+    void work() {
+      Worker worker;
+      const auto start = Clock::now();
+      try {
+        Source source{this, &worker};
+        auto view = (*adaptor_)(source);
+        auto view_end = get_end(view);
+        for (auto it = get_begin(view); it != view_end; ++it) {
+          push(worker, *it);
+        }
+      } catch (...) {
+        std::lock_guard<std::mutex> lock{mutex_};
+        if constexpr (Ordered) {
+          // an element without a slot failed before taking one, so it is
+          // after every element that has one
+          auto seq = worker.seq ? *worker.seq : base_seq_ + slots_.size();
+          if (!error_ || seq < error_seq_) {
+            error_ = std::current_exception();
+            error_seq_ = seq;
+          }
+          if (worker.seq) {
+            slots_[*worker.seq - base_seq_].done = true;
+            worker.seq.reset();
+          }
+          ready_cv_.notify_all();
+        } else if (!error_) {
+          error_ = std::current_exception();
+        }
+        cancelled_ = true;
+        room_cv_.notify_all();
+      }
+      finish_element(worker);
+      counters_->busy_ns +=
+          std::chrono::duration_cast<std::chrono::nanoseconds>(
+              Clock::now() - start - worker.waiting)
+              .count();
+      std::lock_guard<std::mutex> lock{mutex_};
+      --active_workers_;
+      ready_cv_.notify_all();
+    }
+
+    bool finished() const {
+      return active_workers_ == 0 || cancelled_;
+    }
+
+   public:
+    Run(ContainerT& container, const Adaptor& adaptor, Counters& counters,
+        std::size_t num_threads, std::size_t queue_size)
+        : adaptor_{&adaptor},
+          counters_{&counters},
+          queue_size_{queue_size},
+          sub_iter_{get_begin(container)},
+          sub_end_{get_end(container)},
+          active_workers_{num_threads} {
+      threads_.reserve(num_threads);
+      for (std::size_t i = 0; i < num_threads; ++i) {
+        threads_.emplace_back([this] { work(); });
+      }
+    }
+
+    Run(const Run&) = delete;
+    Run& operator=(const Run&) = delete;
+
+    ~Run() {
+      {
+        std::lock_guard<std::mutex> lock{mutex_};
+        cancelled_ = true;
+      }
+      room_cv_.notify_all();
+      for (auto& t : threads_) {
+        t.join();
+      }
+    }
+
+    // Moves past the current output, if there is one, and waits for the
+    // next.  Returns null at the end.  The returned output stays where it
+    // is until the next call.
+    Value* next() {
+      std::unique_lock<std::mutex> lock{mutex_};
+      if constexpr (Ordered) {
+        if (holding_) {
+          ++cursor_;
+          holding_ = false;
+        }
+        for (;;) {
+          while (!slots_.empty() && slots_.front().done
+                 && cursor_ == slots_.front().values.size()
+                 && !(error_ && base_seq_ == error_seq_)) {
+            slots_.pop_front();
+            ++base_seq_;
+            cursor_ = 0;
+            room_cv_.notify_all();
+          }
+          if (!slots_.empty() && slots_.front().done
+              && cursor_ < slots_.front().values.size()) {
+            holding_ = true;
+            return &slots_.front().values[cursor_];
+          }
+          if (error_) {
+            // the elements before the failed one finish even though the
+            // stage is stopping
+            if (base_seq_ == error_seq_) {
+              std::rethrow_exception(error_);
+            }
+          } else if (finished() && (slots_.empty() || cancelled_)) {
+            return nullptr;
+          }
+          ready_cv_.wait(lock);
+        }
+      } else {
+        if (holding_) {
+          queue_.pop_front();
+          room_cv_.notify_all();
+          holding_ = false;
+        }
+        ready_cv_.wait(
+            lock, [this] { return !queue_.empty() || finished() || error_; });
+        if (!queue_.empty()) {
+          holding_ = true;
+          return &queue_.front();
+        }
+        if (error_) {
+          std::rethrow_exception(error_);
+        }
+        return nullptr;
+      }
+    }
+  };
+
+ public:
+  Staged(Staged&&) = default;
+
+  template <typename ContainerT>
+  class Iterator {
+   private:
+    template <typename>
+    friend class Iterator;
+    using RunT = Run<ContainerT>;
+    using Value = typename RunT::Value;
+
+    // null at the end
+    std::shared_ptr<RunT> run_;
+    Value* current_{};
+
+    void advance() {
+      current_ = run_->next();
+      if (!current_) {
+        run_.reset();
+      }
+    }
+
+   public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = Value;
+    using difference_type = std::ptrdiff_t;
+    using pointer = value_type*;
+    using reference = value_type&;
+
+    // the end iterator
+    Iterator() = default;
+
+    Iterator(ContainerT& container, const Adaptor& adaptor,
+        Counters& counters, std::size_t num_threads, std::size_t queue_size)
+        : run_{std::make_shared<RunT>(
+              container, adaptor, counters, num_threads, queue_size)} {
+      advance();
+    }
+
+    Value& operator*() {
+      return *current_;
+    }
+
+    Value* operator->() {
+      return current_;
+    }
+
+    Iterator& operator++() {
+      advance();
+      return *this;
+    }
+
+    // The output's storage is reused once the iterator moves past it, so a
+    // postfix increment keeps the old output in a proxy for *it++
+    class PostIncrement {
+     private:
+      Value value_;
+
+     public:
+      PostIncrement(Value&& value) : value_(std::move(value)) {}
+      Value& operator*() {
+        return value_;
+      }
+    };
+
+    PostIncrement operator++(int) {
+      PostIncrement ret{std::move(**this)};
+      ++*this;
+      return ret;
+    }
+
+    template <typename T>
+    bool operator!=(const Iterator<T>& other) const {
+      return static_cast<bool>(run_) != static_cast<bool>(other.run_);
+    }
+
+    template <typename T>
+    bool operator==(const Iterator<T>& other) const {
+      return !(*this != other);
+    }
+  };
+
+  Iterator<Container> begin() {
+    return {container_, adaptor_, *counters_, num_threads_, queue_size_};
+  }
+
+  Iterator<Container> end() {
+    return {};
+  }
+
+  Iterator<AsConst<Container>> begin() const {
+    return {std::as_const(container_), adaptor_, *counters_, num_threads_,
+        queue_size_};
+  }
+
+  Iterator<AsConst<Container>> end() const {
+    return {};
+  }
+
+  StageStats stats() const {
+    return {counters_->items_in, counters_->items_out,
+        std::chrono::nanoseconds{counters_->busy_ns.load()}};
+  }
+};
+
+// stage(adaptor, num_threads, queue_size) makes a pipeable stage boundary:
+// iterable | stage(imap(f), 4) runs imap(f) over iterable on 4 threads
+template <bool Ordered>
+struct iter::impl::StageFn {
+ private:
+  template <typename Adaptor>
+  struct FnPartial : Pipeable<FnPartial<Adaptor>> {
+    Adaptor adaptor;
+    std::size_t num_threads;
+    std::size_t queue_size;
+
+    template <typename Container>
+    Staged<Container, Adaptor, Ordered> operator()(
+        Container&& container) const {
+      return {std::forward<Container>(container), adaptor, num_threads,
+          queue_size};
+    }
+  };
+
+ public:
+  template <typename Adaptor>
+  FnPartial<std::decay_t<Adaptor>> operator()(Adaptor&& adaptor,
+      std::size_t num_threads = 1, std::size_t queue_size = 64) const {
+    return {{}, std::forward<Adaptor>(adaptor), num_threads, queue_size};
+  }
+};
+
+namespace iter {
+  inline constexpr impl::StageFn<true> stage{};
+  inline constexpr impl::StageFn<false> unordered_stage{};
+}
+
+#endif
@@ -7,6 +7,7 @@
 #include <cassert>
 #include <initializer_list>
 #include <iterator>
+#include <limits>
 #include <memory>
 #include <type_traits>
 #include <utility>
@@ -115,7 +116,7 @@ class iter::impl::Powersetter {
   }
 
   Iterator<Container> end() {
-    return {container_, dumb_size(container_) + 1};
+    return {container_, exact_size(container_) + 1};
   }
 
   Iterator<AsConst<Container>> begin() const {
@@ -124,7 +125,18 @@ class iter::impl::Powersetter {
 
   Iterator<AsConst<Container>> end() const {
     return {
-        std::as_const(container_), dumb_size(std::as_const(container_)) + 1};
+        std::as_const(container_), exact_size(std::as_const(container_)) + 1};
+  }
+
+  // 2 to the n
+  SizeHint size_hint() const {
+    return size_hints::map(size_hint_of(std::as_const(container_)),
+        [](std::size_t n) -> std::optional<std::size_t> {
+          if (n >= std::numeric_limits<std::size_t>::digits) {
+            return std::nullopt;
+          }
+          return std::size_t{1} << n;
+        });
   }
 };
 
@@ -0,0 +1,185 @@
+#ifndef ITER_PREFETCH_HPP_
+#define ITER_PREFETCH_HPP_
+
+#include "internal/iterbase.hpp"
+#include "internal/spsc_ring.hpp"
+
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace iter {
+  namespace impl {
+    template <typename Container>
+    class Prefetcher;
+
+    using PrefetchFn = IterToolFnBindSizeTSecond<Prefetcher>;
+  }
+  inline constexpr impl::PrefetchFn prefetch{};
+}
+
+// Iterates the underlying iterable on a background thread, which runs up
+// to n elements ahead of the consumer.  Each element is moved into a ring
+// buffer and yielded from there.  An exception thrown by the underlying
+// iterable is rethrown to the consumer once the elements before it have
+// been used.  Each call to begin() starts a new thread, which stops when
+// the last copy of that iterator is destroyed.  The Prefetcher must not be
+// moved while it's being iterated over.
+template <typename Container>
+class iter::impl::Prefetcher {
+ private:
+  Container container_;
+  std::size_t buffer_size_;
+
+  friend PrefetchFn;
+
+  Prefetcher(Container&& container, std::size_t buffer_size)
+      : container_(std::forward<Container>(container)),
+        buffer_size_{buffer_size} {}
+
+  // the ring and the thread filling it
+  template <typename ContainerT>
+  class Pump {
+   public:
+    using Value = std::remove_cv_t<iterator_traits_deref<ContainerT>>;
+
+   private:
+    SpscRing<Value> ring_;
+    std::thread thread_;
+
+    void run(ContainerT& container) {
+      try {
+        auto sub_end = get_end(container);
+        for (auto it = get_begin(container); it != sub_end; ++it) {
+          if (!ring_.push(*it)) {
+            return;
+          }
+        }
+        ring_.close();
+      } catch (...) {
+        ring_.fail(std::current_exception());
+      }
+    }
+
+   public:
+    Pump(ContainerT& container, std::size_t buffer_size)
+        : ring_(buffer_size), thread_([this, &container] { run(container); }) {}
+
+    Pump(const Pump&) = delete;
+    Pump& operator=(const Pump&) = delete;
+
+    ~Pump() {
+      ring_.cancel();
+      thread_.join();
+    }
+
+    SpscRing<Value>& ring() {
+      return ring_;
+    }
+  };
+
+ public:
+  Prefetcher(Prefetcher&&) = default;
+
+  template <typename ContainerT>
+  class Iterator {
+   private:
+    template <typename>
+    friend class Iterator;
+    using PumpT = Pump<ContainerT>;
+    using Value = typename PumpT::Value;
+
+    // null at the end
+    std::shared_ptr<PumpT> pump_;
+
+    void wait_or_finish() {
+      if (!pump_->ring().wait()) {
+        pump_.reset();
+      }
+    }
+
+   public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = Value;
+    using difference_type = std::ptrdiff_t;
+    using pointer = value_type*;
+    using reference = value_type&;
+
+    // the end iterator
+    Iterator() = default;
+
+    Iterator(ContainerT& container, std::size_t buffer_size)
+        : pump_{std::make_shared<PumpT>(container, buffer_size)} {
+      wait_or_finish();
+    }
+
+    Value& operator*() {
+      return pump_->ring().front();
+    }
+
+    Value* operator->() {
+      return &**this;
+    }
+
+    Iterator& operator++() {
+      pump_->ring().pop();
+      wait_or_finish();
+      return *this;
+    }
+
+    // The element's slot is reused once the iterator moves past it, so a
+    // postfix increment keeps the old element in a proxy for *it++
+    class PostIncrement {
+     private:
+      Value value_;
+
+     public:
+      PostIncrement(Value&& value) : value_(std::move(value)) {}
+      Value& operator*() {
+        return value_;
+      }
+    };
+
+    PostIncrement operator++(int) {
+      PostIncrement ret{std::move(**this)};
+      ++*this;
+      return ret;
+    }
+
+    template <typename T>
+    bool operator!=(const Iterator<T>& other) const {
+      return static_cast<bool>(pump_) != static_cast<bool>(other.pump_);
+    }
+
+    template <typename T>
+    bool operator==(const Iterator<T>& other) const {
+      return !(*this != other);
+    }
+  };
+
+  Iterator<Container> begin() {
+    return {container_, buffer_size_};
+  }
+
+  Iterator<Container> end() {
+    return {};
+  }
+
+  Iterator<AsConst<Container>> begin() const {
+    return {std::as_const(container_), buffer_size_};
+  }
+
+  Iterator<AsConst<Container>> end() const {
+    return {};
+  }
+
+  SizeHint size_hint() const {
+    return size_hint_of(std::as_const(container_));
+  }
+};
+
+#endif
@@ -178,6 +178,14 @@ class iter::impl::Productor {
     return {{get_end(std::as_const(std::get<Is>(containers_)))...},
         {get_end(std::as_const(std::get<Is>(containers_)))...}};
   }
+
+  SizeHint size_hint() const {
+    auto hint = size_hints::exactly(1);
+    ((hint = size_hints::product(
+          hint, size_hint_of(std::as_const(std::get<Is>(containers_))))),
+        ...);
+    return hint;
+  }
 };
 
 namespace iter::impl {
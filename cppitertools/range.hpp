@@ -3,15 +3,43 @@
 
 #include "internal/iterbase.hpp"
 
+#include <array>
 #include <cassert>
 #include <exception>
 #include <iterator>
+#include <limits>
+#include <optional>
 #include <type_traits>
+#include <utility>
 
 namespace iter {
   namespace impl {
     template <typename T>
     class Range;
+
+    template <typename Owner>
+    class IndexedIterator;
+
+    template <typename T>
+    class RangeChunks;
+
+    template <typename T, std::size_t N>
+    class ValueBlock;
+
+    template <typename Seq, std::size_t N>
+    class Blocked;
+
+    // true for Ranges over integral types, whose sub-ranges can be
+    // computed in closed form rather than by walking the elements
+    template <typename T>
+    struct IsIntegralRange : std::false_type {};
+
+    template <typename T>
+    struct IsIntegralRange<Range<T>> : std::is_integral<T> {};
+
+    template <typename T>
+    constexpr bool is_integral_range =
+        IsIntegralRange<std::remove_cv_t<std::remove_reference_t<T>>>::value;
   }
 
   template <typename T>
@@ -28,31 +56,50 @@ namespace iter {
     class RangeIterData;
 
     // everything except floats
+    // The position is tracked as an index from the start so that the
+    // iterator can be random access, and so that the value is a simple
+    // function of the index which the optimizer can see through.
     template <typename T>
     class RangeIterData<T, false> {
      private:
-      T value_{};
+      T start_{};
       T step_{};
+      // unsigned so that ranges with more elements than PTRDIFF_MAX, such
+      // as those made by count(), still have a well defined end
+      std::size_t index_{};
 
      public:
       constexpr RangeIterData() noexcept = default;
-      constexpr RangeIterData(T in_value, T in_step) noexcept
-          : value_{in_value}, step_{in_step} {}
+      constexpr RangeIterData(
+          T in_start, T in_step, std::size_t in_index) noexcept
+          : start_{in_start}, step_{in_step}, index_{in_index} {}
 
       constexpr T value() const noexcept {
-        return value_;
+        return static_cast<T>(start_ + step_ * index_);
       }
 
       constexpr T step() const noexcept {
         return step_;
       }
 
+      constexpr std::size_t index() const noexcept {
+        return index_;
+      }
+
       void inc() noexcept {
-        value_ += step_;
+        ++index_;
+      }
+
+      void dec() noexcept {
+        --index_;
+      }
+
+      void advance(std::ptrdiff_t n) noexcept {
+        index_ += static_cast<std::size_t>(n);
       }
 
       constexpr bool operator==(const RangeIterData& other) const noexcept {
-        return value_ == other.value_;
+        return index_ == other.index_;
       }
 
       constexpr bool operator!=(const RangeIterData& other) const noexcept {
@@ -114,14 +161,21 @@ class iter::impl::Range {
   friend constexpr Range<U> iter::range(U, U, U) noexcept;
 
  private:
-  const T start_;
-  const T stop_;
-  const T step_;
+  T start_;
+  T stop_;
+  T step_;
+  // set for a sub-range whose last element is the end of T, which has no
+  // value past it to stop at, so stop_ is that last element instead
+  bool includes_stop_{false};
 
   constexpr Range(T stop) noexcept : start_{0}, stop_{stop}, step_{1} {}
 
-  constexpr Range(T start, T stop, T step = 1) noexcept
-      : start_{start}, stop_{stop}, step_{step} {}
+  constexpr Range(
+      T start, T stop, T step = 1, bool includes_stop = false) noexcept
+      : start_{start},
+        stop_{stop},
+        step_{step},
+        includes_stop_{includes_stop} {}
 
   // if val is "before" the stopping point.
   static constexpr bool is_within_range(
@@ -134,11 +188,34 @@ class iter::impl::Range {
     }
   }
 
+  // |lhs - rhs|, computed as unsigned so that values on opposite sides of
+  // zero, or at opposite ends of T, can't overflow
+  static constexpr auto abs_diff(T lhs, T rhs) noexcept {
+    using UnsignedT = std::make_unsigned_t<T>;
+    return lhs < rhs ? static_cast<UnsignedT>(static_cast<UnsignedT>(rhs)
+                                              - static_cast<UnsignedT>(lhs))
+                     : static_cast<UnsignedT>(static_cast<UnsignedT>(lhs)
+                                              - static_cast<UnsignedT>(rhs));
+  }
+
+  // the smallest range containing exactly the given values
+  static constexpr Range from_first_and_last(T first, T last, T step) {
+    if (step > 0 ? last == std::numeric_limits<T>::max()
+                 : last == std::numeric_limits<T>::min()) {
+      return {first, last, step, true};
+    }
+    return {first, step > 0 ? static_cast<T>(last + 1)
+                            : static_cast<T>(last - 1),
+        step};
+  }
+
  public:
   constexpr T start() const noexcept {
     return start_;
   }
 
+  // A sub-range running to the largest or smallest value of T, such as
+  // reversed(range(INT_MIN, 5)), includes its stop() as the last element.
   constexpr T stop() const noexcept {
     return stop_;
   }
@@ -154,18 +231,115 @@ class iter::impl::Range {
   constexpr std::size_t size() const noexcept {
     static_assert(!std::is_floating_point_v<T>,
         "range size() not supperted with floating point types");
+    if constexpr (std::is_integral_v<T>) {
+      if (includes_stop_) {
+        return static_cast<std::size_t>(
+            abs_diff(start(), stop()) / abs_diff(step(), 0) + 1);
+      }
+    }
     if (!is_within_range(start(), stop(), step())) {
       return 0;
     }
 
-    auto diff = stop() - start();
-    auto res = diff / step();
-    assert(res >= 0);
-    auto result = static_cast<std::size_t>(res);
-    if (diff % step()) {
-      ++result;
+    if constexpr (std::is_integral_v<T>) {
+      // stop and start may be very far apart, as in count()
+      auto dist = abs_diff(start(), stop());
+      return static_cast<std::size_t>((dist - 1) / abs_diff(step(), 0) + 1);
+    } else {
+      auto diff = stop() - start();
+      auto res = diff / step();
+      assert(res >= 0);
+      auto result = static_cast<std::size_t>(res);
+      if (diff % step()) {
+        ++result;
+      }
+      return result;
+    }
+  }
+
+  constexpr bool empty() const noexcept {
+    return size() == 0;
+  }
+
+  // exact, except for floating point ranges which can't compute their size
+  constexpr SizeHint size_hint() const noexcept {
+    if constexpr (std::is_floating_point_v<T>) {
+      return {};
+    } else {
+      return {size(), size()};
+    }
+  }
+
+  // The position of value in the range, or nullopt if iterating over the
+  // range would never produce value.
+  constexpr std::optional<std::size_t> index_of(T value) const noexcept {
+    static_assert(std::is_integral_v<T>,
+        "range index_of() only supported with integral types");
+    if (step() > 0 ? value < start() : value > start()) {
+      return std::nullopt;
+    }
+    auto dist = abs_diff(start(), value);
+    auto step_dist = abs_diff(step(), 0);
+    if (dist % step_dist != 0) {
+      return std::nullopt;
     }
-    return result;
+    auto index = static_cast<std::size_t>(dist / step_dist);
+    if (index >= size()) {
+      return std::nullopt;
+    }
+    return index;
+  }
+
+  constexpr bool contains(T value) const noexcept {
+    return index_of(value).has_value();
+  }
+
+  // The elements at positions [first, last) of this range, taking every
+  // index_step-th one, as a new Range.  Positions past the end are clamped
+  // to size(), and first >= last or an index_step of 0 gives an empty
+  // range.
+  constexpr Range slice(std::size_t first, std::size_t last,
+      std::size_t index_step = 1) const noexcept {
+    static_assert(std::is_integral_v<T>,
+        "range slice() only supported with integral types");
+    const auto sz = size();
+    last = last < sz ? last : sz;
+    if (first >= last || index_step == 0) {
+      return {start(), start(), step()};
+    }
+    auto count = (last - first - 1) / index_step + 1;
+    auto new_step = count == 1 ? step() : static_cast<T>(step() * index_step);
+    return from_first_and_last(
+        (*this)[first], (*this)[first + (count - 1) * index_step], new_step);
+  }
+
+  // The same elements in the opposite order, as a new Range.
+  constexpr Range reversed() const noexcept {
+    static_assert(std::is_integral_v<T> && std::is_signed_v<T>,
+        "range reversed() only supported with signed integral types");
+    const auto sz = size();
+    auto new_step = sz > 1 ? static_cast<T>(-step())
+                           : static_cast<T>(step() > 0 ? -1 : 1);
+    if (sz == 0) {
+      return {start(), start(), new_step};
+    }
+    return from_first_and_last((*this)[sz - 1], start(), new_step);
+  }
+
+  constexpr RangeChunks<T> chunked(std::size_t chunk_size) const noexcept {
+    static_assert(std::is_integral_v<T>,
+        "range chunked() only supported with integral types");
+    return {*this, chunk_size};
+  }
+
+  // Consecutive groups of N values, each held contiguously so that SIMD
+  // kernels can load them directly.
+  template <std::size_t N>
+  constexpr Blocked<Range, N> blocks() const noexcept {
+    static_assert(std::is_integral_v<T>,
+        "range blocks() only supported with integral types, "
+        "see linspace for floating point grids");
+    return {*this};
   }
 
   // the reference type here is T, which doesn't strictly follow all
@@ -174,6 +348,7 @@ class iter::impl::Range {
 
   class Iterator {
    private:
+    static constexpr bool is_float = std::is_floating_point_v<T>;
     iter::detail::RangeIterData<T> data;
     bool is_end{};
 
@@ -196,7 +371,10 @@ class iter::impl::Range {
     }
 
    public:
-    using iterator_category = std::forward_iterator_tag;
+    // floating point ranges can't compute their size, so they are only
+    // forward iterators
+    using iterator_category = std::conditional_t<is_float,
+        std::forward_iterator_tag, std::random_access_iterator_tag>;
     using value_type = T;
     using difference_type = std::ptrdiff_t;
     using pointer = value_type*;
@@ -204,8 +382,9 @@ class iter::impl::Range {
 
     constexpr Iterator() noexcept = default;
 
-    constexpr Iterator(T in_value, T in_step, bool in_is_end) noexcept
-        : data(in_value, in_step), is_end{in_is_end} {}
+    constexpr Iterator(
+        iter::detail::RangeIterData<T> in_data, bool in_is_end) noexcept
+        : data(in_data), is_end{in_is_end} {}
 
     constexpr T operator*() const noexcept {
       return data.value();
@@ -247,28 +426,353 @@ class iter::impl::Range {
     // Two end iterators will compare equal
     //
     // Two non-end iterators will compare by their stored values
+    //
+    // Non-float ranges know their size, so their end iterator is placed
+    // exactly at index size() and all comparisons are by index.
     bool operator!=(const Iterator& other) const noexcept {
-      if (is_end && other.is_end) {
-        return false;
-      }
-
-      if (!is_end && !other.is_end) {
+      if constexpr (!is_float) {
         return data != other.data;
+      } else {
+        if (is_end && other.is_end) {
+          return false;
+        }
+
+        if (!is_end && !other.is_end) {
+          return data != other.data;
+        }
+        return not_equal_to_end(*this, other);
       }
-      return not_equal_to_end(*this, other);
     }
 
     bool operator==(const Iterator& other) const noexcept {
       return !(*this != other);
     }
+
+    // random access operations, not available with floats
+
+    Iterator& operator--() noexcept {
+      data.dec();
+      return *this;
+    }
+
+    Iterator operator--(int) noexcept {
+      auto ret = *this;
+      --*this;
+      return ret;
+    }
+
+    Iterator& operator+=(difference_type n) noexcept {
+      data.advance(n);
+      return *this;
+    }
+
+    Iterator& operator-=(difference_type n) noexcept {
+      data.advance(-n);
+      return *this;
+    }
+
+    friend Iterator operator+(Iterator it, difference_type n) noexcept {
+      return it += n;
+    }
+
+    friend Iterator operator+(difference_type n, Iterator it) noexcept {
+      return it += n;
+    }
+
+    friend Iterator operator-(Iterator it, difference_type n) noexcept {
+      return it -= n;
+    }
+
+    difference_type operator-(const Iterator& other) const noexcept {
+      return static_cast<difference_type>(data.index() - other.data.index());
+    }
+
+    T operator[](difference_type n) const noexcept {
+      return *(*this + n);
+    }
+
+    bool operator<(const Iterator& other) const noexcept {
+      return data.index() < other.data.index();
+    }
+
+    bool operator>(const Iterator& other) const noexcept {
+      return other < *this;
+    }
+
+    bool operator<=(const Iterator& other) const noexcept {
+      return !(other < *this);
+    }
+
+    bool operator>=(const Iterator& other) const noexcept {
+      return !(*this < other);
+    }
   };
 
   constexpr Iterator begin() const noexcept {
-    return {start_, step_, false};
+    if constexpr (std::is_floating_point_v<T>) {
+      return {{start_, step_}, false};
+    } else {
+      return {{start_, step_, 0}, false};
+    }
+  }
+
+  constexpr Iterator end() const noexcept {
+    if constexpr (std::is_floating_point_v<T>) {
+      return {{stop_, step_}, true};
+    } else {
+      return {{start_, step_, size()}, true};
+    }
+  }
+
+  std::reverse_iterator<Iterator> rbegin() const noexcept {
+    return std::reverse_iterator<Iterator>{end()};
+  }
+
+  std::reverse_iterator<Iterator> rend() const noexcept {
+    return std::reverse_iterator<Iterator>{begin()};
+  }
+};
+
+// A random access iterator over a sequence whose elements are computed from
+// their position, Owner[index].  The iterator refers back to the Owner.
+template <typename Owner>
+class iter::impl::IndexedIterator {
+ private:
+  const Owner* owner_{};
+  std::ptrdiff_t index_{};
+
+ public:
+  using iterator_category = std::random_access_iterator_tag;
+  using value_type = decltype(std::declval<const Owner&>()[std::size_t{}]);
+  using difference_type = std::ptrdiff_t;
+  using pointer = value_type*;
+  using reference = value_type;
+
+  constexpr IndexedIterator() noexcept = default;
+
+  constexpr IndexedIterator(const Owner* owner, std::ptrdiff_t index) noexcept
+      : owner_{owner}, index_{index} {}
+
+  constexpr value_type operator*() const {
+    return (*owner_)[static_cast<std::size_t>(index_)];
+  }
+
+  constexpr ArrowProxy<value_type> operator->() const {
+    return {**this};
+  }
+
+  IndexedIterator& operator++() noexcept {
+    ++index_;
+    return *this;
+  }
+
+  IndexedIterator operator++(int) noexcept {
+    auto ret = *this;
+    ++*this;
+    return ret;
+  }
+
+  IndexedIterator& operator--() noexcept {
+    --index_;
+    return *this;
+  }
+
+  IndexedIterator operator--(int) noexcept {
+    auto ret = *this;
+    --*this;
+    return ret;
+  }
+
+  IndexedIterator& operator+=(difference_type n) noexcept {
+    index_ += n;
+    return *this;
+  }
+
+  IndexedIterator& operator-=(difference_type n) noexcept {
+    index_ -= n;
+    return *this;
+  }
+
+  friend IndexedIterator operator+(
+      IndexedIterator it, difference_type n) noexcept {
+    return it += n;
+  }
+
+  friend IndexedIterator operator+(
+      difference_type n, IndexedIterator it) noexcept {
+    return it += n;
+  }
+
+  friend IndexedIterator operator-(
+      IndexedIterator it, difference_type n) noexcept {
+    return it -= n;
+  }
+
+  difference_type operator-(const IndexedIterator& other) const noexcept {
+    return index_ - other.index_;
+  }
+
+  value_type operator[](difference_type n) const {
+    return *(*this + n);
+  }
+
+  bool operator==(const IndexedIterator& other) const noexcept {
+    return index_ == other.index_;
+  }
+
+  bool operator!=(const IndexedIterator& other) const noexcept {
+    return !(*this == other);
+  }
+
+  bool operator<(const IndexedIterator& other) const noexcept {
+    return index_ < other.index_;
+  }
+
+  bool operator>(const IndexedIterator& other) const noexcept {
+    return other < *this;
+  }
+
+  bool operator<=(const IndexedIterator& other) const noexcept {
+    return !(other < *this);
+  }
+
+  bool operator>=(const IndexedIterator& other) const noexcept {
+    return !(*this < other);
+  }
+};
+
+// A random access sequence of the consecutive chunk_size sized pieces of
+// an integral Range.  Each chunk is itself a Range computed from its
+// position, so no elements are visited to form them.
+template <typename T>
+class iter::impl::RangeChunks {
+ private:
+  Range<T> range_;
+  std::size_t chunk_size_;
+
+  friend class Range<T>;
+
+  constexpr RangeChunks(Range<T> range, std::size_t chunk_size) noexcept
+      : range_{range}, chunk_size_{chunk_size} {}
+
+ public:
+  using Iterator = IndexedIterator<RangeChunks>;
+
+  constexpr std::size_t size() const noexcept {
+    if (chunk_size_ == 0) {
+      return 0;
+    }
+    const auto n = range_.size();
+    return n / chunk_size_ + (n % chunk_size_ != 0);
+  }
+
+  constexpr Range<T> operator[](std::size_t index) const noexcept {
+    const auto first = index * chunk_size_;
+    // saturates instead of wrapping, slice() clamps it to the size
+    const auto max = std::numeric_limits<std::size_t>::max();
+    const auto last = chunk_size_ < max - first ? first + chunk_size_ : max;
+    return range_.slice(first, last);
+  }
+
+  constexpr Iterator begin() const noexcept {
+    return {this, 0};
+  }
+
+  constexpr Iterator end() const noexcept {
+    return {this, static_cast<std::ptrdiff_t>(size())};
+  }
+};
+
+// N consecutive values of a sequence, stored contiguously so that a loop
+// over them can be vectorized.  The last block of a sequence may hold fewer
+// than N values, in which case the remaining lanes are value-initialized.
+template <typename T, std::size_t N>
+class iter::impl::ValueBlock {
+ private:
+  std::array<T, N> values_{};
+  std::size_t size_{};
+
+ public:
+  constexpr ValueBlock() noexcept = default;
+
+  template <typename Seq>
+  constexpr ValueBlock(const Seq& seq, std::size_t first, std::size_t count)
+      : size_{count} {
+    // separate loop for full blocks so the trip count is a constant
+    if (count == N) {
+      for (std::size_t i = 0; i < N; ++i) {
+        values_[i] = seq[first + i];
+      }
+    } else {
+      for (std::size_t i = 0; i < count; ++i) {
+        values_[i] = seq[first + i];
+      }
+    }
+  }
+
+  static constexpr std::size_t lanes() noexcept {
+    return N;
+  }
+
+  constexpr std::size_t size() const noexcept {
+    return size_;
+  }
+
+  constexpr bool full() const noexcept {
+    return size_ == N;
+  }
+
+  constexpr const T* data() const noexcept {
+    return values_.data();
+  }
+
+  constexpr const T& operator[](std::size_t index) const noexcept {
+    return values_[index];
+  }
+
+  constexpr const T* begin() const noexcept {
+    return data();
+  }
+
+  constexpr const T* end() const noexcept {
+    return data() + size_;
+  }
+};
+
+// A random access sequence of the ValueBlocks of N consecutive values of
+// Seq, which must have size() and an operator[] taking a position.
+template <typename Seq, std::size_t N>
+class iter::impl::Blocked {
+ private:
+  static_assert(N > 0, "blocks must have at least one lane");
+  using T = std::remove_cv_t<std::remove_reference_t<decltype(
+      std::declval<const Seq&>()[std::size_t{}])>>;
+
+  Seq seq_;
+  std::size_t seq_size_;
+
+ public:
+  using Iterator = IndexedIterator<Blocked>;
+
+  constexpr Blocked(Seq seq) noexcept
+      : seq_{seq}, seq_size_{seq_.size()} {}
+
+  constexpr std::size_t size() const noexcept {
+    return seq_size_ / N + (seq_size_ % N != 0);
+  }
+
+  constexpr ValueBlock<T, N> operator[](std::size_t index) const {
+    const auto first = index * N;
+    const auto remaining = seq_size_ - first;
+    return {seq_, first, remaining < N ? remaining : N};
+  }
+
+  constexpr Iterator begin() const noexcept {
+    return {this, 0};
   }
 
   constexpr Iterator end() const noexcept {
-    return {stop_, step_, true};
+    return {this, static_cast<std::ptrdiff_t>(size())};
   }
 };
 
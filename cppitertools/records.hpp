@@ -0,0 +1,79 @@
+#ifndef ITER_RECORDS_HPP_
+#define ITER_RECORDS_HPP_
+
+#include "internal/mapped_file.hpp"
+
+#include <cstddef>
+#include <string>
+#include <system_error>
+#include <type_traits>
+
+namespace iter {
+  namespace impl {
+    template <typename T>
+    class Records;
+  }
+  template <typename T>
+  impl::Records<T> records(const std::string& path);
+}
+
+// A file of fixed size binary records, seen as an array of const T which
+// refers directly to the file's contents.  Any bytes after the last whole
+// record are ignored.  The references stay valid while the Records object
+// is alive, including after it has been moved.
+template <typename T>
+class iter::impl::Records {
+ private:
+  static_assert(std::is_trivially_copyable_v<T>,
+      "records requires a trivially copyable type");
+  static_assert(alignof(T) <= alignof(std::max_align_t),
+      "records requires a type with at most fundamental alignment");
+
+  MappedFile file_;
+
+  friend Records iter::records<T>(const std::string&);
+
+  Records(const std::string& path) : file_(path) {}
+
+ public:
+  Records(Records&&) = default;
+
+  using iterator = const T*;
+  using value_type = T;
+
+  const T* data() const {
+    return reinterpret_cast<const T*>(file_.data());
+  }
+
+  std::size_t size() const {
+    return file_.size() / sizeof(T);
+  }
+
+  bool empty() const {
+    return size() == 0;
+  }
+
+  const T* begin() const {
+    return data();
+  }
+
+  const T* end() const {
+    return data() + size();
+  }
+
+  const T& operator[](std::size_t i) const {
+    return data()[i];
+  }
+
+  // set if the file couldn't be read, in which case there are no records
+  const std::error_code& error() const {
+    return file_.error();
+  }
+};
+
+template <typename T>
+iter::impl::Records<T> iter::records(const std::string& path) {
+  return {path};
+}
+
+#endif
@@ -1,6 +1,8 @@
 #ifndef ITER_REPEAT_HPP_
 #define ITER_REPEAT_HPP_
 
+#include "internal/iterbase.hpp"
+
 #include <iterator>
 #include <type_traits>
 #include <utility>
@@ -91,6 +93,10 @@ class iter::impl::RepeaterWithCount {
   constexpr Iterator rend() const {
     return end();
   }
+
+  constexpr SizeHint size_hint() const noexcept {
+    return size_hints::exactly(static_cast<std::size_t>(this->count_));
+  }
 };
 
 template <typename T>
@@ -175,6 +181,10 @@ class iter::impl::Repeater {
   constexpr Iterator rend() const {
     return end();
   }
+
+  constexpr SizeHint size_hint() const noexcept {
+    return size_hints::infinite();
+  }
 };
 
 template <typename T>
@@ -3,6 +3,7 @@
 
 #include "internal/iterator_wrapper.hpp"
 #include "internal/iterbase.hpp"
+#include "range.hpp"
 
 #include <iterator>
 #include <utility>
@@ -43,9 +44,8 @@ namespace iter {
     template <typename Container>
     class Reverser;
 
-    using ReversedFn = IterToolFn<Reverser>;
+    struct ReversedFn;
   }
-  inline constexpr impl::ReversedFn reversed{};
 }
 
 template <typename Container>
@@ -132,6 +132,30 @@ class iter::impl::Reverser {
   Iterator<AsConst<Container>> end() const {
     return {std::rend(std::as_const(container_))};
   }
+
+  SizeHint size_hint() const {
+    return size_hint_of(std::as_const(container_));
+  }
 };
 
+// reversing a signed integral range produces another range directly
+struct iter::impl::ReversedFn : Pipeable<ReversedFn> {
+  template <typename Container>
+  auto operator()(Container&& container) const {
+    if constexpr (is_integral_range<Container>) {
+      if constexpr (std::is_signed_v<decltype(container.start())>) {
+        return container.reversed();
+      } else {
+        return Reverser<Container>{std::forward<Container>(container)};
+      }
+    } else {
+      return Reverser<Container>{std::forward<Container>(container)};
+    }
+  }
+};
+
+namespace iter {
+  inline constexpr impl::ReversedFn reversed{};
+}
+
 #endif
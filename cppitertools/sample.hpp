@@ -0,0 +1,433 @@
+#ifndef ITER_SAMPLE_HPP_
+#define ITER_SAMPLE_HPP_
+
+#include "internal/iterator_wrapper.hpp"
+#include "internal/iteratoriterator.hpp"
+#include "internal/iterbase.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <random>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace iter {
+  namespace impl {
+    template <typename Container, typename Rng>
+    class Sampled;
+
+    template <typename Container, typename Rng>
+    class RateSampled;
+
+    struct SampleFn;
+    struct SampleRateFn;
+
+    // an engine passed as an lvalue is used in place, so that it keeps
+    // advancing from one sample to the next, and one passed as an rvalue is
+    // owned
+    template <typename Rng>
+    class RngHolder {
+     private:
+      mutable Rng rng_;
+
+     public:
+      RngHolder(Rng&& rng) : rng_(std::move(rng)) {}
+      Rng& get() const {
+        return rng_;
+      }
+    };
+
+    template <typename Rng>
+    class RngHolder<Rng&> {
+     private:
+      Rng& rng_;
+
+     public:
+      RngHolder(Rng& rng) : rng_(rng) {}
+      Rng& get() const {
+        return rng_;
+      }
+    };
+
+    // uniform on (0, 1), so that its log is finite
+    template <typename Rng>
+    double open_unit(Rng& rng) {
+      double u;
+      do {
+        u = std::generate_canonical<double,
+            std::numeric_limits<double>::digits>(rng);
+      } while (u == 0.0);
+      return u;
+    }
+
+    // the number of failed trials before the first success, when each
+    // succeeds with probability p, drawn with one random number.  Saturates
+    // at the largest std::size_t, which is as good as never.
+    template <typename Rng>
+    std::size_t geometric_gap(double p, Rng& rng) {
+      constexpr auto never = std::numeric_limits<std::size_t>::max();
+      if (p >= 1.0) {
+        return 0;
+      }
+      if (!(p > 0.0)) {
+        return never;
+      }
+      double gap = std::floor(std::log(open_unit(rng)) / std::log1p(-p));
+      return gap < static_cast<double>(never) ? static_cast<std::size_t>(gap)
+                                               : never;
+    }
+  }
+}
+
+// Yields a uniformly random sample of k elements of the iterable, or all of
+// them if there are fewer.  The sample is drawn on the first call to begin()
+// with reservoir sampling's Algorithm L, which chooses how many elements to
+// skip before the next one to keep, so it takes O(k(1 + log(n/k))) random
+// numbers rather than one per element.  The skipped elements aren't
+// dereferenced, and random access iterators jump over them.  Later calls,
+// const or not, reuse the sample.
+//
+// When the iterable's references stay valid, the sample is the positions
+// of the chosen elements, and each kind of iteration finds its iterators
+// to them with one more pass, in the iterable's order.  Otherwise the
+// chosen elements are copied, and both kinds of iteration yield the copies.
+template <typename Container, typename Rng>
+class iter::impl::Sampled {
+ private:
+  using Arg = iterator_deref<Container>;
+  static constexpr bool KeepsRefs =
+      std::is_lvalue_reference_v<Arg>
+      && is_iterator_at_least<iterator_type<Container>,
+          std::forward_iterator_tag>;
+  using Value = std::remove_cv_t<std::remove_reference_t<Arg>>;
+  using Chosen = std::conditional_t<KeepsRefs, std::size_t, Value>;
+
+  template <typename ContainerT>
+  using Refs = IterIterWrapper<std::vector<iterator_type<ContainerT>>>;
+
+  // iterators for const iteration are only named if it could be done
+  using ConstContainer = std::conditional_t<is_iterable<AsConst<Container>>,
+      AsConst<Container>, Container>;
+
+  Container container_;
+  std::size_t k_;
+  RngHolder<Rng> rng_;
+  mutable std::optional<std::vector<Chosen>> sample_;
+  std::optional<Refs<Container>> refs_;
+  mutable std::optional<Refs<ConstContainer>> const_refs_;
+
+  friend SampleFn;
+
+  Sampled(Container&& container, std::size_t k, Rng&& rng)
+      : container_(std::forward<Container>(container)),
+        k_{k},
+        rng_(std::forward<Rng>(rng)) {}
+
+  // the position of the element at it, or a copy of it
+  template <typename Iter>
+  static Chosen choose(std::size_t n, Iter& it) {
+    if constexpr (KeepsRefs) {
+      return n;
+    } else {
+      return Value(*it);
+    }
+  }
+
+  template <typename ContainerT>
+  std::vector<Chosen> draw(ContainerT& container) const {
+    std::vector<Chosen> chosen;
+    auto it = get_begin(container);
+    auto end = get_end(container);
+    std::size_t n = 0;
+    for (; n < k_ && it != end; ++it, ++n) {
+      chosen.push_back(choose(n, it));
+    }
+    if (n < k_ || k_ == 0) {
+      return chosen;
+    }
+    auto& rng = rng_.get();
+    std::uniform_int_distribution<std::size_t> slot(0, k_ - 1);
+    double kd = static_cast<double>(k_);
+    double w = std::exp(std::log(open_unit(rng)) / kd);
+    for (;;) {
+      auto gap = geometric_gap(w, rng);
+      dumb_advance(it, end, gap);
+      if (!(it != end)) {
+        break;
+      }
+      n += gap;
+      chosen[slot(rng)] = choose(n, it);
+      ++it;
+      ++n;
+      w *= std::exp(std::log(open_unit(rng)) / kd);
+    }
+    if constexpr (KeepsRefs) {
+      std::sort(std::begin(chosen), std::end(chosen));
+    }
+    return chosen;
+  }
+
+  // iterators to the elements at the sorted positions, in one pass
+  template <typename ContainerT>
+  static Refs<ContainerT> find(
+      ContainerT& container, const std::vector<std::size_t>& positions) {
+    Refs<ContainerT> refs;
+    refs.get().reserve(positions.size());
+    auto it = get_begin(container);
+    auto end = get_end(container);
+    std::size_t n = 0;
+    for (auto pos : positions) {
+      dumb_advance(it, end, pos - n);
+      n = pos;
+      refs.get().push_back(it);
+    }
+    return refs;
+  }
+
+  std::vector<Chosen>& sample() {
+    if (!sample_) {
+      sample_.emplace(draw(container_));
+    }
+    return *sample_;
+  }
+
+  const std::vector<Chosen>& sample() const {
+    if (!sample_) {
+      sample_.emplace(draw(std::as_const(container_)));
+    }
+    return *sample_;
+  }
+
+  auto& items() {
+    if constexpr (KeepsRefs) {
+      if (!refs_) {
+        refs_.emplace(find(container_, sample()));
+      }
+      return *refs_;
+    } else {
+      return sample();
+    }
+  }
+
+  auto& items() const {
+    if constexpr (KeepsRefs) {
+      if (!const_refs_) {
+        const_refs_.emplace(find(std::as_const(container_), sample()));
+      }
+      return *const_refs_;
+    } else {
+      return sample();
+    }
+  }
+
+ public:
+  Sampled(Sampled&&) = default;
+
+  auto begin() {
+    return get_begin(items());
+  }
+
+  auto end() {
+    return get_end(items());
+  }
+
+  auto begin() const {
+    return get_begin(items());
+  }
+
+  auto end() const {
+    return get_end(items());
+  }
+
+  SizeHint size_hint() const {
+    return size_hints::min(
+        size_hint_of(std::as_const(container_)), size_hints::exactly(k_));
+  }
+};
+
+// Yields each element of the iterable independently with probability p.
+// Rather than a random number for each element, the gap to the next one
+// yielded is drawn from the geometric distribution, so sampling 1% of the
+// iterable takes about one random number per element yielded.  The
+// skipped elements aren't dereferenced, and random access iterators jump
+// over them.  Each call to begin() draws a new sample.
+template <typename Container, typename Rng>
+class iter::impl::RateSampled {
+ private:
+  Container container_;
+  double p_;
+  RngHolder<Rng> rng_;
+
+  friend SampleRateFn;
+
+  RateSampled(Container&& container, double p, Rng&& rng)
+      : container_(std::forward<Container>(container)),
+        p_{p},
+        rng_(std::forward<Rng>(rng)) {}
+
+  using RngT = std::remove_reference_t<Rng>;
+
+ public:
+  RateSampled(RateSampled&&) = default;
+
+  template <typename ContainerT>
+  class Iterator {
+   private:
+    template <typename>
+    friend class Iterator;
+    IteratorWrapper<ContainerT> sub_iter_;
+    IteratorWrapper<ContainerT> sub_end_;
+    double p_;
+    RngT* rng_;
+
+    void skip() {
+      if (sub_iter_ != sub_end_) {
+        dumb_advance(sub_iter_, sub_end_, geometric_gap(p_, *rng_));
+      }
+    }
+
+   public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = iterator_traits_deref<ContainerT>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = value_type*;
+    using reference = iterator_deref<ContainerT>;
+
+    Iterator(IteratorWrapper<ContainerT>&& sub_iter,
+        IteratorWrapper<ContainerT>&& sub_end, double p, RngT& rng)
+        : sub_iter_{std::move(sub_iter)},
+          sub_end_{std::move(sub_end)},
+          p_{p},
+          rng_{&rng} {
+      skip();
+    }
+
+    iterator_deref<ContainerT> operator*() {
+      return *sub_iter_;
+    }
+
+    iterator_arrow<ContainerT> operator->() {
+      return apply_arrow(sub_iter_);
+    }
+
+    Iterator& operator++() {
+      ++sub_iter_;
+      skip();
+      return *this;
+    }
+
+    Iterator operator++(int) {
+      auto ret = *this;
+      ++*this;
+      return ret;
+    }
+
+    template <typename T>
+    bool operator!=(const Iterator<T>& other) const {
+      return sub_iter_ != other.sub_iter_;
+    }
+
+    template <typename T>
+    bool operator==(const Iterator<T>& other) const {
+      return !(*this != other);
+    }
+  };
+
+  Iterator<Container> begin() {
+    return {get_begin(container_), get_end(container_), p_, rng_.get()};
+  }
+
+  Iterator<Container> end() {
+    return {get_end(container_), get_end(container_), p_, rng_.get()};
+  }
+
+  Iterator<AsConst<Container>> begin() const {
+    return {get_begin(std::as_const(container_)),
+        get_end(std::as_const(container_)), p_, rng_.get()};
+  }
+
+  Iterator<AsConst<Container>> end() const {
+    return {get_end(std::as_const(container_)),
+        get_end(std::as_const(container_)), p_, rng_.get()};
+  }
+
+  SizeHint size_hint() const {
+    return size_hints::at_most(size_hint_of(std::as_const(container_)));
+  }
+};
+
+// sample(container, k, rng), or container | sample(k, rng)
+struct iter::impl::SampleFn {
+ private:
+  template <typename Rng>
+  struct FnPartial : Pipeable<FnPartial<Rng>> {
+    std::size_t k;
+    Rng rng;
+
+    template <typename Container>
+    Sampled<Container, Rng> operator()(Container&& container) const& {
+      return {std::forward<Container>(container), k, static_cast<Rng>(rng)};
+    }
+
+    template <typename Container>
+    Sampled<Container, Rng> operator()(Container&& container) && {
+      return {std::forward<Container>(container), k, std::forward<Rng>(rng)};
+    }
+  };
+
+ public:
+  template <typename Container, typename Rng>
+  Sampled<Container, Rng> operator()(
+      Container&& container, std::size_t k, Rng&& rng) const {
+    return {std::forward<Container>(container), k, std::forward<Rng>(rng)};
+  }
+
+  template <typename Rng>
+  FnPartial<Rng> operator()(std::size_t k, Rng&& rng) const {
+    return {{}, k, std::forward<Rng>(rng)};
+  }
+};
+
+// sample_rate(container, p, rng), or container | sample_rate(p, rng)
+struct iter::impl::SampleRateFn {
+ private:
+  template <typename Rng>
+  struct FnPartial : Pipeable<FnPartial<Rng>> {
+    double p;
+    Rng rng;
+
+    template <typename Container>
+    RateSampled<Container, Rng> operator()(Container&& container) const& {
+      return {std::forward<Container>(container), p, static_cast<Rng>(rng)};
+    }
+
+    template <typename Container>
+    RateSampled<Container, Rng> operator()(Container&& container) && {
+      return {std::forward<Container>(container), p, std::forward<Rng>(rng)};
+    }
+  };
+
+ public:
+  template <typename Container, typename Rng>
+  RateSampled<Container, Rng> operator()(
+      Container&& container, double p, Rng&& rng) const {
+    return {std::forward<Container>(container), p, std::forward<Rng>(rng)};
+  }
+
+  template <typename Rng>
+  FnPartial<Rng> operator()(double p, Rng&& rng) const {
+    return {{}, p, std::forward<Rng>(rng)};
+  }
+};
+
+namespace iter {
+  inline constexpr impl::SampleFn sample{};
+  inline constexpr impl::SampleRateFn sample_rate{};
+}
+
+#endif
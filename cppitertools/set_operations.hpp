@@ -0,0 +1,745 @@
+#ifndef ITER_SET_OPERATIONS_HPP_
+#define ITER_SET_OPERATIONS_HPP_
+
+#include "internal/iter_tuples.hpp"
+#include "internal/iterator_wrapper.hpp"
+#include "internal/iterbase.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace iter {
+  namespace impl {
+    enum class SetOp { Intersection, Union, Difference, SymmetricDifference };
+
+    template <SetOp Op, typename Deref, typename CompareFunc,
+        bool SinglePass>
+    class SetRuns;
+
+    template <SetOp Op, typename CompareFunc, typename TupType,
+        std::size_t... Is>
+    class SetCombined;
+
+    template <SetOp Op, typename CompareFunc, typename Container>
+    class SetCombinedFromIterable;
+
+    template <SetOp Op>
+    struct SetFromIterable {
+      template <typename CompareFunc, typename Container>
+      using type = SetCombinedFromIterable<Op, CompareFunc, Container>;
+    };
+
+    template <SetOp Op>
+    using SetFromIterableFn =
+        IterToolFnOptionalBindFirst<SetFromIterable<Op>::template type,
+            std::less<>>;
+
+    // like MergeMaker, a callable object so that from_iterable can be used
+    template <SetOp Op>
+    class SetOpMaker;
+
+    // moves it to the first element which doesn't come before key
+    template <typename Iter, typename EndIter, typename Key,
+        typename CompareFunc>
+    void seek_sorted(
+        Iter& it, const EndIter& end, const Key& key, CompareFunc& compare) {
+      auto before = [&key, &compare](auto&& item) -> bool {
+        return std::invoke(compare, item, key);
+      };
+      if constexpr (is_random_access_iter<Iter>{}
+                    && std::is_same_v<Iter, EndIter>) {
+        it = gallop_partition_point(it, end, before);
+      } else {
+        while (it != end && before(*it)) {
+          ++it;
+        }
+      }
+    }
+
+    // the number of elements from it on which are equivalent to key, given
+    // that none of them come before it
+    template <typename Iter, typename EndIter, typename Key,
+        typename CompareFunc>
+    std::size_t sorted_run_length(const Iter& it, const EndIter& end,
+        const Key& key, CompareFunc& compare) {
+      auto same = [&key, &compare](auto&& item) -> bool {
+        return !std::invoke(compare, key, item);
+      };
+      if constexpr (is_random_access_iter<Iter>{}
+                    && std::is_same_v<Iter, EndIter>) {
+        return static_cast<std::size_t>(
+            gallop_partition_point(it, end, same) - it);
+      } else {
+        std::size_t n = 0;
+        for (auto cur = it; cur != end && same(*cur); ++cur) {
+          ++n;
+        }
+        return n;
+      }
+    }
+
+    // true if a copy of Iter can walk the same elements again
+    template <typename Iter>
+    struct IsMultiPass
+        : std::bool_constant<
+              is_iterator_at_least<Iter, std::forward_iterator_tag>> {};
+
+    template <typename SubIter, typename SubEnd>
+    struct IsMultiPass<IteratorWrapperImpl<SubIter, SubEnd>>
+        : IsMultiPass<SubIter> {};
+  }
+}
+
+// Walks k sorted sources a run of equivalent elements at a time, and works
+// out how many copies of each run to yield.  A source is reached through
+// sources.visit(i, f), which calls f(iterator, end) on source i.
+//
+// The copies are the ones the std:: set algorithms would yield if applied
+// from left to right: an intersection yields the first of the first
+// source's run, a difference the last of them, and a union the first
+// source's run followed by the last elements of each later source's run
+// which is longer than all before it.  A symmetric difference of a run
+// with a source's run leaves the last elements of the longer of the two.
+//
+// With random access sources, runs are measured and sources moved forward
+// with a galloping search, so an intersection of a short source with long
+// ones costs about log(long / short) comparisons per element of the short
+// one.  Sources which can only be walked once are read an element at a
+// time into a copy, and a run of them is measured by copying it into a
+// buffer.  If any source is like that, the key and the element yielded are
+// copies as well.
+template <iter::impl::SetOp Op, typename Deref, typename CompareFunc,
+    bool SinglePass>
+class iter::impl::SetRuns {
+ private:
+  using Value = std::remove_cv_t<std::remove_reference_t<Deref>>;
+  using Holder = DerefHolder<std::conditional_t<SinglePass, Value, Deref>>;
+
+  template <typename Iter>
+  static constexpr bool single_pass = !IsMultiPass<std::decay_t<Iter>>{};
+
+  // the element each single pass source is at, and its part of the
+  // current run
+  struct Buffers {
+    std::vector<std::optional<Value>> heads;
+    std::vector<std::vector<Value>> runs;
+  };
+  struct NoBuffers {};
+
+  CompareFunc* compare_func_;
+  // the length of the current run in each source, and how far along it
+  // each source has moved
+  std::vector<std::size_t> counts_;
+  std::vector<std::size_t> taken_;
+  std::conditional_t<SinglePass, Buffers, NoBuffers> buffers_;
+  std::size_t copies_{0};
+  std::size_t copy_{0};
+  std::size_t source_{0};
+  Holder key_;
+  Holder item_;
+  bool done_{false};
+
+  // reads the element a single pass source is at, if it hasn't been yet
+  template <typename Iter, typename EndIter>
+  bool fill(std::size_t i, Iter& it, EndIter& end) {
+    auto& head = buffers_.heads[i];
+    if (!head && it != end) {
+      head.emplace(*it);
+      ++it;
+    }
+    return head.has_value();
+  }
+
+  template <typename Iter, typename EndIter>
+  decltype(auto) head(std::size_t i, Iter& it, EndIter& end) {
+    if constexpr (single_pass<Iter>) {
+      fill(i, it, end);
+      return *buffers_.heads[i];
+    } else {
+      return *it;
+    }
+  }
+
+  template <typename T>
+  void hold(Holder& holder, T&& item) {
+    if constexpr (SinglePass) {
+      holder.reset(Value(std::forward<T>(item)));
+    } else {
+      holder.reset(std::forward<T>(item));
+    }
+  }
+
+  template <typename Sources>
+  bool at_end(Sources& sources, std::size_t i) {
+    return sources.visit(i, [this, i](auto& it, auto& end) -> bool {
+      if constexpr (single_pass<decltype(it)>) {
+        return !fill(i, it, end);
+      } else {
+        return !(it != end);
+      }
+    });
+  }
+
+  template <typename Sources>
+  void load_key(Sources& sources, std::size_t i) {
+    sources.visit(i, [this, i](auto& it, auto& end) -> bool {
+      hold(key_, head(i, it, end));
+      return true;
+    });
+  }
+
+  // true if source i's element comes after the key
+  template <typename Sources>
+  bool after_key(Sources& sources, std::size_t i) {
+    return sources.visit(i, [this, i](auto& it, auto& end) -> bool {
+      return std::invoke(*compare_func_, key_.get(), head(i, it, end));
+    });
+  }
+
+  template <typename Sources>
+  bool before_key(Sources& sources, std::size_t i) {
+    return sources.visit(i, [this, i](auto& it, auto& end) -> bool {
+      return std::invoke(*compare_func_, head(i, it, end), key_.get());
+    });
+  }
+
+  template <typename Sources>
+  void seek(Sources& sources, std::size_t i) {
+    sources.visit(i, [this, i](auto& it, auto& end) -> bool {
+      if constexpr (single_pass<decltype(it)>) {
+        auto& head = buffers_.heads[i];
+        while (fill(i, it, end)
+               && std::invoke(*compare_func_, *head, key_.get())) {
+          head.reset();
+        }
+      } else {
+        seek_sorted(it, end, key_.get(), *compare_func_);
+      }
+      return true;
+    });
+  }
+
+  template <typename Sources>
+  std::size_t run_length(Sources& sources, std::size_t i) {
+    return sources.visit(i, [this, i](auto& it, auto& end) -> std::size_t {
+      if constexpr (single_pass<decltype(it)>) {
+        auto& head = buffers_.heads[i];
+        auto& run = buffers_.runs[i];
+        run.clear();
+        while (fill(i, it, end)
+               && !std::invoke(*compare_func_, key_.get(), *head)) {
+          run.push_back(std::move(*head));
+          head.reset();
+        }
+        return run.size();
+      } else {
+        return sorted_run_length(it, end, key_.get(), *compare_func_);
+      }
+    });
+  }
+
+  // moves source i n elements further along the current run
+  template <typename Sources>
+  void skip(Sources& sources, std::size_t i, std::size_t n) {
+    sources.visit(i, [n](auto& it, auto&) -> bool {
+      if constexpr (single_pass<decltype(it)>) {
+        // the run has already been read
+      } else if constexpr (is_random_access_iter<
+                               std::decay_t<decltype(it)>>{}) {
+        it += static_cast<std::ptrdiff_t>(n);
+      } else {
+        dumb_advance_unsafe(it, n);
+      }
+      return true;
+    });
+  }
+
+  template <typename Sources>
+  void load_item(Sources& sources, std::size_t i) {
+    sources.visit(i, [this, i](auto& it, auto&) -> bool {
+      if constexpr (single_pass<decltype(it)>) {
+        item_.reset(std::move(buffers_.runs[i][taken_[i]]));
+      } else {
+        hold(item_, *it);
+      }
+      return true;
+    });
+  }
+
+  // Chooses the next key and measures its run in every source, or returns
+  // false if there are no more.  Intersections leapfrog: each source is
+  // moved up to the greatest element seen so far, until they all agree.
+  template <typename Sources>
+  bool pick_key(Sources& sources) {
+    const auto k = counts_.size();
+    if (k == 0) {
+      return false;
+    }
+    if constexpr (Op == SetOp::Intersection) {
+      for (std::size_t i = 0; i < k; ++i) {
+        if (at_end(sources, i)) {
+          return false;
+        }
+      }
+      load_key(sources, 0);
+      for (bool agreed = false; !agreed;) {
+        agreed = true;
+        for (std::size_t i = 0; i < k; ++i) {
+          seek(sources, i);
+          if (at_end(sources, i)) {
+            return false;
+          }
+          if (after_key(sources, i)) {
+            load_key(sources, i);
+            agreed = false;
+          }
+        }
+      }
+    } else if constexpr (Op == SetOp::Difference) {
+      if (at_end(sources, 0)) {
+        return false;
+      }
+      load_key(sources, 0);
+      for (std::size_t i = 1; i < k; ++i) {
+        seek(sources, i);
+      }
+    } else {
+      key_.reset();
+      for (std::size_t i = 0; i < k; ++i) {
+        if (!at_end(sources, i) && (!key_ || before_key(sources, i))) {
+          load_key(sources, i);
+        }
+      }
+      if (!key_) {
+        return false;
+      }
+    }
+    for (std::size_t i = 0; i < k; ++i) {
+      counts_[i] = at_end(sources, i) ? 0 : run_length(sources, i);
+    }
+    return true;
+  }
+
+  // sets copies_, and source_ to the source the first copy comes from
+  void count_copies() {
+    source_ = 0;
+    if constexpr (Op == SetOp::Intersection) {
+      copies_ = *std::min_element(counts_.begin(), counts_.end());
+    } else if constexpr (Op == SetOp::Union) {
+      copies_ = *std::max_element(counts_.begin(), counts_.end());
+    } else if constexpr (Op == SetOp::Difference) {
+      copies_ = counts_[0];
+      for (std::size_t i = 1; i < counts_.size() && copies_ > 0; ++i) {
+        copies_ -= std::min(copies_, counts_[i]);
+      }
+    } else {
+      copies_ = counts_[0];
+      for (std::size_t i = 1; i < counts_.size(); ++i) {
+        if (counts_[i] > copies_) {
+          copies_ = counts_[i] - copies_;
+          source_ = i;
+        } else {
+          copies_ -= counts_[i];
+        }
+      }
+    }
+  }
+
+  template <typename Sources>
+  void finish_run(Sources& sources) {
+    for (std::size_t i = 0; i < counts_.size(); ++i) {
+      skip(sources, i, counts_[i] - taken_[i]);
+      taken_[i] = 0;
+    }
+  }
+
+  // moves to the element of copy_ and loads it
+  template <typename Sources>
+  void load_copy(Sources& sources) {
+    auto index = copy_;
+    if constexpr (Op == SetOp::Union) {
+      while (counts_[source_] <= copy_) {
+        ++source_;
+      }
+    } else if constexpr (Op != SetOp::Intersection) {
+      index += counts_[source_] - copies_;
+    }
+    skip(sources, source_, index - taken_[source_]);
+    taken_[source_] = index;
+    load_item(sources, source_);
+  }
+
+  template <typename Sources>
+  void find_run(Sources& sources) {
+    while (pick_key(sources)) {
+      count_copies();
+      if (copies_ > 0) {
+        copy_ = 0;
+        load_copy(sources);
+        return;
+      }
+      finish_run(sources);
+    }
+    done_ = true;
+  }
+
+ public:
+  using reference = typename Holder::reference;
+  using pointer = typename Holder::pointer;
+
+  SetRuns(std::size_t num_sources, CompareFunc& compare_func)
+      : compare_func_(&compare_func),
+        counts_(num_sources),
+        taken_(num_sources) {
+    if constexpr (SinglePass) {
+      buffers_.heads.resize(num_sources);
+      buffers_.runs.resize(num_sources);
+    }
+  }
+
+  template <typename Sources>
+  void start(Sources& sources) {
+    find_run(sources);
+  }
+
+  template <typename Sources>
+  void next(Sources& sources) {
+    skip(sources, source_, 1);
+    ++taken_[source_];
+    ++copy_;
+    if (copy_ < copies_) {
+      load_copy(sources);
+    } else {
+      finish_run(sources);
+      find_run(sources);
+    }
+  }
+
+  bool done() const {
+    return done_;
+  }
+
+  reference get() {
+    return item_.get();
+  }
+
+  pointer get_ptr() {
+    return item_.get_ptr();
+  }
+};
+
+template <iter::impl::SetOp Op, typename CompareFunc, typename TupType,
+    std::size_t... Is>
+class iter::impl::SetCombined {
+ private:
+  static_assert(sizeof...(Is) > 0, "set operations require an iterable");
+  friend SetOpMaker<Op>;
+
+  TupType tup_;
+  mutable CompareFunc compare_func_;
+
+  SetCombined(CompareFunc compare_func, TupType&& t)
+      : tup_(std::move(t)), compare_func_(std::move(compare_func)) {}
+
+ public:
+  SetCombined(SetCombined&&) = default;
+
+  template <typename TupTypeT>
+  class Iterator {
+   private:
+    template <typename>
+    friend class Iterator;
+    template <SetOp, typename, typename, bool>
+    friend class SetRuns;
+
+    static_assert(
+        are_same<iterator_deref<std::tuple_element_t<Is, TupTypeT>>...>::value,
+        "All iterables given to a set operation must have iterators that "
+        "dereference to the same type, including cv-qualifiers "
+        "and references.");
+
+    using IterTupType = iterator_tuple_type<TupTypeT>;
+    using Deref = iterator_deref<std::tuple_element_t<0, TupTypeT>>;
+    using Runs = SetRuns<Op, Deref, CompareFunc,
+        !(... && IsMultiPass<std::tuple_element_t<Is, IterTupType>>{})>;
+
+    IterTupType iters_;
+    IterTupType ends_;
+    Runs runs_;
+
+    // the iterators are different types, so find source i's by comparing
+    // against each index
+    template <typename F>
+    auto visit(std::size_t i, F f) {
+      decltype(f(std::get<0>(iters_), std::get<0>(ends_))) result{};
+      (..., (i == Is ? void(result = f(std::get<Is>(iters_),
+                                    std::get<Is>(ends_)))
+                     : void()));
+      return result;
+    }
+
+   public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = iterator_traits_deref<std::tuple_element_t<0, TupTypeT>>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = typename Runs::pointer;
+    using reference = typename Runs::reference;
+
+    Iterator(IterTupType&& iters, IterTupType&& ends, CompareFunc& compare_func)
+        : iters_(std::move(iters)),
+          ends_(std::move(ends)),
+          runs_(sizeof...(Is), compare_func) {
+      runs_.start(*this);
+    }
+
+    reference operator*() {
+      return runs_.get();
+    }
+
+    pointer operator->() {
+      return runs_.get_ptr();
+    }
+
+    Iterator& operator++() {
+      runs_.next(*this);
+      return *this;
+    }
+
+    Iterator operator++(int) {
+      auto ret = *this;
+      ++*this;
+      return ret;
+    }
+
+    template <typename T>
+    bool operator!=(const Iterator<T>& other) const {
+      if (runs_.done() || other.runs_.done()) {
+        return runs_.done() != other.runs_.done();
+      }
+      return (... || (std::get<Is>(iters_) != std::get<Is>(other.iters_)));
+    }
+
+    template <typename T>
+    bool operator==(const Iterator<T>& other) const {
+      return !(*this != other);
+    }
+  };
+
+  Iterator<TupType> begin() {
+    return {{get_begin(std::get<Is>(tup_))...},
+        {get_end(std::get<Is>(tup_))...}, compare_func_};
+  }
+
+  Iterator<TupType> end() {
+    return {{get_end(std::get<Is>(tup_))...},
+        {get_end(std::get<Is>(tup_))...}, compare_func_};
+  }
+
+  Iterator<AsTupleOfConst<TupType>> begin() const {
+    return {{get_begin(std::as_const(std::get<Is>(tup_)))...},
+        {get_end(std::as_const(std::get<Is>(tup_)))...}, compare_func_};
+  }
+
+  Iterator<AsTupleOfConst<TupType>> end() const {
+    return {{get_end(std::as_const(std::get<Is>(tup_)))...},
+        {get_end(std::as_const(std::get<Is>(tup_)))...}, compare_func_};
+  }
+
+  // the bounds of the std:: set algorithms, extended to k sources
+  SizeHint size_hint() const {
+    SizeHint hints[] = {size_hint_of(std::as_const(std::get<Is>(tup_)))...};
+    auto total = size_hints::exactly(0);
+    auto longest = size_hints::exactly(0);
+    auto shortest = size_hints::infinite();
+    for (const auto& hint : hints) {
+      total = size_hints::sum(total, hint);
+      longest = size_hints::max(longest, hint);
+      shortest = size_hints::min(shortest, hint);
+    }
+    if constexpr (Op == SetOp::Intersection) {
+      return size_hints::at_most(shortest);
+    } else if constexpr (Op == SetOp::Union) {
+      return {longest.lower, total.upper};
+    } else if constexpr (Op == SetOp::Difference) {
+      return size_hints::at_most(hints[0]);
+    } else {
+      return size_hints::at_most(total);
+    }
+  }
+};
+
+template <iter::impl::SetOp Op, typename CompareFunc, typename Container>
+class iter::impl::SetCombinedFromIterable {
+ private:
+  friend SetFromIterableFn<Op>;
+
+  Container container_;
+  mutable CompareFunc compare_func_;
+
+  SetCombinedFromIterable(CompareFunc compare_func, Container&& container)
+      : container_(std::forward<Container>(container)),
+        compare_func_(std::move(compare_func)) {}
+
+ public:
+  SetCombinedFromIterable(SetCombinedFromIterable&&) = default;
+
+  template <typename ContainerT>
+  class Iterator {
+   private:
+    template <typename>
+    friend class Iterator;
+    template <SetOp, typename, typename, bool>
+    friend class SetRuns;
+
+    using SubContainer = iterator_deref<ContainerT>;
+    using SubIter = IteratorWrapper<SubContainer>;
+    using Runs = SetRuns<Op, iterator_deref<SubContainer>, CompareFunc,
+        !IsMultiPass<SubIter>{}>;
+
+    // Sub iterables that are produced as values are kept alive here.  They
+    // don't change after begin(), so copies of the iterator share them.
+    std::shared_ptr<std::deque<DerefHolder<SubContainer>>> sub_iterables_;
+    std::vector<SubIter> sub_iters_;
+    std::vector<SubIter> sub_ends_;
+    Runs runs_;
+
+    template <typename F>
+    auto visit(std::size_t i, F f) {
+      return f(sub_iters_[i], sub_ends_[i]);
+    }
+
+   public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = iterator_traits_deref<SubContainer>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = typename Runs::pointer;
+    using reference = typename Runs::reference;
+
+    // the end iterator, which has no sources
+    Iterator(CompareFunc& compare_func) : runs_(0, compare_func) {
+      runs_.start(*this);
+    }
+
+    Iterator(IteratorWrapper<ContainerT>&& top_iter,
+        IteratorWrapper<ContainerT>&& top_end, CompareFunc& compare_func)
+        : sub_iterables_{std::make_shared<
+              std::deque<DerefHolder<SubContainer>>>()},
+          runs_(0, compare_func) {
+      for (; top_iter != top_end; ++top_iter) {
+        auto& sub_iterable = sub_iterables_->emplace_back();
+        sub_iterable.reset(*top_iter);
+        sub_iters_.push_back(get_begin(sub_iterable.get()));
+        sub_ends_.push_back(get_end(sub_iterable.get()));
+      }
+      runs_ = Runs(sub_iters_.size(), compare_func);
+      runs_.start(*this);
+    }
+
+    reference operator*() {
+      return runs_.get();
+    }
+
+    pointer operator->() {
+      return runs_.get_ptr();
+    }
+
+    Iterator& operator++() {
+      runs_.next(*this);
+      return *this;
+    }
+
+    Iterator operator++(int) {
+      auto ret = *this;
+      ++*this;
+      return ret;
+    }
+
+    template <typename T>
+    bool operator!=(const Iterator<T>& other) const {
+      if (runs_.done() || other.runs_.done()) {
+        return runs_.done() != other.runs_.done();
+      }
+      if (sub_iters_.size() != other.sub_iters_.size()) {
+        return true;
+      }
+      for (std::size_t i = 0; i < sub_iters_.size(); ++i) {
+        if (sub_iters_[i] != other.sub_iters_[i]) {
+          return true;
+        }
+      }
+      return false;
+    }
+
+    template <typename T>
+    bool operator==(const Iterator<T>& other) const {
+      return !(*this != other);
+    }
+  };
+
+  Iterator<Container> begin() {
+    return {get_begin(container_), get_end(container_), compare_func_};
+  }
+
+  Iterator<Container> end() {
+    return {compare_func_};
+  }
+
+  Iterator<AsConst<Container>> begin() const {
+    return {get_begin(std::as_const(container_)),
+        get_end(std::as_const(container_)), compare_func_};
+  }
+
+  Iterator<AsConst<Container>> end() const {
+    return {compare_func_};
+  }
+};
+
+template <iter::impl::SetOp Op>
+class iter::impl::SetOpMaker {
+ private:
+  template <typename CompareFunc, typename TupleType, std::size_t... Is>
+  SetCombined<Op, CompareFunc, TupleType, Is...> combine(
+      CompareFunc compare_func, TupleType&& containers,
+      std::index_sequence<Is...>) const {
+    return {std::move(compare_func), std::move(containers)};
+  }
+
+ public:
+  // f(containers...) compares elements with <, and
+  // f(compare_func, containers...) compares them with compare_func
+  template <typename T, typename... Containers>
+  auto operator()(T&& t, Containers&&... cs) const {
+    if constexpr (is_iterable<T>) {
+      return combine(std::less<>{},
+          std::tuple<T, Containers...>{
+              std::forward<T>(t), std::forward<Containers>(cs)...},
+          std::index_sequence_for<T, Containers...>{});
+    } else {
+      return combine(std::decay_t<T>(std::forward<T>(t)),
+          std::tuple<Containers...>{std::forward<Containers>(cs)...},
+          std::index_sequence_for<Containers...>{});
+    }
+  }
+
+  SetFromIterableFn<Op> from_iterable;
+};
+
+namespace iter {
+  inline constexpr impl::SetOpMaker<impl::SetOp::Intersection>
+      set_intersection{};
+  inline constexpr impl::SetOpMaker<impl::SetOp::Union> set_union{};
+  inline constexpr impl::SetOpMaker<impl::SetOp::Difference> set_difference{};
+  inline constexpr impl::SetOpMaker<impl::SetOp::SymmetricDifference>
+      set_symmetric_difference{};
+}
+
+#endif
@@ -0,0 +1,369 @@
+#ifndef ITER_SHARED_SOURCE_HPP_
+#define ITER_SHARED_SOURCE_HPP_
+
+#include "internal/iterator_wrapper.hpp"
+#include "internal/iterbase.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace iter {
+  namespace impl {
+    template <typename Container>
+    class SharedSource;
+
+    using SharedSourceFn = IterToolFnBindSizeTSecond<SharedSource>;
+  }
+  inline constexpr impl::SharedSourceFn shared_source{};
+}
+
+// Lets several threads take elements from one iterable, each element going
+// to exactly one of them.  Elements are claimed n at a time: claim()
+// returns the next batch, which is empty once the iterable is used up.
+// Each call to begin() starts a loop which claims batches until there are
+// none left, so threads that each run
+//
+//     for (auto&& x : source) { ... }
+//
+// share the elements between them, with faster threads taking more.
+//
+// For a random access iterable a batch is a range of its iterators, and
+// claiming one is a single atomic add.  Otherwise a batch is taken from
+// the iterable under a lock, and its elements are held by reference when
+// the iterable's references stay valid, and copied or moved otherwise.
+template <typename Container>
+class iter::impl::SharedSource {
+ private:
+  using Iter = iterator_type<Container>;
+  using Arg = iterator_deref<Container>;
+  static constexpr bool RandomAccess =
+      is_iterator_at_least<Iter, std::random_access_iterator_tag>
+      && std::is_same_v<Iter, decltype(get_end(std::declval<Container&>()))>;
+  static constexpr bool KeepsRefs =
+      std::is_lvalue_reference_v<Arg>
+      && is_iterator_at_least<Iter, std::forward_iterator_tag>;
+  using Value = std::remove_cv_t<std::remove_reference_t<Arg>>;
+  using Stored = std::conditional_t<KeepsRefs, std::remove_reference_t<Arg>*,
+      Value>;
+
+ public:
+  // The elements claimed from a random access iterable
+  class IteratorBatch {
+   private:
+    Iter first_;
+    Iter last_;
+
+   public:
+    IteratorBatch(Iter first, Iter last)
+        : first_{std::move(first)}, last_{std::move(last)} {}
+
+    Iter begin() const {
+      return first_;
+    }
+
+    Iter end() const {
+      return last_;
+    }
+
+    std::size_t size() const {
+      return static_cast<std::size_t>(last_ - first_);
+    }
+
+    bool empty() const {
+      return first_ == last_;
+    }
+  };
+
+  // The elements claimed from any other iterable
+  class BufferedBatch {
+   private:
+    std::vector<Stored> items_;
+
+    struct Deref {
+      decltype(auto) operator()(Stored& s) const {
+        if constexpr (KeepsRefs) {
+          return *s;
+        } else {
+          return (s);
+        }
+      }
+    };
+
+   public:
+    BufferedBatch(std::vector<Stored>&& items) : items_(std::move(items)) {}
+
+    class Iterator {
+     private:
+      typename std::vector<Stored>::iterator it_;
+
+     public:
+      using iterator_category = std::random_access_iterator_tag;
+      using value_type = Value;
+      using difference_type = std::ptrdiff_t;
+      using reference = decltype(Deref{}(std::declval<Stored&>()));
+      using pointer = std::remove_reference_t<reference>*;
+
+      Iterator() = default;
+      Iterator(typename std::vector<Stored>::iterator it) : it_{it} {}
+
+      reference operator*() const {
+        return Deref{}(*it_);
+      }
+
+      pointer operator->() const {
+        return &**this;
+      }
+
+      reference operator[](difference_type n) const {
+        return Deref{}(it_[n]);
+      }
+
+      Iterator& operator++() {
+        ++it_;
+        return *this;
+      }
+
+      Iterator operator++(int) {
+        auto ret = *this;
+        ++*this;
+        return ret;
+      }
+
+      Iterator& operator--() {
+        --it_;
+        return *this;
+      }
+
+      Iterator operator--(int) {
+        auto ret = *this;
+        --*this;
+        return ret;
+      }
+
+      Iterator& operator+=(difference_type n) {
+        it_ += n;
+        return *this;
+      }
+
+      Iterator& operator-=(difference_type n) {
+        it_ -= n;
+        return *this;
+      }
+
+      Iterator operator+(difference_type n) const {
+        return Iterator{it_ + n};
+      }
+
+      friend Iterator operator+(difference_type n, const Iterator& it) {
+        return it + n;
+      }
+
+      Iterator operator-(difference_type n) const {
+        return Iterator{it_ - n};
+      }
+
+      difference_type operator-(const Iterator& other) const {
+        return it_ - other.it_;
+      }
+
+      bool operator==(const Iterator& other) const {
+        return it_ == other.it_;
+      }
+
+      bool operator!=(const Iterator& other) const {
+        return it_ != other.it_;
+      }
+
+      bool operator<(const Iterator& other) const {
+        return it_ < other.it_;
+      }
+
+      bool operator>(const Iterator& other) const {
+        return it_ > other.it_;
+      }
+
+      bool operator<=(const Iterator& other) const {
+        return it_ <= other.it_;
+      }
+
+      bool operator>=(const Iterator& other) const {
+        return it_ >= other.it_;
+      }
+    };
+
+    Iterator begin() {
+      return {items_.begin()};
+    }
+
+    Iterator end() {
+      return {items_.end()};
+    }
+
+    std::size_t size() const {
+      return items_.size();
+    }
+
+    bool empty() const {
+      return items_.empty();
+    }
+  };
+
+  using Batch =
+      std::conditional_t<RandomAccess, IteratorBatch, BufferedBatch>;
+
+ private:
+  // Set up by the first claim, so that get_begin() isn't called until
+  // then.  next_ is the offset of the next unclaimed element of a random
+  // access iterable, and sub_iter_ is guarded by mutex_ otherwise.
+  struct State {
+    Container container_;
+    std::size_t batch_size_;
+    std::once_flag started_;
+    std::optional<Iter> first_;
+    std::ptrdiff_t size_{};
+    std::atomic<std::ptrdiff_t> next_{0};
+    std::mutex mutex_;
+    std::optional<IteratorWrapper<Container>> sub_iter_;
+    std::optional<IteratorWrapper<Container>> sub_end_;
+
+    State(Container&& container, std::size_t batch_size)
+        : container_(std::forward<Container>(container)),
+          batch_size_{batch_size > 0 ? batch_size : 1} {}
+  };
+
+  std::unique_ptr<State> state_;
+
+  friend SharedSourceFn;
+
+  SharedSource(Container&& container, std::size_t batch_size)
+      : state_{std::make_unique<State>(
+          std::forward<Container>(container), batch_size)} {}
+
+  IteratorBatch claim_range() {
+    auto& s = *state_;
+    std::call_once(s.started_, [&s] {
+      s.first_.emplace(get_begin(s.container_));
+      s.size_ = get_end(s.container_) - *s.first_;
+    });
+    const auto batch = static_cast<std::ptrdiff_t>(s.batch_size_);
+    auto start = std::min(
+        s.next_.fetch_add(batch, std::memory_order_relaxed), s.size_);
+    auto stop = start + std::min(batch, s.size_ - start);
+    return {*s.first_ + start, *s.first_ + stop};
+  }
+
+  BufferedBatch claim_buffered() {
+    auto& s = *state_;
+    std::vector<Stored> items;
+    items.reserve(s.batch_size_);
+    std::lock_guard<std::mutex> lock{s.mutex_};
+    if (!s.sub_iter_) {
+      s.sub_iter_.emplace(get_begin(s.container_));
+      s.sub_end_.emplace(get_end(s.container_));
+    }
+    auto& sub_iter = *s.sub_iter_;
+    for (; items.size() < s.batch_size_ && sub_iter != *s.sub_end_;
+         ++sub_iter) {
+      if constexpr (KeepsRefs) {
+        items.push_back(&*sub_iter);
+      } else {
+        items.push_back(Value(*sub_iter));
+      }
+    }
+    return {std::move(items)};
+  }
+
+ public:
+  SharedSource(SharedSource&&) = default;
+
+  // safe to call from any number of threads at once
+  Batch claim() {
+    if constexpr (RandomAccess) {
+      return claim_range();
+    } else {
+      return claim_buffered();
+    }
+  }
+
+  class Iterator {
+   private:
+    using BatchIter = decltype(std::declval<Batch&>().begin());
+
+    // null at the end.  Copies share the batch, as it_ points into it.
+    SharedSource* source_{};
+    std::shared_ptr<Batch> batch_;
+    BatchIter it_{};
+
+    void claim_next() {
+      batch_ = std::make_shared<Batch>(source_->claim());
+      it_ = batch_->begin();
+      if (batch_->empty()) {
+        source_ = nullptr;
+        batch_.reset();
+      }
+    }
+
+   public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = Value;
+    using difference_type = std::ptrdiff_t;
+    using reference = decltype(*std::declval<BatchIter&>());
+    using pointer = std::remove_reference_t<reference>*;
+
+    // the end iterator
+    Iterator() = default;
+
+    Iterator(SharedSource& source) : source_{&source} {
+      claim_next();
+    }
+
+    reference operator*() {
+      return *it_;
+    }
+
+    pointer operator->() {
+      return &**this;
+    }
+
+    Iterator& operator++() {
+      ++it_;
+      if (it_ == batch_->end()) {
+        claim_next();
+      }
+      return *this;
+    }
+
+    Iterator operator++(int) {
+      auto ret = *this;
+      ++*this;
+      return ret;
+    }
+
+    bool operator!=(const Iterator& other) const {
+      return batch_ != other.batch_ || (batch_ && it_ != other.it_);
+    }
+
+    bool operator==(const Iterator& other) const {
+      return !(*this != other);
+    }
+  };
+
+  // each call starts a new loop, which claims batches as it goes
+  Iterator begin() {
+    return {*this};
+  }
+
+  Iterator end() {
+    return {};
+  }
+};
+
+#endif
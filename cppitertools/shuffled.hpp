@@ -0,0 +1,321 @@
+#ifndef ITER_SHUFFLED_HPP_
+#define ITER_SHUFFLED_HPP_
+
+#include "internal/iterbase.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace iter {
+  namespace impl {
+    template <typename Container>
+    class Shuffled;
+
+    using ShuffledFn = IterToolFnBindSizeTSecond<Shuffled>;
+
+    // A pseudorandom bijection on [0, n) chosen by a seed, taking O(1)
+    // memory.  It's a balanced Feistel network over the smallest even
+    // number of bits that holds n - 1, and values at or past n are passed
+    // through it again until they land below n, which takes fewer than
+    // four passes on average since the domain is under 4n.
+    class FeistelPermutation {
+     private:
+      static constexpr int Rounds = 6;
+
+      std::uint64_t n_{};
+      unsigned half_bits_{1};
+      std::uint64_t mask_{1};
+      std::uint64_t keys_[Rounds]{};
+
+      // splitmix64's finalizer
+      static constexpr std::uint64_t mix(std::uint64_t x) noexcept {
+        x ^= x >> 30;
+        x *= 0xBF58476D1CE4E5B9ull;
+        x ^= x >> 27;
+        x *= 0x94D049BB133111EBull;
+        x ^= x >> 31;
+        return x;
+      }
+
+      constexpr std::uint64_t encrypt(std::uint64_t x) const noexcept {
+        std::uint64_t left = x >> half_bits_;
+        std::uint64_t right = x & mask_;
+        for (auto key : keys_) {
+          auto next = left ^ (mix(right ^ key) & mask_);
+          left = right;
+          right = next;
+        }
+        return (left << half_bits_) | right;
+      }
+
+     public:
+      constexpr FeistelPermutation() noexcept = default;
+
+      constexpr FeistelPermutation(
+          std::uint64_t n, std::uint64_t seed) noexcept
+          : n_{n} {
+        while (half_bits_ < 32 && n > 0
+               && ((n - 1) >> (2 * half_bits_)) != 0) {
+          ++half_bits_;
+        }
+        mask_ = (std::uint64_t{1} << half_bits_) - 1;
+        for (int i = 0; i < Rounds; ++i) {
+          keys_[i] = mix(seed + static_cast<std::uint64_t>(i + 1)
+                                    * 0x9E3779B97F4A7C15ull);
+        }
+      }
+
+      constexpr std::uint64_t size() const noexcept {
+        return n_;
+      }
+
+      // i must be less than size()
+      constexpr std::uint64_t operator()(std::uint64_t i) const noexcept {
+        do {
+          i = encrypt(i);
+        } while (i >= n_);
+        return i;
+      }
+    };
+  }
+  inline constexpr impl::ShuffledFn shuffled{};
+}
+
+// Yields the elements of a random access iterable in a pseudorandom order
+// chosen by the seed, without copying or storing anything: position i of
+// the shuffled order is element FeistelPermutation(n, seed)(i) of the
+// iterable.  The iterators are random access, so shard() and operator[]
+// can start anywhere in the order for the same O(1) cost.
+template <typename Container>
+class iter::impl::Shuffled {
+ private:
+  Container container_;
+  std::size_t seed_;
+
+  friend ShuffledFn;
+
+  Shuffled(Container&& container, std::size_t seed)
+      : container_(std::forward<Container>(container)), seed_{seed} {}
+
+ public:
+  Shuffled(Shuffled&&) = default;
+
+  template <typename ContainerT>
+  class Iterator {
+   private:
+    template <typename>
+    friend class Iterator;
+
+    using SubIter = iterator_type<ContainerT>;
+    static_assert(is_random_access_iter<SubIter>{},
+        "shuffled requires a random access iterable");
+    using SubDiff = typename std::iterator_traits<SubIter>::difference_type;
+
+    SubIter base_;
+    FeistelPermutation perm_;
+    std::size_t pos_;
+
+   public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = iterator_traits_deref<ContainerT>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = value_type*;
+    using reference = iterator_deref<ContainerT>;
+
+    Iterator(SubIter base, const FeistelPermutation& perm, std::size_t pos)
+        : base_{std::move(base)}, perm_{perm}, pos_{pos} {}
+
+    reference operator*() const {
+      return *(base_ + static_cast<SubDiff>(perm_(pos_)));
+    }
+
+    auto operator->() const {
+      if constexpr (std::is_lvalue_reference_v<reference>) {
+        return &**this;
+      } else {
+        return ArrowProxy<reference>{**this};
+      }
+    }
+
+    Iterator& operator++() {
+      ++pos_;
+      return *this;
+    }
+
+    Iterator operator++(int) {
+      auto ret = *this;
+      ++*this;
+      return ret;
+    }
+
+    Iterator& operator--() {
+      --pos_;
+      return *this;
+    }
+
+    Iterator operator--(int) {
+      auto ret = *this;
+      --*this;
+      return ret;
+    }
+
+    Iterator& operator+=(difference_type n) {
+      pos_ += static_cast<std::size_t>(n);
+      return *this;
+    }
+
+    Iterator& operator-=(difference_type n) {
+      pos_ -= static_cast<std::size_t>(n);
+      return *this;
+    }
+
+    friend Iterator operator+(Iterator it, difference_type n) {
+      return it += n;
+    }
+
+    friend Iterator operator+(difference_type n, Iterator it) {
+      return it += n;
+    }
+
+    friend Iterator operator-(Iterator it, difference_type n) {
+      return it -= n;
+    }
+
+    template <typename T>
+    difference_type operator-(const Iterator<T>& other) const {
+      return static_cast<difference_type>(pos_ - other.pos_);
+    }
+
+    reference operator[](difference_type n) const {
+      return *(*this + n);
+    }
+
+    template <typename T>
+    bool operator!=(const Iterator<T>& other) const {
+      return pos_ != other.pos_;
+    }
+
+    template <typename T>
+    bool operator==(const Iterator<T>& other) const {
+      return !(*this != other);
+    }
+
+    template <typename T>
+    bool operator<(const Iterator<T>& other) const {
+      return pos_ < other.pos_;
+    }
+
+    template <typename T>
+    bool operator>(const Iterator<T>& other) const {
+      return other < *this;
+    }
+
+    template <typename T>
+    bool operator<=(const Iterator<T>& other) const {
+      return !(other < *this);
+    }
+
+    template <typename T>
+    bool operator>=(const Iterator<T>& other) const {
+      return !(*this < other);
+    }
+  };
+
+  // positions [first, last) of the shuffled order
+  template <typename It>
+  class Shard {
+   private:
+    It first_;
+    It last_;
+
+   public:
+    Shard(It first, It last) : first_{first}, last_{last} {}
+
+    It begin() const {
+      return first_;
+    }
+
+    It end() const {
+      return last_;
+    }
+
+    std::size_t size() const {
+      return static_cast<std::size_t>(last_ - first_);
+    }
+  };
+
+ private:
+  template <typename ContainerT>
+  static Iterator<ContainerT> make_iter(
+      ContainerT& container, std::size_t seed, std::size_t pos) {
+    auto first = get_begin(container);
+    auto n = static_cast<std::size_t>(get_end(container) - first);
+    return {std::move(first), FeistelPermutation(n, seed), pos < n ? pos : n};
+  }
+
+  template <typename ContainerT>
+  static Shard<Iterator<ContainerT>> make_shard(ContainerT& container,
+      std::size_t seed, std::size_t index, std::size_t count) {
+    auto n = static_cast<std::size_t>(
+        get_end(container) - get_begin(container));
+    // splits [0, n) as evenly as possible, without overflowing
+    auto bound = [n, count](std::size_t i) {
+      return n / count * i + n % count * i / count;
+    };
+    if (count == 0 || index >= count) {
+      return {make_iter<ContainerT>(container, seed, n),
+          make_iter<ContainerT>(container, seed, n)};
+    }
+    return {make_iter<ContainerT>(container, seed, bound(index)),
+        make_iter<ContainerT>(container, seed, bound(index + 1))};
+  }
+
+ public:
+  Iterator<Container> begin() {
+    return make_iter<Container>(container_, seed_, 0);
+  }
+
+  Iterator<Container> end() {
+    return make_iter<Container>(
+        container_, seed_, static_cast<std::size_t>(-1));
+  }
+
+  Iterator<AsConst<Container>> begin() const {
+    return make_iter<AsConst<Container>>(
+        std::as_const(container_), seed_, 0);
+  }
+
+  Iterator<AsConst<Container>> end() const {
+    return make_iter<AsConst<Container>>(
+        std::as_const(container_), seed_, static_cast<std::size_t>(-1));
+  }
+
+  std::size_t size() const {
+    return static_cast<std::size_t>(end() - begin());
+  }
+
+  iterator_deref<Container> operator[](std::size_t pos) {
+    return begin()[static_cast<std::ptrdiff_t>(pos)];
+  }
+
+  iterator_deref<AsConst<Container>> operator[](std::size_t pos) const {
+    return begin()[static_cast<std::ptrdiff_t>(pos)];
+  }
+
+  // The index-th of count nearly equal parts of the shuffled order, which
+  // together yield every element once.  An index past count is empty.
+  Shard<Iterator<Container>> shard(std::size_t index, std::size_t count) {
+    return make_shard<Container>(container_, seed_, index, count);
+  }
+
+  Shard<Iterator<AsConst<Container>>> shard(
+      std::size_t index, std::size_t count) const {
+    return make_shard<AsConst<Container>>(
+        std::as_const(container_), seed_, index, count);
+  }
+};
+
+#endif
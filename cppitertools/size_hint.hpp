@@ -0,0 +1,17 @@
+#ifndef ITER_SIZE_HINT_HPP_
+#define ITER_SIZE_HINT_HPP_
+
+#include "internal/iterbase.hpp"
+
+namespace iter {
+  using SizeHint = impl::SizeHint;
+
+  // Bounds on the number of elements an iterable yields, worked out from
+  // the sizes of the iterables beneath it without iterating anything.
+  template <typename Container>
+  SizeHint size_hint(Container&& container) {
+    return impl::size_hint_of(container);
+  }
+}
+
+#endif
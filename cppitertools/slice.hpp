@@ -3,9 +3,18 @@
 
 #include "internal/iterator_wrapper.hpp"
 #include "internal/iterbase.hpp"
+#include "range.hpp"
 
+#include <algorithm>
+#include <cassert>
+#include <deque>
 #include <iterator>
+#include <optional>
 #include <type_traits>
+#include <utility>
+#if __has_include(<span>)
+#include <span>
+#endif
 
 namespace iter {
   namespace impl {
@@ -13,6 +22,60 @@ namespace iter {
     class Sliced;
 
     struct SliceFn;
+
+    // Containers whose slices are positioned by arithmetic instead of by
+    // walking the elements
+    template <typename Container, typename = void>
+    struct IsRandomAccessSliceable : std::false_type {};
+
+    template <typename Container>
+    struct IsRandomAccessSliceable<Container,
+        std::void_t<iterator_type<Container>, iterator_end_type<Container>>>
+        : std::bool_constant<has_random_access_iter<Container>{}
+                             && std::is_same_v<iterator_type<Container>,
+                                 iterator_end_type<Container>>> {};
+
+    template <typename Container>
+    constexpr bool is_random_access_sliceable =
+        IsRandomAccessSliceable<Container>::value;
+
+    // Containers which can be walked more than once, so that their size can
+    // be counted before slicing them from the end
+    template <typename Container, typename = void>
+    struct IsMultiPassSliceable : std::false_type {};
+
+    template <typename Container>
+    struct IsMultiPassSliceable<Container,
+        std::void_t<iterator_type<Container>>>
+        : std::bool_constant<is_iterator_at_least<iterator_type<Container>,
+              std::forward_iterator_tag>> {};
+
+    template <typename Container>
+    constexpr bool is_multi_pass_sliceable =
+        IsMultiPassSliceable<Container>::value;
+
+    // Python style slice position. Negative values count back from size and
+    // the result is never below 0
+    template <typename DifferenceType>
+    DifferenceType slice_index_from_end(
+        DifferenceType index, DifferenceType size) {
+      if constexpr (std::is_signed_v<DifferenceType>) {
+        if (index < 0) {
+          index += size;
+          return index < 0 ? DifferenceType{0} : index;
+        }
+      }
+      return index;
+    }
+
+    template <typename DifferenceType>
+    bool is_from_end(DifferenceType index) {
+      if constexpr (std::is_signed_v<DifferenceType>) {
+        return index < 0;
+      } else {
+        return false;
+      }
+    }
   }
 }
 
@@ -26,12 +89,61 @@ class iter::impl::Sliced {
 
   friend SliceFn;
 
+  // negative indices are resolved once, here, when the size of the
+  // container is known from an exact hint or from a walk over the elements.
+  // Counting a container which can only be walked once would use it up, so
+  // without a hint its negative indices are left for WindowIterator.
+  static std::optional<DifferenceType> size_if_from_end(Container& container) {
+    if (auto n = size_hint_of(container).exact()) {
+      return static_cast<DifferenceType>(*n);
+    }
+    if constexpr (is_multi_pass_sliceable<Container>) {
+      return static_cast<DifferenceType>(dumb_size(container));
+    } else {
+      return std::nullopt;
+    }
+  }
+
   Sliced(Container&& container, DifferenceType start, DifferenceType stop,
       DifferenceType step)
       : container_(std::forward<Container>(container)),
-        start_{start < stop && step > 0 ? start : stop},
+        start_{start},
         stop_{stop},
-        step_{step} {}
+        step_{step} {
+    if (is_from_end(start_) || is_from_end(stop_)) {
+      if (auto size = size_if_from_end(container_)) {
+        start_ = slice_index_from_end(start_, *size);
+        stop_ = slice_index_from_end(stop_, *size);
+      } else {
+        if (!(step_ > 0)) {
+          start_ = stop_;
+        }
+        return;
+      }
+    }
+    if (!(start_ < stop_ && step_ > 0)) {
+      start_ = stop_;
+    }
+  }
+
+  // [first, last) positions in the container that the slice covers, with
+  // both clamped to the container's actual size
+  template <typename C>
+  std::pair<DifferenceType, DifferenceType> clamped_bounds(C& c) const {
+    auto size = static_cast<DifferenceType>(get_end(c) - get_begin(c));
+    auto first = start_ < size ? start_ : size;
+    auto last = stop_ < size ? stop_ : size;
+    return {first, first < last ? last : first};
+  }
+
+  template <typename C>
+  DifferenceType slice_size(C& c) const {
+    auto [first, last] = clamped_bounds(c);
+    if (first == last) {
+      return DifferenceType{0};
+    }
+    return (last - first - 1) / step_ + 1;
+  }
 
  public:
   Sliced(Sliced&&) = default;
@@ -96,27 +208,377 @@ class iter::impl::Sliced {
     }
   };
 
-  Iterator<Container> begin() {
-    auto it = get_begin(container_);
-    dumb_advance(it, get_end(container_), start_);
-    return {std::move(it), get_end(container_), start_, stop_, step_};
+  // Used when the container is random access.  It keeps an iterator to the
+  // first element of the slice and the number of steps taken from there, so
+  // that it never moves the underlying iterator past the end.
+  template <typename ContainerT>
+  class RandomAccessIterator {
+   private:
+    template <typename>
+    friend class RandomAccessIterator;
+    iterator_type<ContainerT> first_;
+    std::ptrdiff_t index_;
+    std::ptrdiff_t step_;
+
+    iterator_type<ContainerT> sub_iter() const {
+      return first_ + index_ * step_;
+    }
+
+   public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = iterator_traits_deref<ContainerT>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = value_type*;
+    using reference = iterator_deref<ContainerT>;
+
+    RandomAccessIterator(iterator_type<ContainerT>&& first,
+        std::ptrdiff_t index, std::ptrdiff_t step)
+        : first_{std::move(first)}, index_{index}, step_{step} {}
+
+    iterator_deref<ContainerT> operator*() const {
+      return *sub_iter();
+    }
+
+    iterator_arrow<ContainerT> operator->() const {
+      auto it = sub_iter();
+      return apply_arrow(it);
+    }
+
+    iterator_deref<ContainerT> operator[](difference_type n) const {
+      return *(*this + n);
+    }
+
+    RandomAccessIterator& operator++() {
+      ++index_;
+      return *this;
+    }
+
+    RandomAccessIterator operator++(int) {
+      auto ret = *this;
+      ++*this;
+      return ret;
+    }
+
+    RandomAccessIterator& operator--() {
+      --index_;
+      return *this;
+    }
+
+    RandomAccessIterator operator--(int) {
+      auto ret = *this;
+      --*this;
+      return ret;
+    }
+
+    RandomAccessIterator& operator+=(difference_type n) {
+      index_ += n;
+      return *this;
+    }
+
+    RandomAccessIterator& operator-=(difference_type n) {
+      index_ -= n;
+      return *this;
+    }
+
+    friend RandomAccessIterator operator+(
+        RandomAccessIterator it, difference_type n) {
+      return it += n;
+    }
+
+    friend RandomAccessIterator operator+(
+        difference_type n, RandomAccessIterator it) {
+      return it += n;
+    }
+
+    friend RandomAccessIterator operator-(
+        RandomAccessIterator it, difference_type n) {
+      return it -= n;
+    }
+
+    template <typename T>
+    difference_type operator-(const RandomAccessIterator<T>& other) const {
+      return index_ - other.index_;
+    }
+
+    template <typename T>
+    bool operator==(const RandomAccessIterator<T>& other) const {
+      return index_ == other.index_;
+    }
+
+    template <typename T>
+    bool operator!=(const RandomAccessIterator<T>& other) const {
+      return !(*this == other);
+    }
+
+    template <typename T>
+    bool operator<(const RandomAccessIterator<T>& other) const {
+      return index_ < other.index_;
+    }
+
+    template <typename T>
+    bool operator>(const RandomAccessIterator<T>& other) const {
+      return other < *this;
+    }
+
+    template <typename T>
+    bool operator<=(const RandomAccessIterator<T>& other) const {
+      return !(other < *this);
+    }
+
+    template <typename T>
+    bool operator>=(const RandomAccessIterator<T>& other) const {
+      return !(*this < other);
+    }
+  };
+
+  // Used when the container can only be walked once, so that a start or
+  // stop counting back from its end can't be resolved by counting the
+  // elements first.  The elements are instead copied into a window as they
+  // are read: a negative start keeps the last -start of them until the end
+  // is reached, and a negative stop holds each element back until -stop
+  // more have been read after it.  A slice which doesn't count from the end
+  // reads straight from the container, as Iterator does.
+  template <typename ContainerT>
+  class WindowIterator {
+   private:
+    template <typename>
+    friend class WindowIterator;
+
+    using Value =
+        std::remove_cv_t<std::remove_reference_t<iterator_deref<ContainerT>>>;
+
+    IteratorWrapper<ContainerT> sub_iter_;
+    IteratorWrapper<ContainerT> sub_end_;
+    // the held elements which the slice yields, the first being current_
+    std::deque<DerefHolder<Value>> held_;
+    DifferenceType start_;
+    DifferenceType current_;
+    DifferenceType stop_;
+    DifferenceType step_;
+    // position in the container of sub_iter_
+    DifferenceType read_{};
+    bool windowed_;
+
+    void read(bool keep) {
+      if (keep) {
+        held_.emplace_back();
+        held_.back().reset(Value(*sub_iter_));
+      }
+      ++sub_iter_;
+      ++read_;
+    }
+
+    // With a negative start, nothing is known to be in the slice until the
+    // end has been reached.
+    void read_to_end() {
+      // -(start_ + 1) + 1 so that the lowest value of start_ can't overflow
+      auto width = static_cast<std::size_t>(-(start_ + 1)) + 1;
+      while (sub_iter_ != sub_end_) {
+        read(true);
+        if (held_.size() > width) {
+          held_.pop_front();
+        }
+      }
+      current_ = read_ - static_cast<DifferenceType>(held_.size());
+      stop_ = slice_index_from_end(stop_, read_);
+      if (read_ < stop_) {
+        stop_ = read_;
+      }
+      if (!(current_ < stop_)) {
+        held_.clear();
+      }
+    }
+
+    // With a negative stop, reads until -stop elements are known to come
+    // after current_, holding only the elements the slice yields.
+    void read_past_current() {
+      while (read_ + stop_ <= current_ && sub_iter_ != sub_end_) {
+        read(read_ >= current_ && (read_ - start_) % step_ == 0);
+      }
+      if (read_ + stop_ <= current_) {
+        held_.clear();
+      }
+    }
+
+    bool done() const {
+      if (windowed_) {
+        return held_.empty();
+      }
+      return !(sub_iter_ != sub_end_) || !(current_ < stop_);
+    }
+
+   public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = iterator_traits_deref<ContainerT>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = value_type*;
+    using reference = iterator_deref<ContainerT>;
+
+    WindowIterator(IteratorWrapper<ContainerT>&& sub_iter,
+        IteratorWrapper<ContainerT>&& sub_end, DifferenceType start,
+        DifferenceType stop, DifferenceType step)
+        : sub_iter_{std::move(sub_iter)},
+          sub_end_{std::move(sub_end)},
+          start_{start},
+          current_{start},
+          stop_{stop},
+          step_{step},
+          windowed_{is_from_end(start) || is_from_end(stop)} {
+      if (!windowed_) {
+        dumb_advance(sub_iter_, sub_end_, start_);
+      } else if (is_from_end(start_)) {
+        read_to_end();
+      } else {
+        read_past_current();
+      }
+    }
+
+    // a held element is a copy, so writing through the reference doesn't
+    // change the container
+    reference operator*() {
+      if (windowed_) {
+        return static_cast<reference>(held_.front().get());
+      }
+      return *sub_iter_;
+    }
+
+    ArrowProxy<reference> operator->() {
+      return {**this};
+    }
+
+    WindowIterator& operator++() {
+      if (!windowed_) {
+        dumb_advance(sub_iter_, sub_end_, step_);
+        current_ += step_;
+        if (stop_ < current_) {
+          current_ = stop_;
+        }
+      } else if (is_from_end(start_)) {
+        // the window holds every element from current_ to the end
+        for (DifferenceType i = 0; i < step_ && !held_.empty(); ++i) {
+          held_.pop_front();
+        }
+        current_ += step_;
+        if (!(current_ < stop_)) {
+          held_.clear();
+        }
+      } else {
+        held_.pop_front();
+        current_ += step_;
+        read_past_current();
+      }
+      return *this;
+    }
+
+    WindowIterator operator++(int) {
+      auto ret = *this;
+      ++*this;
+      return ret;
+    }
+
+    template <typename T>
+    bool operator!=(const WindowIterator<T>& other) const {
+      if (done() || other.done()) {
+        return done() != other.done();
+      }
+      return current_ != other.current_;
+    }
+
+    template <typename T>
+    bool operator==(const WindowIterator<T>& other) const {
+      return !(*this != other);
+    }
+  };
+
+  template <typename ContainerT>
+  using SliceIterator = std::conditional_t<
+      is_random_access_sliceable<ContainerT>, RandomAccessIterator<ContainerT>,
+      std::conditional_t<is_multi_pass_sliceable<ContainerT>,
+          Iterator<ContainerT>, WindowIterator<ContainerT>>>;
+
+ private:
+  template <typename ContainerT>
+  SliceIterator<ContainerT> make_begin(ContainerT& c) const {
+    if constexpr (is_random_access_sliceable<ContainerT>) {
+      auto first = clamped_bounds(c).first;
+      return {get_begin(c) + first, 0, static_cast<std::ptrdiff_t>(step_)};
+    } else if constexpr (!is_multi_pass_sliceable<ContainerT>) {
+      return {get_begin(c), get_end(c), start_, stop_, step_};
+    } else {
+      auto it = get_begin(c);
+      dumb_advance(it, get_end(c), start_);
+      return {std::move(it), get_end(c), start_, stop_, step_};
+    }
+  }
+
+  template <typename ContainerT>
+  SliceIterator<ContainerT> make_end(ContainerT& c) const {
+    if constexpr (is_random_access_sliceable<ContainerT>) {
+      auto first = clamped_bounds(c).first;
+      return {get_begin(c) + first, static_cast<std::ptrdiff_t>(slice_size(c)),
+          static_cast<std::ptrdiff_t>(step_)};
+    } else {
+      return {get_end(c), get_end(c), stop_, stop_, step_};
+    }
+  }
+
+ public:
+  SliceIterator<Container> begin() {
+    return make_begin<Container>(container_);
+  }
+
+  SliceIterator<Container> end() {
+    return make_end<Container>(container_);
   }
 
-  Iterator<Container> end() {
-    return {get_end(container_), get_end(container_), stop_, stop_, step_};
+  SliceIterator<AsConst<Container>> begin() const {
+    return make_begin<AsConst<Container>>(std::as_const(container_));
   }
 
-  Iterator<AsConst<Container>> begin() const {
-    auto it = get_begin(std::as_const(container_));
-    dumb_advance(it, get_end(std::as_const(container_)), start_);
-    return {std::move(it), get_end(std::as_const(container_)), start_, stop_,
-        step_};
+  SliceIterator<AsConst<Container>> end() const {
+    return make_end<AsConst<Container>>(std::as_const(container_));
   }
 
-  Iterator<AsConst<Container>> end() const {
-    return {get_end(std::as_const(container_)),
-        get_end(std::as_const(container_)), stop_, stop_, step_};
+  // number of elements in the slice, only with random access containers
+  std::size_t size() const {
+    static_assert(is_random_access_sliceable<AsConst<Container>>,
+        "slice size() only supported with random access iterables");
+    return static_cast<std::size_t>(slice_size(std::as_const(container_)));
   }
+
+  SizeHint size_hint() const {
+    if (is_from_end(start_) || is_from_end(stop_)) {
+      // left for WindowIterator, since the size isn't known
+      return size_hints::at_most(size_hint_of(std::as_const(container_)));
+    }
+    return size_hints::map(size_hint_of(std::as_const(container_)),
+        [this](std::size_t n) -> std::optional<std::size_t> {
+          auto first = std::min(static_cast<std::size_t>(start_), n);
+          auto last = std::min(static_cast<std::size_t>(stop_), n);
+          if (first >= last) {
+            return 0;
+          }
+          return (last - first - 1) / static_cast<std::size_t>(step_) + 1;
+        });
+  }
+
+#ifdef __cpp_lib_span
+  // A view of the sliced elements in place, when they are contiguous.  Only
+  // valid when the step is 1
+  auto span() {
+    assert(step_ == 1);
+    auto first = clamped_bounds(container_).first;
+    return std::span{std::data(container_) + first,
+        static_cast<std::size_t>(slice_size(container_))};
+  }
+
+  auto span() const {
+    assert(step_ == 1);
+    auto first = clamped_bounds(std::as_const(container_)).first;
+    return std::span{std::data(std::as_const(container_)) + first,
+        static_cast<std::size_t>(slice_size(std::as_const(container_)))};
+  }
+#endif
 };
 
 struct iter::impl::SliceFn {
@@ -125,8 +587,8 @@ struct iter::impl::SliceFn {
   class FnPartial : public Pipeable<FnPartial<DifferenceType>> {
    public:
     template <typename Container>
-    Sliced<Container, DifferenceType> operator()(Container&& container) const {
-      return {std::forward<Container>(container), start_, stop_, step_};
+    auto operator()(Container&& container) const {
+      return SliceFn{}(std::forward<Container>(container), start_, stop_, step_);
     }
 
    private:
@@ -140,20 +602,34 @@ struct iter::impl::SliceFn {
   };
 
  public:
+  // slicing an integral range produces another range directly
   template <typename Container, typename DifferenceType,
       typename = std::enable_if_t<is_iterable<Container>>>
-  Sliced<Container, DifferenceType> operator()(Container&& container,
-      DifferenceType start, DifferenceType stop,
-      DifferenceType step = 1) const {
-    return {std::forward<Container>(container), start, stop, step};
+  auto operator()(Container&& container, DifferenceType start,
+      DifferenceType stop, DifferenceType step = 1) const {
+    if constexpr (is_integral_range<Container>) {
+      if (is_from_end(start) || is_from_end(stop)) {
+        auto size = static_cast<DifferenceType>(container.size());
+        start = slice_index_from_end(start, size);
+        stop = slice_index_from_end(stop, size);
+      }
+      if (!(start < stop && step > 0)) {
+        return container.slice(0, 0);
+      }
+      return container.slice(static_cast<std::size_t>(start),
+          static_cast<std::size_t>(stop), static_cast<std::size_t>(step));
+    } else {
+      return Sliced<Container, DifferenceType>{
+          std::forward<Container>(container), start, stop, step};
+    }
   }
 
   // only given the end, assume step_ is 1 and begin is 0
   template <typename Container, typename DifferenceType,
       typename = std::enable_if_t<is_iterable<Container>>>
-  iter::impl::Sliced<Container, DifferenceType> operator()(
-      Container&& container, DifferenceType stop) const {
-    return {std::forward<Container>(container), 0, stop, 1};
+  auto operator()(Container&& container, DifferenceType stop) const {
+    return (*this)(std::forward<Container>(container), DifferenceType{0},
+        stop, DifferenceType{1});
   }
 
   template <typename DifferenceType,
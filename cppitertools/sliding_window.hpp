@@ -5,9 +5,14 @@
 #include "internal/iteratoriterator.hpp"
 #include "internal/iterbase.hpp"
 
+#include <array>
+#include <cstddef>
 #include <deque>
 #include <iterator>
 #include <memory>
+#include <optional>
+#include <tuple>
+#include <type_traits>
 #include <utility>
 
 namespace iter {
@@ -15,8 +20,44 @@ namespace iter {
     template <typename Container>
     class WindowSlider;
     using SlidingWindowFn = IterToolFnBindSizeTSecond<WindowSlider>;
+
+    template <typename Container, std::size_t N>
+    class FixedWindowSlider;
+
+    template <std::size_t N>
+    struct FixedWindowFn : Pipeable<FixedWindowFn<N>> {
+      template <typename Container>
+      FixedWindowSlider<Container, N> operator()(Container&& container) const {
+        return {std::forward<Container>(container)};
+      }
+    };
+
+    // sliding_window, with sliding_window.fixed<N> for windows whose size
+    // is known at compile time
+    struct SlidingWindowMaker : SlidingWindowFn {
+      template <std::size_t N>
+      static constexpr FixedWindowFn<N> fixed{};
+    };
+
+    template <typename T, typename Seq>
+    struct RepeatedTuple;
+
+    template <typename T, std::size_t... Is>
+    struct RepeatedTuple<T, std::index_sequence<Is...>> {
+      template <std::size_t>
+      using Same = T;
+      using type = std::tuple<Same<Is>...>;
+    };
+
+    // the size hint of the windows of size k over an iterable
+    inline SizeHint window_size_hint(SizeHint hint, std::size_t k) {
+      return size_hints::map(
+          hint, [k](std::size_t n) -> std::optional<std::size_t> {
+            return k == 0 || n < k ? 0 : n - k + 1;
+          });
+    }
   }
-  inline constexpr impl::SlidingWindowFn sliding_window{};
+  inline constexpr impl::SlidingWindowMaker sliding_window{};
 }
 
 template <typename Container>
@@ -121,6 +162,142 @@ class iter::impl::WindowSlider {
     return {get_end(std::as_const(container_)),
         get_end(std::as_const(container_)), window_size_};
   }
+
+  SizeHint size_hint() const {
+    return window_size_hint(
+        size_hint_of(std::as_const(container_)), window_size_);
+  }
+};
+
+// Yields each N consecutive elements as a tuple of references, so that
+// structured bindings work.  The window is an array of pointers to the
+// elements, or of copies of them if the iterable yields values or only has
+// input iterators, so moving it along is N - 1 copies and a dereference
+// with no allocation.
+template <typename Container, std::size_t N>
+class iter::impl::FixedWindowSlider {
+ private:
+  static_assert(N > 0, "sliding_window.fixed needs a window of at least 1");
+
+  Container container_;
+
+  friend FixedWindowFn<N>;
+
+  FixedWindowSlider(Container&& container)
+      : container_(std::forward<Container>(container)) {}
+
+ public:
+  FixedWindowSlider(FixedWindowSlider&&) = default;
+
+  template <typename ContainerT>
+  class Iterator {
+   private:
+    template <typename>
+    friend class Iterator;
+
+    using Arg = iterator_deref<ContainerT>;
+    static constexpr bool KeepsRefs =
+        std::is_lvalue_reference_v<Arg>
+        && is_iterator_at_least<iterator_type<ContainerT>,
+            std::forward_iterator_tag>;
+    using Value = std::remove_cv_t<std::remove_reference_t<Arg>>;
+    using Holder = DerefHolder<std::conditional_t<KeepsRefs, Arg, Value>>;
+
+    IteratorWrapper<ContainerT> sub_iter_;
+    IteratorWrapper<ContainerT> sub_end_;
+    std::array<Holder, N> window_;
+
+    void load(std::size_t i) {
+      if constexpr (KeepsRefs) {
+        window_[i].reset(*sub_iter_);
+      } else {
+        window_[i].reset(Value(*sub_iter_));
+      }
+    }
+
+    template <std::size_t... Is>
+    auto window_tuple(std::index_sequence<Is...>) {
+      return value_type{window_[Is].get()...};
+    }
+
+   public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = typename RepeatedTuple<typename Holder::reference,
+        std::make_index_sequence<N>>::type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = value_type*;
+    using reference = value_type;
+
+    // a sub_iter_ at the end, including with fewer than N elements, is the
+    // end of the windows; otherwise it is at the window's last element
+    Iterator(IteratorWrapper<ContainerT>&& sub_iter,
+        IteratorWrapper<ContainerT>&& sub_end)
+        : sub_iter_{std::move(sub_iter)}, sub_end_{std::move(sub_end)} {
+      for (std::size_t i = 0; i < N && sub_iter_ != sub_end_; ++i) {
+        load(i);
+        if (i + 1 != N) {
+          ++sub_iter_;
+        }
+      }
+    }
+
+    reference operator*() {
+      return window_tuple(std::make_index_sequence<N>{});
+    }
+
+    ArrowProxy<reference> operator->() {
+      return {**this};
+    }
+
+    Iterator& operator++() {
+      ++sub_iter_;
+      if (sub_iter_ != sub_end_) {
+        for (std::size_t i = 0; i + 1 < N; ++i) {
+          window_[i] = std::move(window_[i + 1]);
+        }
+        load(N - 1);
+      }
+      return *this;
+    }
+
+    Iterator operator++(int) {
+      auto ret = *this;
+      ++*this;
+      return ret;
+    }
+
+    template <typename T>
+    bool operator!=(const Iterator<T>& other) const {
+      return sub_iter_ != other.sub_iter_;
+    }
+
+    template <typename T>
+    bool operator==(const Iterator<T>& other) const {
+      return !(*this != other);
+    }
+  };
+
+  Iterator<Container> begin() {
+    return {get_begin(container_), get_end(container_)};
+  }
+
+  Iterator<Container> end() {
+    return {get_end(container_), get_end(container_)};
+  }
+
+  Iterator<AsConst<Container>> begin() const {
+    return {get_begin(std::as_const(container_)),
+        get_end(std::as_const(container_))};
+  }
+
+  Iterator<AsConst<Container>> end() const {
+    return {get_end(std::as_const(container_)),
+        get_end(std::as_const(container_))};
+  }
+
+  SizeHint size_hint() const {
+    return window_size_hint(size_hint_of(std::as_const(container_)), N);
+  }
 };
 
 #endif
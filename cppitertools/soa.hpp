@@ -0,0 +1,435 @@
+#ifndef ITER_SOA_HPP_
+#define ITER_SOA_HPP_
+
+#include "internal/iterbase.hpp"
+#include "sort_zipped.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if __has_include(<span>)
+#include <span>
+#endif
+
+namespace iter {
+  namespace impl {
+    template <typename... Ts>
+    class Soa;
+
+    template <typename T>
+    class ColumnSpan;
+  }
+
+  // soa<Ts...> is a sequence of rows of Ts, stored as one contiguous
+  // vector per column
+  template <typename... Ts>
+  using soa = impl::Soa<Ts...>;
+}
+
+// A view of one column of an soa.  It converts to std::span where that is
+// available.
+template <typename T>
+class iter::impl::ColumnSpan {
+ private:
+  T* data_;
+  std::size_t size_;
+
+ public:
+  using element_type = T;
+  using value_type = std::remove_cv_t<T>;
+  using iterator = T*;
+
+  constexpr ColumnSpan(T* data, std::size_t size) noexcept
+      : data_{data}, size_{size} {}
+
+  constexpr T* data() const noexcept {
+    return data_;
+  }
+
+  constexpr std::size_t size() const noexcept {
+    return size_;
+  }
+
+  constexpr bool empty() const noexcept {
+    return size_ == 0;
+  }
+
+  constexpr T* begin() const noexcept {
+    return data_;
+  }
+
+  constexpr T* end() const noexcept {
+    return data_ + size_;
+  }
+
+  constexpr T& operator[](std::size_t i) const noexcept {
+    return data_[i];
+  }
+
+#ifdef __cpp_lib_span
+  constexpr operator std::span<T>() const noexcept {
+    return {data_, size_};
+  }
+#endif
+};
+
+template <typename... Ts>
+class iter::impl::Soa {
+ private:
+  static_assert(sizeof...(Ts) > 0, "soa requires at least one column");
+  static_assert((... && !std::is_same_v<Ts, bool>),
+      "std::vector<bool> isn't contiguous, use char for a column of bools");
+  static_assert((... && std::is_same_v<Ts, std::decay_t<Ts>>),
+      "soa columns must be unqualified object types");
+
+  using Indices = std::index_sequence_for<Ts...>;
+
+  std::tuple<std::vector<Ts>...> columns_;
+
+  template <typename Func, std::size_t... Is>
+  void for_each_column(Func&& func, std::index_sequence<Is...>) {
+    (static_cast<void>(func(std::get<Is>(columns_))), ...);
+  }
+
+  template <std::size_t... Is>
+  std::tuple<Ts&...> row(std::size_t i, std::index_sequence<Is...>) {
+    return {std::get<Is>(columns_)[i]...};
+  }
+
+  template <std::size_t... Is>
+  std::tuple<const Ts&...> row(
+      std::size_t i, std::index_sequence<Is...>) const {
+    return {std::get<Is>(columns_)[i]...};
+  }
+
+  // Grows the columns one at a time with grow(column, index).  If one of
+  // them throws, those already grown are shrunk back before it's rethrown,
+  // so that the columns always have the same length.
+  template <typename Grow, std::size_t... Is>
+  void grow_columns(Grow&& grow, std::index_sequence<Is...>) {
+    const auto old_size = size();
+    std::size_t grown = 0;
+    try {
+      (..., (grow(std::get<Is>(columns_),
+                 std::integral_constant<std::size_t, Is>{}),
+                ++grown));
+    } catch (...) {
+      (..., (Is < grown ? shrink(std::get<Is>(columns_), old_size) : void()));
+      throw;
+    }
+  }
+
+  template <typename Column>
+  static void shrink(Column& col, std::size_t n) {
+    while (col.size() > n) {
+      col.pop_back();
+    }
+  }
+
+  template <typename Permutation, std::size_t... Is>
+  void permute_columns(const Permutation& perm, std::index_sequence<Is...>) {
+    ApplyPermutationFn{}(perm, std::get<Is>(columns_)...);
+  }
+
+  template <typename Tup, std::size_t... Is>
+  void push_back_tuple(Tup&& tup, std::index_sequence<Is...> indices) {
+    grow_columns(
+        [&tup](auto& col, auto i) {
+          col.push_back(std::get<decltype(i)::value>(std::forward<Tup>(tup)));
+        },
+        indices);
+  }
+
+  template <typename... Us, std::size_t... Is>
+  void emplace_back_impl(std::index_sequence<Is...> indices, Us&&... us) {
+    auto args = std::forward_as_tuple(std::forward<Us>(us)...);
+    grow_columns(
+        [&args](auto& col, auto i) {
+          col.emplace_back(std::get<decltype(i)::value>(std::move(args)));
+        },
+        indices);
+  }
+
+ public:
+  using value_type = std::tuple<Ts...>;
+  using reference = std::tuple<Ts&...>;
+  using const_reference = std::tuple<const Ts&...>;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+
+  Soa() = default;
+
+  Soa(std::initializer_list<value_type> rows) {
+    reserve(rows.size());
+    for (auto&& r : rows) {
+      push_back(r);
+    }
+  }
+
+  // Random access over the rows.  Dereferencing gives a tuple of references
+  // to the row's elements, the same as zip over the columns would.
+  template <typename SoaT>
+  class Iterator {
+   private:
+    template <typename>
+    friend class Iterator;
+    SoaT* soa_{};
+    std::ptrdiff_t index_{};
+
+   public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = std::tuple<Ts...>;
+    using difference_type = std::ptrdiff_t;
+    using reference = decltype(
+        std::declval<SoaT&>()[std::size_t{}]);
+    using pointer = ArrowProxy<reference>;
+
+    Iterator() = default;
+
+    Iterator(SoaT* soa, std::ptrdiff_t index) : soa_{soa}, index_{index} {}
+
+    // a non-const iterator converts to a const one
+    template <typename T,
+        typename = std::enable_if_t<std::is_same_v<const T, SoaT>
+                                    && !std::is_same_v<T, SoaT>>>
+    Iterator(const Iterator<T>& other)
+        : soa_{other.soa_}, index_{other.index_} {}
+
+    reference operator*() const {
+      return (*soa_)[static_cast<std::size_t>(index_)];
+    }
+
+    pointer operator->() const {
+      return {**this};
+    }
+
+    reference operator[](difference_type n) const {
+      return *(*this + n);
+    }
+
+    Iterator& operator++() {
+      ++index_;
+      return *this;
+    }
+
+    Iterator operator++(int) {
+      auto ret = *this;
+      ++*this;
+      return ret;
+    }
+
+    Iterator& operator--() {
+      --index_;
+      return *this;
+    }
+
+    Iterator operator--(int) {
+      auto ret = *this;
+      --*this;
+      return ret;
+    }
+
+    Iterator& operator+=(difference_type n) {
+      index_ += n;
+      return *this;
+    }
+
+    Iterator& operator-=(difference_type n) {
+      index_ -= n;
+      return *this;
+    }
+
+    friend Iterator operator+(Iterator it, difference_type n) {
+      return it += n;
+    }
+
+    friend Iterator operator+(difference_type n, Iterator it) {
+      return it += n;
+    }
+
+    friend Iterator operator-(Iterator it, difference_type n) {
+      return it -= n;
+    }
+
+    template <typename T>
+    difference_type operator-(const Iterator<T>& other) const {
+      return index_ - other.index_;
+    }
+
+    template <typename T>
+    bool operator==(const Iterator<T>& other) const {
+      return index_ == other.index_;
+    }
+
+    template <typename T>
+    bool operator!=(const Iterator<T>& other) const {
+      return !(*this == other);
+    }
+
+    template <typename T>
+    bool operator<(const Iterator<T>& other) const {
+      return index_ < other.index_;
+    }
+
+    template <typename T>
+    bool operator>(const Iterator<T>& other) const {
+      return other < *this;
+    }
+
+    template <typename T>
+    bool operator<=(const Iterator<T>& other) const {
+      return !(other < *this);
+    }
+
+    template <typename T>
+    bool operator>=(const Iterator<T>& other) const {
+      return !(*this < other);
+    }
+  };
+
+  using iterator = Iterator<Soa>;
+  using const_iterator = Iterator<const Soa>;
+
+  iterator begin() {
+    return {this, 0};
+  }
+
+  iterator end() {
+    return {this, static_cast<std::ptrdiff_t>(size())};
+  }
+
+  const_iterator begin() const {
+    return {this, 0};
+  }
+
+  const_iterator end() const {
+    return {this, static_cast<std::ptrdiff_t>(size())};
+  }
+
+  std::size_t size() const {
+    return std::get<0>(columns_).size();
+  }
+
+  bool empty() const {
+    return size() == 0;
+  }
+
+  std::size_t capacity() const {
+    return std::get<0>(columns_).capacity();
+  }
+
+  void reserve(std::size_t n) {
+    for_each_column([n](auto& col) { col.reserve(n); }, Indices{});
+  }
+
+  void resize(std::size_t n) {
+    if (n <= size()) {
+      for_each_column([n](auto& col) { col.resize(n); }, Indices{});
+    } else {
+      grow_columns([n](auto& col, auto) { col.resize(n); }, Indices{});
+    }
+  }
+
+  void clear() {
+    for_each_column([](auto& col) { col.clear(); }, Indices{});
+  }
+
+  void push_back(const value_type& row) {
+    push_back_tuple(row, Indices{});
+  }
+
+  void push_back(value_type&& row) {
+    push_back_tuple(std::move(row), Indices{});
+  }
+
+  // emplace_back(a, b, ...) constructs each column's new element from the
+  // corresponding argument
+  template <typename... Us>
+  void emplace_back(Us&&... us) {
+    static_assert(sizeof...(Us) == sizeof...(Ts),
+        "emplace_back takes one argument per column");
+    emplace_back_impl(Indices{}, std::forward<Us>(us)...);
+  }
+
+  void pop_back() {
+    for_each_column([](auto& col) { col.pop_back(); }, Indices{});
+  }
+
+  reference operator[](std::size_t i) {
+    return row(i, Indices{});
+  }
+
+  const_reference operator[](std::size_t i) const {
+    return row(i, Indices{});
+  }
+
+  reference front() {
+    return (*this)[0];
+  }
+
+  const_reference front() const {
+    return (*this)[0];
+  }
+
+  reference back() {
+    return (*this)[size() - 1];
+  }
+
+  const_reference back() const {
+    return (*this)[size() - 1];
+  }
+
+  // The iterators' tuples of references can't be swapped, so std::sort
+  // doesn't work on the rows.  These sort the rows instead, each column
+  // moved in turn by apply_permutation.  Equal rows keep their order.
+
+  // sort() orders the rows as tuples, sort(compare_func) compares the rows'
+  // tuples of references with compare_func
+  template <typename CompareFunc = std::less<>>
+  void sort(CompareFunc compare_func = {}) {
+    permute(SortPermutationFn{}(*this, std::move(compare_func)));
+  }
+
+  // sort_by<I>() orders the rows by the I-th column
+  template <std::size_t I, typename CompareFunc = std::less<>>
+  void sort_by(CompareFunc compare_func = {}) {
+    permute(
+        SortPermutationFn{}(std::get<I>(columns_), std::move(compare_func)));
+  }
+
+  // permute(perm) makes the new row i the old row perm[i], as
+  // apply_permutation does, and throws std::invalid_argument the same way
+  template <typename Permutation>
+  void permute(const Permutation& perm) {
+    permute_columns(perm, Indices{});
+  }
+
+  // column<I>() views the I-th column's contiguous storage
+  template <std::size_t I>
+  ColumnSpan<std::tuple_element_t<I, value_type>> column() {
+    auto& col = std::get<I>(columns_);
+    return {col.data(), col.size()};
+  }
+
+  template <std::size_t I>
+  ColumnSpan<const std::tuple_element_t<I, value_type>> column() const {
+    auto& col = std::get<I>(columns_);
+    return {col.data(), col.size()};
+  }
+
+  bool operator==(const Soa& other) const {
+    return columns_ == other.columns_;
+  }
+
+  bool operator!=(const Soa& other) const {
+    return !(*this == other);
+  }
+};
+
+#endif
@@ -0,0 +1,164 @@
+#ifndef ITER_SORT_ZIPPED_HPP_
+#define ITER_SORT_ZIPPED_HPP_
+
+#include "internal/iterbase.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <numeric>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace iter {
+  namespace impl {
+    struct SortPermutationFn;
+    struct ApplyPermutationFn;
+    struct SortZippedFn;
+
+    template <typename Container>
+    std::size_t random_access_size(Container& container) {
+      static_assert(has_random_access_iter<Container>{},
+          "sort_zipped and its helpers require random access iterables");
+      return static_cast<std::size_t>(
+          get_end(container) - get_begin(container));
+    }
+  }
+}
+
+// sort_permutation(keys) gives the indices of keys in sorted order, so
+// that keys[p[0]], keys[p[1]], ... is sorted.  Equal keys keep their
+// relative order.
+struct iter::impl::SortPermutationFn {
+  template <typename Keys, typename CompareFunc = std::less<>>
+  std::vector<std::size_t> operator()(
+      Keys&& keys, CompareFunc compare_func = {}) const {
+    std::vector<std::size_t> perm(random_access_size(keys));
+    std::iota(perm.begin(), perm.end(), std::size_t{});
+    auto first = get_begin(keys);
+    // breaking ties by index is stable without std::stable_sort's buffer
+    std::sort(perm.begin(), perm.end(), [&](std::size_t a, std::size_t b) {
+      auto&& key_a = first[static_cast<std::ptrdiff_t>(a)];
+      auto&& key_b = first[static_cast<std::ptrdiff_t>(b)];
+      if (std::invoke(compare_func, key_a, key_b)) {
+        return true;
+      }
+      if (std::invoke(compare_func, key_b, key_a)) {
+        return false;
+      }
+      return a < b;
+    });
+    return perm;
+  }
+};
+
+// apply_permutation(perm, cs...) rearranges each of cs in place so that
+// the new cs[i] is the old cs[perm[i]].  Each iterable is done in turn by
+// following the cycles of perm, so only one element is held aside at a
+// time, plus one bit per element to mark the ones already placed.  Throws
+// std::invalid_argument, before anything is moved, if perm isn't a
+// permutation of its indices or one of cs is shorter than it.
+struct iter::impl::ApplyPermutationFn {
+ private:
+  // Marks every index as seen once, or returns false if perm isn't a
+  // permutation.  Afterwards every element of seen is true.
+  template <typename Permutation>
+  static bool is_permutation(
+      const Permutation& perm, std::vector<bool>& seen) {
+    const auto n = seen.size();
+    for (auto i : perm) {
+      if (!(i < n) || seen[i]) {
+        return false;
+      }
+      seen[i] = true;
+    }
+    return true;
+  }
+
+  // An element's bit in placed is set to done once it's in place.  The
+  // bits all start as !done, so the same bits serve each iterable in turn
+  // without being cleared.
+  template <typename Permutation, typename Container>
+  static void apply_to(const Permutation& perm, std::vector<bool>& placed,
+      bool done, Container& container) {
+    using Iter = iterator_type<Container>;
+    using Value = typename std::iterator_traits<Iter>::value_type;
+    const auto n = placed.size();
+    auto at = [first = get_begin(container)](std::size_t i) -> decltype(auto) {
+      return first[static_cast<std::ptrdiff_t>(i)];
+    };
+
+    for (std::size_t start = 0; start < n; ++start) {
+      if (placed[start] == done) {
+        continue;
+      }
+      placed[start] = done;
+      if (perm[start] == start) {
+        continue;
+      }
+      Value held = std::move(at(start));
+      auto i = start;
+      for (std::size_t src = perm[i]; src != start; src = perm[i]) {
+        at(i) = std::move(at(src));
+        placed[src] = done;
+        i = src;
+      }
+      at(i) = std::move(held);
+    }
+  }
+
+ public:
+  template <typename Permutation, typename... Containers>
+  void operator()(const Permutation& perm, Containers&&... cs) const {
+    const auto n = random_access_size(perm);
+    if (!(... && (random_access_size(cs) >= n))) {
+      throw std::invalid_argument{
+          "apply_permutation: an iterable is shorter than the permutation"};
+    }
+    std::vector<bool> placed(n);
+    if (!is_permutation(perm, placed)) {
+      throw std::invalid_argument{
+          "apply_permutation: not a permutation of its indices"};
+    }
+    bool done = false;
+    (..., (apply_to(perm, placed, done, cs), done = !done));
+  }
+};
+
+// sort_zipped(keys, cs...) sorts keys and moves the elements of each of cs
+// along with them, as if the iterables were columns of one table sorted by
+// the keys column.  sort_zipped(compare_func, keys, cs...) orders the keys
+// with compare_func instead of <.
+struct iter::impl::SortZippedFn {
+ private:
+  template <typename CompareFunc, typename Keys, typename... Containers>
+  static void sort_impl(
+      CompareFunc& compare_func, Keys& keys, Containers&... cs) {
+    auto perm = SortPermutationFn{}(keys, std::ref(compare_func));
+    ApplyPermutationFn{}(perm, keys, cs...);
+  }
+
+ public:
+  template <typename T, typename... Containers>
+  void operator()(T&& t, Containers&&... cs) const {
+    if constexpr (is_iterable<T>) {
+      std::less<> compare_func;
+      sort_impl(compare_func, t, cs...);
+    } else {
+      static_assert(sizeof...(Containers) > 0,
+          "sort_zipped requires an iterable of keys");
+      sort_impl(t, cs...);
+    }
+  }
+};
+
+namespace iter {
+  inline constexpr impl::SortPermutationFn sort_permutation{};
+  inline constexpr impl::ApplyPermutationFn apply_permutation{};
+  inline constexpr impl::SortZippedFn sort_zipped{};
+}
+
+#endif
@@ -38,6 +38,7 @@ class iter::impl::SortedView {
         : container_(std::forward<ContainerT>(container)) {
       // Fill the sorted_iters_ vector with an iterator to each
       // element in the container_
+      reserve_for(sorted_iters_.get(), size_hint_of(container_));
       for (auto iter = get_begin(container_); iter != get_end(container_);
            ++iter) {
         sorted_iters_.get().push_back(iter);
@@ -58,6 +59,10 @@ class iter::impl::SortedView {
     ItIt end() {
       return sorted_iters_.end();
     }
+
+    SizeHint size_hint() const {
+      return size_hints::exactly(sorted_iters_.get().size());
+    }
   };
 
   template <typename ContainerT>
@@ -85,6 +90,7 @@ class iter::impl::SortedView {
       }
       // Fill the sorted_iters_ vector with an iterator to each
       // element in the container_
+      reserve_for(sorted_iters_.get(), size_hint_of(container_));
       for (auto iter = get_begin(container_); iter != get_end(container_);
            ++iter) {
         sorted_iters_.get().push_back(iter);
@@ -102,6 +108,8 @@ class iter::impl::SortedView {
       if (!const_sorted_iters_.empty()) {
         return;
       }
+      reserve_for(const_sorted_iters_.get(),
+          size_hint_of(std::as_const(container_)));
       for (auto iter = get_begin(std::as_const(container_));
            iter != get_end(std::as_const(container_)); ++iter) {
         const_sorted_iters_.get().push_back(iter);
@@ -140,6 +148,10 @@ class iter::impl::SortedView {
       populate_const_sorted_iters();
       return const_sorted_iters_.end();
     }
+
+    SizeHint size_hint() const {
+      return size_hint_of(std::as_const(container_));
+    }
   };
 
   friend SortedFn;
@@ -168,6 +180,10 @@ class iter::impl::SortedView {
   typename SortedItersHolder<Container>::ConstItIt end() const {
     return sorted_iters_holder_.end();
   }
+
+  SizeHint size_hint() const {
+    return sorted_iters_holder_.size_hint();
+  }
 };
 
 #endif
@@ -14,12 +14,13 @@
 
 namespace iter {
   namespace impl {
-    template <typename Func, typename Container>
+    template <typename Func, typename Container, bool Cached = false>
     class StarMapper;
 
     template <typename Func, typename TupType, std::size_t... Is>
     class TupleStarMapper;
 
+    struct CachedStarMapFn;
     struct StarMapFn;
   }
 }
@@ -28,21 +29,52 @@ namespace iter {
 // Iterators' member functions for these classes
 
 // starmap with a container_<T> where T is one of tuple, pair, array
-template <typename Func, typename Container>
+template <typename Func, typename Container, bool Cached>
 class iter::impl::StarMapper {
  private:
   mutable Func func_;
   Container container_;
 
+  template <typename ContainerT>
   using StarIterDeref =
-      decltype(std::apply(func_, std::declval<iterator_deref<Container>>()));
-  using StarIterDerefValue =
-      std::remove_cv_t<std::remove_reference_t<StarIterDeref>>;
+      decltype(std::apply(func_, std::declval<iterator_deref<ContainerT>>()));
+
+  // With Cached (starmap.cached and imap.cached), the result of the
+  // function is held until the next increment, so that dereferencing twice
+  // doesn't call the function twice.  operator* still returns what the
+  // function returns, a copy of a held value, so adaptors that keep the
+  // result past an increment (groupby) don't keep a reference into the
+  // iterator.  Results that can't be copied, and rvalue references, are
+  // returned directly instead.  Copies of an iterator don't share what it
+  // holds.
+  template <typename T, typename Value = std::remove_cv_t<T>>
+  static constexpr bool memoizes = Cached
+      && (std::is_lvalue_reference_v<T>
+             || (!std::is_reference_v<T> && std::is_copy_constructible_v<Value>
+                    && std::is_copy_assignable_v<Value>));
+
+  struct NoCache {};
+
+  // An iterator's held result, which copies of the iterator start without,
+  // so that copying an iterator never reads it
+  template <typename T>
+  class Cache : public DerefHolder<T> {
+   public:
+    Cache() = default;
+
+    Cache(const Cache&) : DerefHolder<T>{} {}
+
+    Cache& operator=(const Cache&) {
+      this->reset();
+      return *this;
+    }
+  };
 
   StarMapper(Func f, Container&& c)
       : func_(std::move(f)), container_(std::forward<Container>(c)) {}
 
   friend StarMapFn;
+  friend CachedStarMapFn;
 
  public:
   template <typename ContainerT>
@@ -50,15 +82,19 @@ class iter::impl::StarMapper {
    private:
     template <typename>
     friend class Iterator;
+    using Deref = StarIterDeref<ContainerT>;
+    static constexpr bool Memoizes = memoizes<Deref>;
+
     Func* func_;
     IteratorWrapper<ContainerT> sub_iter_;
+    std::conditional_t<Memoizes, Cache<Deref>, NoCache> cache_;
 
    public:
     using iterator_category = std::input_iterator_tag;
-    using value_type = StarIterDerefValue;
+    using value_type = std::remove_cv_t<std::remove_reference_t<Deref>>;
     using difference_type = std::ptrdiff_t;
     using pointer = value_type*;
-    using reference = StarIterDeref;
+    using reference = Deref;
 
     Iterator(Func& f, IteratorWrapper<ContainerT>&& sub_iter)
         : func_(&f), sub_iter_(std::move(sub_iter)) {}
@@ -74,6 +110,9 @@ class iter::impl::StarMapper {
     }
 
     Iterator& operator++() {
+      if constexpr (Memoizes) {
+        cache_.reset();
+      }
       ++sub_iter_;
       return *this;
     }
@@ -84,12 +123,39 @@ class iter::impl::StarMapper {
       return ret;
     }
 
-    decltype(auto) operator*() {
-      return std::apply(*func_, *sub_iter_);
+    reference operator*() {
+      if constexpr (Memoizes) {
+        if (!cache_) {
+          cache_.reset(std::apply(*func_, *sub_iter_));
+        }
+        return cache_.get();
+      } else {
+        return std::apply(*func_, *sub_iter_);
+      }
     }
 
-    auto operator->() -> ArrowProxy<decltype(**this)> {
-      return {**this};
+    auto operator->() {
+      if constexpr (Memoizes) {
+        **this;
+        return cache_.get_ptr();
+      } else {
+        return ArrowProxy<reference>{**this};
+      }
+    }
+
+    // The current result as the function returned it, without keeping a
+    // copy, for consumers such as to() that dereference each position once.
+    // A cached value is moved out, so don't dereference again until after
+    // the next increment.
+    Deref take() {
+      if constexpr (Memoizes && !std::is_reference_v<Deref>) {
+        if (cache_) {
+          Deref result = std::move(cache_.get());
+          cache_.reset();
+          return result;
+        }
+      }
+      return std::apply(*func_, *sub_iter_);
     }
   };
 
@@ -108,6 +174,10 @@ class iter::impl::StarMapper {
   Iterator<AsConst<Container>> end() const {
     return {func_, get_end(std::as_const(container_))};
   }
+
+  SizeHint size_hint() const {
+    return size_hint_of(std::as_const(container_));
+  }
 };
 
 // starmap for a tuple or pair of tuples or pairs
@@ -217,6 +287,20 @@ class iter::impl::TupleStarMapper {
   Iterator<AsConst<TupType>> end() const {
     return {func_, std::as_const(tup_), sizeof...(Is)};
   }
+
+  constexpr SizeHint size_hint() const noexcept {
+    return size_hints::exactly(sizeof...(Is));
+  }
+};
+
+// starmap.cached(func, seq) holds each result until the next increment
+struct iter::impl::CachedStarMapFn : PipeableAndBindFirst<CachedStarMapFn> {
+  template <typename Func, typename Seq>
+  StarMapper<Func, Seq, true> operator()(Func func, Seq&& sequence) const {
+    return {std::move(func), std::forward<Seq>(sequence)};
+  }
+
+  using PipeableAndBindFirst<CachedStarMapFn>::operator();
 };
 
 struct iter::impl::StarMapFn : PipeableAndBindFirst<StarMapFn> {
@@ -249,6 +333,8 @@ struct iter::impl::StarMapFn : PipeableAndBindFirst<StarMapFn> {
   }
 
   using PipeableAndBindFirst<StarMapFn>::operator();
+
+  CachedStarMapFn cached;
 };
 
 namespace iter {
@@ -1,6 +1,7 @@
 #ifndef ITER_TAKEWHILE_H_
 #define ITER_TAKEWHILE_H_
 
+#include "assume_sorted.hpp"
 #include "filter.hpp"
 #include "internal/iterator_wrapper.hpp"
 #include "internal/iterbase.hpp"
@@ -40,29 +41,50 @@ class iter::impl::Taker {
     template <typename>
     friend class Iterator;
     using Holder = DerefHolder<iterator_deref<ContainerT>>;
+    // with a sorted random access iterable, the first element failing the
+    // predicate is searched for up front and kept in stop_
+    static constexpr bool Sorted =
+        is_assumed_sorted<ContainerT>
+        && is_random_access_iter<IteratorWrapper<ContainerT>>{};
     // I want this mutable so I can use operator* reliably in the const
     // context of init_if_first_use
     mutable IteratorWrapper<ContainerT> sub_iter_;
     IteratorWrapper<ContainerT> sub_end_;
+    mutable IteratorWrapper<ContainerT> stop_;
     mutable Holder item_;
     FilterFunc* filter_func_;
 
     // see comments from filter about mutability
     void inc_sub_iter() {
       ++sub_iter_;
+      if constexpr (Sorted) {
+        if (sub_iter_ == stop_) {
+          sub_iter_ = sub_end_;
+        }
+      }
       if (sub_iter_ != sub_end_) {
         item_.reset(*sub_iter_);
       }
     }
 
     void check_current() const {
-      if (sub_iter_ != sub_end_ && !std::invoke(*filter_func_, item_.get())) {
-        sub_iter_ = sub_end_;
+      if constexpr (!Sorted) {
+        if (sub_iter_ != sub_end_
+            && !std::invoke(*filter_func_, item_.get())) {
+          sub_iter_ = sub_end_;
+        }
       }
     }
 
     void init_if_first_use() const {
       if (!item_ && sub_iter_ != sub_end_) {
+        if constexpr (Sorted) {
+          stop_ = gallop_partition_point(sub_iter_, sub_end_, *filter_func_);
+          if (sub_iter_ == stop_) {
+            sub_iter_ = sub_end_;
+            return;
+          }
+        }
         item_.reset(*sub_iter_);
         check_current();
       }
@@ -79,6 +101,7 @@ class iter::impl::Taker {
         IteratorWrapper<ContainerT>&& sub_end, FilterFunc& filter_func)
         : sub_iter_{std::move(sub_iter)},
           sub_end_{std::move(sub_end)},
+          stop_{sub_end_},
           filter_func_(&filter_func) {}
 
     typename Holder::reference operator*() {
@@ -134,6 +157,10 @@ class iter::impl::Taker {
     return {get_end(std::as_const(container_)),
         get_end(std::as_const(container_)), filter_func_};
   }
+
+  SizeHint size_hint() const {
+    return size_hints::at_most(size_hint_of(std::as_const(container_)));
+  }
 };
 
 #endif
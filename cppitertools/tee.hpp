@@ -0,0 +1,299 @@
+#ifndef ITER_TEE_HPP_
+#define ITER_TEE_HPP_
+
+#include "internal/iterator_wrapper.hpp"
+#include "internal/iterbase.hpp"
+
+#include <cstddef>
+#include <deque>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace iter {
+  namespace impl {
+    template <typename Container>
+    class Teed;
+
+    using TeeFn = IterToolFnBindSizeTSecond<Teed>;
+  }
+  inline constexpr impl::TeeFn tee{};
+}
+
+// Splits an iterable into n branches, each of which yields every element
+// of it.  Elements are taken from the underlying iterable when the branch
+// furthest ahead reaches them, and kept in a buffer of fixed size chunks.
+// A chunk is freed once every branch has moved past it, or finished, so a
+// branch that is never iterated keeps everything after it buffered.
+//
+// Branches can be iterated on different threads, each by one thread at a
+// time.  Elements are yielded as const references, into the buffer or,
+// when the underlying iterable's references stay valid, into the iterable
+// itself.  Each branch is single pass: iterating it again continues where
+// it stopped.
+template <typename Container>
+class iter::impl::Teed {
+ private:
+  static constexpr std::size_t ChunkSize = 64;
+
+  using Arg = iterator_deref<Container>;
+  static constexpr bool KeepsRefs =
+      std::is_lvalue_reference_v<Arg>
+      && is_iterator_at_least<iterator_type<Container>,
+             std::forward_iterator_tag>;
+  using Value = std::remove_cv_t<std::remove_reference_t<Arg>>;
+  using Stored = std::conditional_t<KeepsRefs, const Value*, Value>;
+
+  struct Chunk {
+    std::vector<Stored> items;
+    // branches which haven't moved past this chunk yet
+    std::size_t readers;
+  };
+
+  // The underlying iterable and the buffer, guarded by mutex_.  A branch
+  // may read the items of its chunk that it has seen under the lock
+  // without taking it again, as they are never changed or moved.
+  class Shared {
+   private:
+    Container container_;
+    std::optional<IteratorWrapper<Container>> sub_iter_;
+    std::optional<IteratorWrapper<Container>> sub_end_;
+    std::deque<Chunk> chunks_;
+    std::vector<std::vector<Stored>> spare_;
+    std::size_t first_chunk_{0};
+    std::size_t attached_;
+
+    void pop_finished_chunks() {
+      while (!chunks_.empty() && chunks_.front().readers == 0) {
+        chunks_.front().items.clear();
+        spare_.push_back(std::move(chunks_.front().items));
+        chunks_.pop_front();
+        ++first_chunk_;
+      }
+    }
+
+   public:
+    std::mutex mutex_;
+
+    Shared(Container&& container, std::size_t num_branches)
+        : container_(std::forward<Container>(container)),
+          attached_{num_branches} {}
+
+    // null if the chunk hasn't been started yet
+    Chunk* chunk(std::size_t n) {
+      auto i = n - first_chunk_;
+      return i < chunks_.size() ? &chunks_[i] : nullptr;
+    }
+
+    // Appends the next element of the underlying iterable to the buffer,
+    // and returns false if there are no more.
+    bool pull() {
+      if (!sub_iter_) {
+        sub_iter_.emplace(get_begin(container_));
+        sub_end_.emplace(get_end(container_));
+      }
+      if (*sub_iter_ == *sub_end_) {
+        return false;
+      }
+      if (chunks_.empty() || chunks_.back().items.size() == ChunkSize) {
+        std::vector<Stored> items;
+        if (!spare_.empty()) {
+          items = std::move(spare_.back());
+          spare_.pop_back();
+        }
+        items.reserve(ChunkSize);
+        chunks_.push_back({std::move(items), attached_});
+      }
+      if constexpr (KeepsRefs) {
+        chunks_.back().items.push_back(&**sub_iter_);
+      } else {
+        chunks_.back().items.push_back(Value(**sub_iter_));
+      }
+      ++*sub_iter_;
+      return true;
+    }
+
+    void leave(std::size_t n) {
+      --chunk(n)->readers;
+      pop_finished_chunks();
+    }
+
+    // a branch which has finished no longer holds any chunks
+    void detach(std::size_t n) {
+      for (auto i = n - first_chunk_; i < chunks_.size(); ++i) {
+        --chunks_[i].readers;
+      }
+      --attached_;
+      pop_finished_chunks();
+    }
+  };
+
+ public:
+  class Branch {
+   private:
+    friend class Teed;
+
+    Shared* shared_;
+    std::size_t chunk_{0};
+    std::size_t index_{0};
+    // items_[0, known_) of the current chunk have been seen under the lock
+    const Stored* items_{};
+    std::size_t known_{0};
+    bool attached_{true};
+
+    Branch(Shared& shared) : shared_{&shared} {}
+
+    // Makes sure the element at index_ of chunk_ is known, moving on to
+    // the next chunk or pulling from the underlying iterable if needed.
+    // Returns false, and detaches, at the end.
+    bool refresh() {
+      std::lock_guard<std::mutex> lock{shared_->mutex_};
+      for (;;) {
+        if (!attached_) {
+          return false;
+        }
+        auto* c = shared_->chunk(chunk_);
+        if (c && index_ < c->items.size()) {
+          items_ = c->items.data();
+          known_ = c->items.size();
+          return true;
+        }
+        if (c && index_ == ChunkSize) {
+          shared_->leave(chunk_);
+          ++chunk_;
+          index_ = 0;
+          known_ = 0;
+        } else if (!shared_->pull()) {
+          shared_->detach(chunk_);
+          attached_ = false;
+        }
+      }
+    }
+
+    bool ready() {
+      return index_ < known_ || refresh();
+    }
+
+    const Value& get() const {
+      if constexpr (KeepsRefs) {
+        return *items_[index_];
+      } else {
+        return items_[index_];
+      }
+    }
+
+   public:
+    Branch(Branch&&) = default;
+
+    class Iterator {
+     private:
+      // null at the end
+      Branch* branch_{};
+
+     public:
+      using iterator_category = std::input_iterator_tag;
+      using value_type = Value;
+      using difference_type = std::ptrdiff_t;
+      using pointer = const value_type*;
+      using reference = const value_type&;
+
+      // the end iterator
+      Iterator() = default;
+
+      Iterator(Branch& branch)
+          : branch_{branch.ready() ? &branch : nullptr} {}
+
+      reference operator*() const {
+        return branch_->get();
+      }
+
+      pointer operator->() const {
+        return &**this;
+      }
+
+      Iterator& operator++() {
+        ++branch_->index_;
+        if (!branch_->ready()) {
+          branch_ = nullptr;
+        }
+        return *this;
+      }
+
+      // The element may be freed once the branch moves past it, so a
+      // postfix increment keeps a copy of it in a proxy for *it++
+      class PostIncrement {
+       private:
+        Value value_;
+
+       public:
+        PostIncrement(const Value& value) : value_(value) {}
+        const Value& operator*() const {
+          return value_;
+        }
+      };
+
+      PostIncrement operator++(int) {
+        PostIncrement ret{**this};
+        ++*this;
+        return ret;
+      }
+
+      bool operator!=(const Iterator& other) const {
+        return branch_ != other.branch_;
+      }
+
+      bool operator==(const Iterator& other) const {
+        return !(*this != other);
+      }
+    };
+
+    Iterator begin() {
+      return {*this};
+    }
+
+    Iterator end() {
+      return {};
+    }
+  };
+
+ private:
+  // the branches refer to the shared state, so it stays put when moved
+  std::unique_ptr<Shared> shared_;
+  std::vector<Branch> branches_;
+
+  friend TeeFn;
+
+  Teed(Container&& container, std::size_t num_branches)
+      : shared_{std::make_unique<Shared>(
+          std::forward<Container>(container), num_branches)} {
+    branches_.reserve(num_branches);
+    for (std::size_t i = 0; i < num_branches; ++i) {
+      branches_.push_back(Branch{*shared_});
+    }
+  }
+
+ public:
+  Teed(Teed&&) = default;
+
+  std::size_t size() const {
+    return branches_.size();
+  }
+
+  Branch& operator[](std::size_t i) {
+    return branches_[i];
+  }
+
+  typename std::vector<Branch>::iterator begin() {
+    return branches_.begin();
+  }
+
+  typename std::vector<Branch>::iterator end() {
+    return branches_.end();
+  }
+};
+
+#endif
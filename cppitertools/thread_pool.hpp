@@ -0,0 +1,92 @@
+#ifndef ITER_THREAD_POOL_HPP_
+#define ITER_THREAD_POOL_HPP_
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace iter {
+  namespace impl {
+    class ThreadPool;
+  }
+
+  // thread_pool is a fixed set of worker threads which tools such as
+  // par_imap hand their work to
+  using thread_pool = impl::ThreadPool;
+}
+
+// Runs submitted tasks on num_threads threads, in the order they were
+// submitted.  A task must not throw.  Destroying the pool runs the tasks
+// that are still queued and then joins the threads.
+class iter::impl::ThreadPool {
+ private:
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<std::function<void()>> tasks_;
+  bool stopping_{false};
+  std::vector<std::thread> threads_;
+
+  void work() {
+    for (;;) {
+      std::function<void()> task;
+      {
+        std::unique_lock<std::mutex> lock{mutex_};
+        cv_.wait(lock, [this] { return stopping_ || !tasks_.empty(); });
+        if (tasks_.empty()) {
+          return;
+        }
+        task = std::move(tasks_.front());
+        tasks_.pop_front();
+      }
+      task();
+    }
+  }
+
+ public:
+  // 0 threads means one per hardware thread
+  explicit ThreadPool(std::size_t num_threads = 0) {
+    if (num_threads == 0) {
+      num_threads = std::thread::hardware_concurrency();
+    }
+    if (num_threads == 0) {
+      num_threads = 1;
+    }
+    threads_.reserve(num_threads);
+    for (std::size_t i = 0; i < num_threads; ++i) {
+      threads_.emplace_back([this] { work(); });
+    }
+  }
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  ~ThreadPool() {
+    {
+      std::lock_guard<std::mutex> lock{mutex_};
+      stopping_ = true;
+    }
+    cv_.notify_all();
+    for (auto&& t : threads_) {
+      t.join();
+    }
+  }
+
+  std::size_t size() const {
+    return threads_.size();
+  }
+
+  void submit(std::function<void()> task) {
+    {
+      std::lock_guard<std::mutex> lock{mutex_};
+      tasks_.push_back(std::move(task));
+    }
+    cv_.notify_one();
+  }
+};
+
+#endif
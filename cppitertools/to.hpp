@@ -0,0 +1,456 @@
+#ifndef ITER_TO_HPP_
+#define ITER_TO_HPP_
+
+#include "internal/iterbase.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <mutex>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace iter {
+  namespace impl {
+    template <typename Container>
+    struct ToFn;
+
+    template <template <typename...> class Container>
+    struct ToTemplateFn;
+
+    template <typename Container>
+    struct ParallelToFn;
+
+    template <template <typename...> class Container>
+    struct ParallelToTemplateFn;
+
+    template <typename Container>
+    struct IntoFn;
+
+    // The element type collected from an iterable whose elements are T:
+    // T without references, and pairs and tuples of references made into
+    // pairs and tuples of values, so that what's collected owns its values.
+    template <typename T, typename = void>
+    struct CollectedValue {
+      using type = std::remove_cv_t<std::remove_reference_t<T>>;
+    };
+
+    template <typename T>
+    struct CollectedValue<T,
+        std::void_t<typename std::remove_reference_t<T>::first_type,
+            typename std::remove_reference_t<T>::second_type>> {
+      using Pair = std::remove_reference_t<T>;
+      using type = std::pair<
+          std::remove_cv_t<std::remove_reference_t<typename Pair::first_type>>,
+          std::remove_cv_t<
+              std::remove_reference_t<typename Pair::second_type>>>;
+    };
+
+    template <typename... Ts>
+    struct CollectedValue<std::tuple<Ts...>> {
+      using type =
+          std::tuple<std::remove_cv_t<std::remove_reference_t<Ts>>...>;
+    };
+
+    template <typename T>
+    using collected_value = typename CollectedValue<T>::type;
+
+    // The container named by a template such as std::vector, deduced the
+    // way constructing it from a pair of iterators would deduce it.
+    template <template <typename...> class Container, typename Value,
+        typename = void>
+    struct DeduceFromIters {};
+
+    template <template <typename...> class Container, typename Value>
+    struct DeduceFromIters<Container, Value,
+        std::void_t<decltype(Container(
+            std::declval<Value*>(), std::declval<Value*>()))>> {
+      using type = decltype(
+          Container(std::declval<Value*>(), std::declval<Value*>()));
+    };
+
+    template <typename T>
+    struct AsPair {};
+
+    template <typename A, typename B>
+    struct AsPair<std::tuple<A, B>> {
+      using type = std::pair<A, B>;
+    };
+
+    // a map given tuples of two deduces its types from them as pairs
+    template <template <typename...> class Container, typename Value,
+        typename = void>
+    struct DeduceContainer
+        : DeduceFromIters<Container, typename AsPair<Value>::type> {};
+
+    template <template <typename...> class Container, typename Value>
+    struct DeduceContainer<Container, Value,
+        std::void_t<typename DeduceFromIters<Container, Value>::type>>
+        : DeduceFromIters<Container, Value> {};
+
+    template <template <typename...> class Container, typename Seq>
+    using deduced_container = typename DeduceContainer<Container,
+        collected_value<iterator_deref<Seq>>>::type;
+
+    template <typename T, typename = void>
+    struct HasEmplaceBack : std::false_type {};
+
+    template <typename T>
+    struct HasEmplaceBack<T,
+        std::void_t<decltype(std::declval<T&>().emplace_back(
+            std::declval<typename T::value_type>()))>> : std::true_type {};
+
+    template <typename T, typename = void>
+    struct HasKeyType : std::false_type {};
+
+    template <typename T>
+    struct HasKeyType<T, std::void_t<typename T::key_type>> : std::true_type {
+    };
+
+    // sequences which take a range of pointers at their end
+    template <typename T, typename = void>
+    struct HasRangeInsert : std::false_type {};
+
+    template <typename T>
+    struct HasRangeInsert<T,
+        std::void_t<decltype(std::declval<T&>().insert(std::declval<T&>().end(),
+            std::declval<const typename T::value_type*>(),
+            std::declval<const typename T::value_type*>()))>>
+        : std::negation<HasKeyType<T>> {};
+
+    template <typename T, typename = void>
+    struct HasCapacity : std::false_type {};
+
+    template <typename T>
+    struct HasCapacity<T, std::void_t<decltype(std::declval<T&>().capacity())>>
+        : std::true_type {};
+
+    template <typename T, typename = void>
+    struct HasForEach : std::false_type {};
+
+    template <typename T>
+    struct HasForEach<T, std::void_t<decltype(std::declval<T&>().for_each(
+                             std::declval<void (*)(int)>()))>>
+        : std::true_type {};
+
+    // iterables which can make the elements at positions [lo, hi) on their
+    // own, as a merge of random access iterables can, and whose size hint
+    // is then exact
+    template <typename T, typename = void>
+    struct HasForEachIn : std::false_type {};
+
+    template <typename T>
+    struct HasForEachIn<T,
+        std::void_t<decltype(std::declval<const T&>().for_each_in(
+            std::size_t{}, std::size_t{}, std::declval<void (*)(int)>()))>>
+        : std::true_type {};
+
+    // iterators which can hand over the current element, as imap's do,
+    // rather than the copy they keep for dereferencing again
+    template <typename T, typename = void>
+    struct HasTake : std::false_type {};
+
+    template <typename T>
+    struct HasTake<T, std::void_t<decltype(std::declval<T&>().take())>>
+        : std::true_type {};
+
+    template <typename Iter>
+    decltype(auto) take_from(Iter& it) {
+      if constexpr (HasTake<Iter>{}) {
+        return it.take();
+      } else {
+        return *it;
+      }
+    }
+
+    // iterables whose elements are Values in one array, as std::data finds
+    // them
+    template <typename T, typename Value, typename = void>
+    struct IsContiguousOf : std::false_type {};
+
+    template <typename T, typename Value>
+    struct IsContiguousOf<T, Value,
+        std::void_t<decltype(std::data(std::declval<T&>())),
+            decltype(std::size(std::declval<T&>()))>>
+        : std::is_same<std::remove_cv_t<std::remove_pointer_t<decltype(
+                           std::data(std::declval<T&>()))>>,
+              Value> {};
+
+    // Reserves room for the elements about to be added to a collection
+    // which already has some.  A vector grows geometrically rather than to
+    // the exact size, so that appending many small pieces stays linear.
+    template <typename Collection>
+    void reserve_more(Collection& collection, const SizeHint& hint) {
+      if constexpr (size_hints::HasReserve<Collection>{}) {
+        if (hint.lower == 0 || hint.lower == size_hints::Unbounded) {
+          return;
+        }
+        auto needed = size_hints::saturating_add(
+            static_cast<std::size_t>(collection.size()), hint.lower);
+        if constexpr (HasCapacity<Collection>{}) {
+          auto capacity = static_cast<std::size_t>(collection.capacity());
+          if (needed <= capacity) {
+            return;
+          }
+          needed = std::max(needed, size_hints::saturating_mul(capacity, 2));
+        }
+        collection.reserve(needed);
+      }
+    }
+
+    // Constructs a new element at the end of a sequence, or in a set or
+    // map, in place from args.
+    template <typename Collection, typename... Args>
+    void emplace_into(Collection& collection, Args&&... args) {
+      if constexpr (HasEmplaceBack<Collection>{}) {
+        collection.emplace_back(std::forward<Args>(args)...);
+      } else if constexpr (HasKeyType<Collection>{}) {
+        collection.emplace(std::forward<Args>(args)...);
+      } else {
+        collection.push_back(
+            typename Collection::value_type(std::forward<Args>(args)...));
+      }
+    }
+
+    // Adds an element of an iterable to the collection, or the parts of a
+    // pair or tuple when the element can't be converted whole.  An element
+    // yielded by value is moved from.
+    template <typename Collection, typename T>
+    void add_to(Collection& collection, T&& t) {
+      if constexpr (std::is_constructible_v<typename Collection::value_type,
+                        T&&>) {
+        emplace_into(collection, std::forward<T>(t));
+      } else {
+        std::apply(
+            [&collection](auto&&... parts) {
+              emplace_into(collection, std::forward<decltype(parts)>(parts)...);
+            },
+            std::forward<T>(t));
+      }
+    }
+
+    template <typename Value, typename T>
+    Value make_value(T&& t) {
+      if constexpr (std::is_constructible_v<Value, T&&>) {
+        return Value(std::forward<T>(t));
+      } else {
+        return std::make_from_tuple<Value>(std::forward<T>(t));
+      }
+    }
+
+    // Appends the elements of seq to collection, reserving room first from
+    // seq's size hint.  Contiguous elements of the collection's own type go
+    // in with one range insert, which is a single memmove when they're
+    // trivially copyable, and iterables with a for_each() member are walked
+    // with it.
+    template <typename Collection, typename Seq>
+    void collect(Collection& collection, Seq& seq) {
+      reserve_more(collection, size_hint_of(seq));
+      if constexpr (HasRangeInsert<Collection>{}
+                    && IsContiguousOf<Seq,
+                        typename Collection::value_type>{}) {
+        auto first = std::data(seq);
+        collection.insert(collection.end(), first, first + std::size(seq));
+      } else if constexpr (HasForEach<Seq>{}) {
+        seq.for_each([&collection](auto&& elem) {
+          add_to(collection, std::forward<decltype(elem)>(elem));
+        });
+      } else {
+        auto last = get_end(seq);
+        for (auto it = get_begin(seq); it != last; ++it) {
+          add_to(collection, take_from(it));
+        }
+      }
+    }
+
+    // Fills collection[i] with the ith element of seq for each i, split
+    // into one contiguous piece per thread of the pool, and waits for them.
+    // If a piece throws, the others still run to the end, then collection
+    // is shrunk back to its old size and the first piece's error rethrown.
+    template <typename Collection, typename Seq>
+    void parallel_collect(Collection& collection, Seq& seq, ThreadPool& pool) {
+      static_assert(HasForEachIn<Seq>{} || size_hints::HasRandomAccess<Seq>{},
+          "parallel collection requires a random access iterable, or a "
+          "merge of them");
+      using Value = typename Collection::value_type;
+      auto fill = [&collection](std::size_t i, auto&& elem) {
+        collection[i] = make_value<Value>(std::forward<decltype(elem)>(elem));
+      };
+      // the first iterator, taken once rather than on each thread, unless
+      // seq makes its pieces itself
+      auto first = [&seq] {
+        if constexpr (HasForEachIn<Seq>{}) {
+          return nullptr;
+        } else {
+          return get_begin(seq);
+        }
+      }();
+      std::size_t n = 0;
+      if constexpr (HasForEachIn<Seq>{}) {
+        n = size_hint_of(std::as_const(seq)).lower;
+      } else {
+        n = static_cast<std::size_t>(get_end(seq) - first);
+      }
+      auto offset = static_cast<std::size_t>(collection.size());
+      collection.resize(offset + n);
+
+      auto pieces = std::min(n, pool.size());
+      std::mutex mutex;
+      std::condition_variable done_cv;
+      std::size_t running = pieces;
+      std::vector<std::exception_ptr> errors(pieces);
+      for (std::size_t piece = 0; piece < pieces; ++piece) {
+        // splits [0, n) as evenly as possible, without overflowing
+        auto lo = n / pieces * piece + n % pieces * piece / pieces;
+        auto hi = n / pieces * (piece + 1) + n % pieces * (piece + 1) / pieces;
+        pool.submit([&, piece, lo, hi] {
+          try {
+            if constexpr (HasForEachIn<Seq>{}) {
+              auto i = offset + lo;
+              std::as_const(seq).for_each_in(
+                  lo, hi, [&fill, &i](auto&& elem) {
+                    fill(i++, std::forward<decltype(elem)>(elem));
+                  });
+            } else {
+              using Diff = typename std::iterator_traits<
+                  decltype(first)>::difference_type;
+              auto it = first + static_cast<Diff>(lo);
+              for (auto i = lo; i < hi; ++i, ++it) {
+                fill(offset + i, take_from(it));
+              }
+            }
+          } catch (...) {
+            errors[piece] = std::current_exception();
+          }
+          std::lock_guard<std::mutex> lock{mutex};
+          if (--running == 0) {
+            done_cv.notify_one();
+          }
+        });
+      }
+      {
+        std::unique_lock<std::mutex> lock{mutex};
+        done_cv.wait(lock, [&running] { return running == 0; });
+      }
+      for (auto& error : errors) {
+        if (error) {
+          collection.resize(offset);
+          std::rethrow_exception(error);
+        }
+      }
+    }
+  }
+
+  // to<std::vector<int>>() or to<std::vector>(), collecting an iterable
+  template <typename Container>
+  constexpr impl::ToFn<Container> to() noexcept {
+    return {};
+  }
+
+  template <template <typename...> class Container>
+  constexpr impl::ToTemplateFn<Container> to() noexcept {
+    return {};
+  }
+
+  // to<Container>(pool), collecting a random access iterable, or a merge of
+  // them, in parallel
+  template <typename Container>
+  constexpr impl::ParallelToFn<Container> to(impl::ThreadPool& pool) noexcept {
+    return {{}, &pool};
+  }
+
+  template <template <typename...> class Container>
+  constexpr impl::ParallelToTemplateFn<Container> to(
+      impl::ThreadPool& pool) noexcept {
+    return {{}, &pool};
+  }
+
+  // to<Container>(iterable), collecting it immediately
+  template <typename Container, typename Seq,
+      typename = std::enable_if_t<impl::is_iterable<Seq>>>
+  Container to(Seq&& seq) {
+    return impl::ToFn<Container>{}(std::forward<Seq>(seq));
+  }
+
+  template <template <typename...> class Container, typename Seq,
+      typename = std::enable_if_t<impl::is_iterable<Seq>>>
+  auto to(Seq&& seq) {
+    return impl::ToTemplateFn<Container>{}(std::forward<Seq>(seq));
+  }
+
+  // into(container), appending to a container which already exists
+  template <typename Container>
+  constexpr impl::IntoFn<Container> into(Container& container) noexcept {
+    return {{}, &container};
+  }
+}
+
+// Collects an iterable into a new Container
+template <typename Container>
+struct iter::impl::ToFn : Pipeable<ToFn<Container>> {
+  template <typename Seq>
+  Container operator()(Seq&& seq) const {
+    Container result;
+    collect(result, seq);
+    return result;
+  }
+};
+
+// Collects an iterable into the Container deduced for its elements, such as
+// a std::vector<int> from to<std::vector>() given ints
+template <template <typename...> class Container>
+struct iter::impl::ToTemplateFn : Pipeable<ToTemplateFn<Container>> {
+  template <typename Seq>
+  deduced_container<Container, Seq> operator()(Seq&& seq) const {
+    return ToFn<deduced_container<Container, Seq>>{}(seq);
+  }
+};
+
+// Collects a random access iterable into a new Container, computing its
+// elements in parallel on a thread pool.  A merge of random access iterables
+// is split at positions found by binary searches, and each piece merged on
+// its own thread.  The Container must have resize()
+// and operator[], as std::vector and std::deque do, and its elements must
+// be default constructible.  If making an element throws, the rest are
+// still made, and then the first piece's exception is rethrown.
+template <typename Container>
+struct iter::impl::ParallelToFn : Pipeable<ParallelToFn<Container>> {
+  ThreadPool* pool;
+
+  template <typename Seq>
+  Container operator()(Seq&& seq) const {
+    Container result;
+    parallel_collect(result, seq, *pool);
+    return result;
+  }
+};
+
+template <template <typename...> class Container>
+struct iter::impl::ParallelToTemplateFn
+    : Pipeable<ParallelToTemplateFn<Container>> {
+  ThreadPool* pool;
+
+  template <typename Seq>
+  deduced_container<Container, Seq> operator()(Seq&& seq) const {
+    return ParallelToFn<deduced_container<Container, Seq>>{{}, pool}(seq);
+  }
+};
+
+// Appends an iterable to a container, and returns that container
+template <typename Container>
+struct iter::impl::IntoFn : Pipeable<IntoFn<Container>> {
+  Container* container;
+
+  template <typename Seq>
+  Container& operator()(Seq&& seq) const {
+    collect(*container, seq);
+    return *container;
+  }
+};
+
+#endif
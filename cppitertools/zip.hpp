@@ -115,6 +115,18 @@ class iter::impl::Zipped {
   end() const {
     return {{get_end(std::as_const(std::get<Is>(containers_)))...}};
   }
+
+  SizeHint size_hint() const {
+    if constexpr (sizeof...(Is) == 0) {
+      return size_hints::exactly(0);
+    } else {
+      auto hint = size_hints::infinite();
+      ((hint = size_hints::min(
+            hint, size_hint_of(std::as_const(std::get<Is>(containers_))))),
+          ...);
+      return hint;
+    }
+  }
 };
 
 template <typename TupleType, std::size_t... Is>
@@ -129,6 +129,14 @@ class iter::impl::ZippedLongest {
     return {{get_end(std::as_const(std::get<Is>(containers_)))...},
         {get_end(std::as_const(std::get<Is>(containers_)))...}};
   }
+
+  SizeHint size_hint() const {
+    auto hint = size_hints::exactly(0);
+    ((hint = size_hints::max(
+          hint, size_hint_of(std::as_const(std::get<Is>(containers_))))),
+        ...);
+    return hint;
+  }
 };
 
 template <typename TupleType, std::size_t... Is>
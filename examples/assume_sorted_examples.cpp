@@ -0,0 +1,39 @@
+#include <cppitertools/assume_sorted.hpp>
+#include <cppitertools/dropwhile.hpp>
+#include <cppitertools/groupby.hpp>
+#include <cppitertools/takewhile.hpp>
+
+#include <iostream>
+#include <vector>
+
+int main() {
+    // event times, in order
+    std::vector<int> times{1, 2, 4, 5, 7, 9, 12, 12, 12, 15};
+    std::cout << "times = { ";
+    for (auto&& t : times) {
+        std::cout << t << ' ';
+    }
+    std::cout << "}\n";
+
+    // found with a search rather than by testing each time
+    std::cout << "times from 6 on: { ";
+    for (auto&& t : iter::dropwhile(
+             [](int t) { return t < 6; }, iter::assume_sorted(times))) {
+        std::cout << t << ' ';
+    }
+    std::cout << "}\n";
+
+    std::cout << "times before 6: { ";
+    for (auto&& t : times | iter::assume_sorted
+                        | iter::takewhile([](int t) { return t < 6; })) {
+        std::cout << t << ' ';
+    }
+    std::cout << "}\n";
+
+    // each group's end is searched for, so counting them is cheap
+    std::cout << "times by tens:\n";
+    for (auto&& gb : iter::groupby(
+             iter::assume_sorted(times), [](int t) { return t / 10; })) {
+        std::cout << "  " << gb.first * 10 << "s\n";
+    }
+}
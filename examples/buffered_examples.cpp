@@ -0,0 +1,17 @@
+#include <cppitertools/buffered.hpp>
+#include <cppitertools/imap.hpp>
+#include <cppitertools/range.hpp>
+
+#include <iostream>
+
+int main() {
+    auto produce = [](int i) {
+        std::cout << "producing " << i << '\n';
+        return i * i;
+    };
+
+    // the squares are produced three at a time, then used
+    for (auto i : iter::buffered(iter::imap(produce, iter::range(7)), 3)) {
+        std::cout << "  using " << i << '\n';
+    }
+}
@@ -1,5 +1,6 @@
 #include <cppitertools/compress.hpp>
 
+#include <cstdint>
 #include <vector>
 #include <iostream>
 
@@ -39,5 +40,20 @@ int main(void) {
         std::cout << i << ' ';
     }
     std::cout << "}\n";
+
+    // bit j of each word selects the element j places after its start
+    std::vector<std::uint8_t> words{0x29};
+    std::cout << "compress(ns, bitmask({0x29})): { ";
+    for (auto&& i : iter::compress(ns, iter::bitmask(words))) {
+        std::cout << i << ' ';
+    }
+    std::cout << "}\n";
+
+    std::vector<int> idx{4, 1, 1};
+    std::cout << "compress(ns, indices({4, 1, 1})): { ";
+    for (auto&& i : iter::compress(ns, iter::indices(idx))) {
+        std::cout << i << ' ';
+    }
+    std::cout << "}\n";
     
 }
@@ -55,4 +55,13 @@ int main() {
     for (auto&& i : iter::filter([] (const int i) {return i % 2;}, ns)) {
         std::cout << i << '\n';
     }
+
+    // filter.blocked tests a block of elements of a contiguous sequence at
+    // a time, which is faster for cheap predicates
+    std::vector<float> readings{0.5f, 3.25f, 1.0f, 7.5f, 2.0f, 9.0f};
+    std::cout << "readings over 3\n";
+    for (auto&& r : iter::filter.blocked([] (float r) {return r > 3;},
+                                         readings)) {
+        std::cout << r << '\n';
+    }
 }
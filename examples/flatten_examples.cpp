@@ -0,0 +1,30 @@
+#include <cppitertools/flatten.hpp>
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+int main() {
+    std::vector<std::vector<int>> jagged{{5, 1}, {}, {4, 2, 3}};
+
+    // the rows are visited in order, skipping empty ones
+    std::cout << "flatten(jagged): { ";
+    for (auto i : iter::flatten(jagged)) {
+        std::cout << i << ' ';
+    }
+    std::cout << "}\n";
+
+    // any element can be reached directly
+    auto f = iter::flatten(jagged);
+    std::cout << "size: " << f.size() << ", f[3]: " << f[3] << '\n';
+
+    // and the iterators are random access, so the whole thing can be sorted
+    std::sort(f.begin(), f.end());
+    for (auto&& row : jagged) {
+        std::cout << "{ ";
+        for (auto i : row) {
+            std::cout << i << ' ';
+        }
+        std::cout << "}\n";
+    }
+}
@@ -0,0 +1,34 @@
+#include <cppitertools/hash_join.hpp>
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+    struct User {
+        int id;
+        std::string name;
+    };
+
+    struct Order {
+        int user_id;
+        int amount;
+    };
+}
+
+int main() {
+    std::vector<User> users{{1, "ann"}, {2, "bo"}, {3, "cy"}};
+    std::vector<Order> orders{{2, 10}, {4, 20}, {1, 30}, {2, 40}};
+    auto id = [](const User& u) { return u.id; };
+    auto owner = [](const Order& o) { return o.user_id; };
+
+    // the users are put in a hash table and the orders streamed through it
+    for (auto&& [user, order] : iter::hash_join(users, orders, id, owner)) {
+        std::cout << user.name << " ordered " << order.amount << '\n';
+    }
+
+    std::cout << "piped:\n";
+    for (auto&& [user, order] : orders | iter::hash_join(users, id, owner)) {
+        std::cout << user.name << " ordered " << order.amount << '\n';
+    }
+}
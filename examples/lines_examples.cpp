@@ -0,0 +1,32 @@
+#include <cppitertools/enumerate.hpp>
+#include <cppitertools/filter.hpp>
+#include <cppitertools/lines.hpp>
+
+#include <fstream>
+#include <iostream>
+#include <string_view>
+
+int main() {
+    {
+        std::ofstream out("lines_example.txt");
+        out << "starting up\nerror: disk full\nretrying\nerror: still full\n";
+    }
+
+    // each line is a string_view into the file, nothing is copied
+    for (auto&& line : iter::lines("lines_example.txt")) {
+        std::cout << line.size() << ": " << line << '\n';
+    }
+
+    // and lines works with the rest of the tools
+    auto is_error = [](std::string_view line) {
+        return line.substr(0, 6) == "error:";
+    };
+    auto errors = iter::lines("lines_example.txt") | iter::filter(is_error);
+    for (auto&& [i, line] : iter::enumerate(errors)) {
+        std::cout << "error #" << i << ": " << line << '\n';
+    }
+
+    // a file that can't be opened has no lines, and says why
+    auto missing = iter::lines("no_such_file.txt");
+    std::cout << "missing file: " << missing.error().message() << '\n';
+}
@@ -0,0 +1,23 @@
+#include <cppitertools/linspace.hpp>
+
+#include <iostream>
+
+int main() {
+    // five values from 0 to 1, both ends included
+    std::cout << "linspace(0.0, 1.0, 5): { ";
+    for (auto d : iter::linspace(0.0, 1.0, 5)) {
+        std::cout << d << ' ';
+    }
+    std::cout << "}\n";
+
+    // the values can be processed a fixed number at a time, where each
+    // group is held in contiguous storage
+    std::cout << "linspace(0.0, 1.0, 11).blocks<4>():\n";
+    for (auto&& block : iter::linspace(0.0, 1.0, 11).blocks<4>()) {
+        std::cout << "  { ";
+        for (auto d : block) {
+            std::cout << d << ' ';
+        }
+        std::cout << "}\n";
+    }
+}
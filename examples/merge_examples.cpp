@@ -0,0 +1,34 @@
+#include <cppitertools/merge.hpp>
+
+#include <functional>
+#include <iostream>
+#include <list>
+#include <vector>
+
+int main() {
+    // merging sorted iterables gives a sorted sequence
+    std::vector<int> a{1, 4, 7, 10};
+    std::list<int> b{2, 3, 8};
+    std::cout << "merge(a, b): { ";
+    for (auto i : iter::merge(a, b)) {
+        std::cout << i << ' ';
+    }
+    std::cout << "}\n";
+
+    // the iterables can be sorted by something other than <
+    std::vector<int> c{9, 5, 1};
+    std::vector<int> d{8, 2};
+    std::cout << "merge(std::greater<>{}, c, d): { ";
+    for (auto i : iter::merge(std::greater<>{}, c, d)) {
+        std::cout << i << ' ';
+    }
+    std::cout << "}\n";
+
+    // any number of sorted iterables held in another iterable
+    std::vector<std::vector<int>> shards{{3, 8}, {1, 9}, {}, {2, 4, 5}};
+    std::cout << "merge.from_iterable(shards): { ";
+    for (auto i : iter::merge.from_iterable(shards)) {
+        std::cout << i << ' ';
+    }
+    std::cout << "}\n";
+}
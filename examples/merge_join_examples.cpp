@@ -0,0 +1,23 @@
+#include <cppitertools/merge_join.hpp>
+
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+int main() {
+    // both sorted by their first element
+    std::vector<std::pair<int, char>> left{{1, 'a'}, {2, 'b'}, {2, 'c'}};
+    std::vector<std::pair<int, std::string>> right{
+        {0, "w"}, {2, "x"}, {2, "y"}, {3, "z"}};
+    auto key = [](const auto& p) { return p.first; };
+
+    for (auto&& [l, r] : iter::merge_join(left, right, key, key)) {
+        std::cout << l.first << ": " << l.second << ' ' << r.second << '\n';
+    }
+
+    std::cout << "piped:\n";
+    for (auto&& [l, r] : left | iter::merge_join(right, key, key)) {
+        std::cout << l.first << ": " << l.second << ' ' << r.second << '\n';
+    }
+}
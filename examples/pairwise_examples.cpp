@@ -0,0 +1,21 @@
+#include <cppitertools/pairwise.hpp>
+#include <cppitertools/sliding_window.hpp>
+
+#include <iostream>
+#include <vector>
+
+int main() {
+    std::vector<long> timestamps{100, 130, 170, 180, 240};
+
+    std::cout << "deltas: ";
+    for (auto [prev, next] : iter::pairwise(timestamps)) {
+        std::cout << next - prev << ' ';
+    }
+    std::cout << '\n';
+
+    std::cout << "moving averages of 3: ";
+    for (auto [a, b, c] : timestamps | iter::sliding_window.fixed<3>) {
+        std::cout << (a + b + c) / 3 << ' ';
+    }
+    std::cout << '\n';
+}
@@ -0,0 +1,40 @@
+#include <cppitertools/par_imap.hpp>
+#include <cppitertools/range.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+
+int main() {
+    using namespace std::chrono_literals;
+    auto slow_square = [](int i) {
+        std::this_thread::sleep_for(10ms);
+        return i * i;
+    };
+
+    // the squares are computed 4 at a time, and printed in order
+    iter::thread_pool pool{4};
+    auto start = std::chrono::steady_clock::now();
+    for (auto i : iter::range(20) | iter::par_imap(slow_square, pool)) {
+        std::cout << i << ' ';
+    }
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start);
+    std::cout << "\nabout " << ms.count() << "ms rather than 200ms\n";
+
+    // exceptions are rethrown when their element is reached
+    auto fails = [](int i) {
+        if (i == 3) {
+            throw std::runtime_error{"failed on 3"};
+        }
+        return i;
+    };
+    try {
+        for (auto i : iter::par_imap(fails, iter::range(10), pool, 2)) {
+            std::cout << i << ' ';
+        }
+    } catch (const std::runtime_error& e) {
+        std::cout << "caught: " << e.what() << '\n';
+    }
+}
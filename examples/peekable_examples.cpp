@@ -0,0 +1,23 @@
+#include <cppitertools/peekable.hpp>
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+int main() {
+    // merge runs of repeated words, looking ahead to see where a run ends
+    std::vector<std::string> words{"a", "a", "b", "c", "c", "c"};
+    auto p = iter::peekable(words);
+    for (auto it = p.begin(); it != p.end(); ++it) {
+        int count = 1;
+        while (it.peek() && *it.peek() == *it) {
+            ++it;
+            ++count;
+        }
+        std::cout << *it << " x" << count << '\n';
+    }
+
+    // peek further ahead
+    auto it = p.begin();
+    std::cout << "third word is " << *it.peek(2) << '\n';
+}
@@ -0,0 +1,43 @@
+#include <cppitertools/filter.hpp>
+#include <cppitertools/imap.hpp>
+#include <cppitertools/pipeline.hpp>
+#include <cppitertools/range.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+int main() {
+    using namespace std::chrono_literals;
+    auto slow_square = [](int i) {
+        std::this_thread::sleep_for(5ms);
+        return i * i;
+    };
+    auto slow_is_odd = [](int i) {
+        std::this_thread::sleep_for(5ms);
+        return i % 2 == 1;
+    };
+
+    // squaring runs on 4 threads, filtering on 2 more, and the output
+    // stays in order
+    auto start = std::chrono::steady_clock::now();
+    auto odd_squares = iter::range(40) | iter::stage(iter::imap(slow_square), 4)
+                       | iter::stage(iter::filter(slow_is_odd), 2);
+    for (auto i : odd_squares) {
+        std::cout << i << ' ';
+    }
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start);
+    std::cout << "\nabout " << ms.count() << "ms rather than 400ms\n";
+
+    auto stats = odd_squares.stats();
+    std::cout << "filter stage: " << stats.items_in << " in, "
+              << stats.items_out << " out\n";
+
+    // unordered output comes as soon as it's ready
+    for (auto i : iter::range(10) | iter::unordered_stage(
+                                        iter::imap(slow_square), 3)) {
+        std::cout << i << ' ';
+    }
+    std::cout << '\n';
+}
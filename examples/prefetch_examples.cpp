@@ -0,0 +1,41 @@
+#include <cppitertools/imap.hpp>
+#include <cppitertools/prefetch.hpp>
+#include <cppitertools/range.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+
+int main() {
+    using namespace std::chrono_literals;
+    auto slow_square = [](int i) {
+        std::this_thread::sleep_for(10ms);
+        return i * i;
+    };
+
+    // the squares are computed on another thread while this one prints
+    auto start = std::chrono::steady_clock::now();
+    for (auto i : iter::range(20) | iter::imap(slow_square) | iter::prefetch(4)) {
+        std::this_thread::sleep_for(10ms);
+        std::cout << i << ' ';
+    }
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start);
+    std::cout << "\nabout " << ms.count() << "ms rather than 400ms\n";
+
+    // exceptions thrown on the background thread reach the loop
+    auto fails = [](int i) {
+        if (i == 3) {
+            throw std::runtime_error{"failed on 3"};
+        }
+        return i;
+    };
+    try {
+        for (auto i : iter::prefetch(iter::imap(fails, iter::range(5)), 2)) {
+            std::cout << i << ' ';
+        }
+    } catch (const std::runtime_error& e) {
+        std::cout << "caught: " << e.what() << '\n';
+    }
+}
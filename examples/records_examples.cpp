@@ -0,0 +1,29 @@
+#include <cppitertools/filter.hpp>
+#include <cppitertools/records.hpp>
+
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+
+struct Trade {
+    std::int64_t id;
+    double price;
+};
+
+int main() {
+    {
+        Trade trades[] = {{1, 10.0}, {2, 99.5}, {3, 120.25}};
+        std::ofstream out("records_example.bin", std::ios::binary);
+        out.write(reinterpret_cast<const char*>(trades), sizeof(trades));
+    }
+
+    // the records are read in place from the file
+    auto trades = iter::records<Trade>("records_example.bin");
+    std::cout << trades.size() << " trades, the last has id "
+              << trades[trades.size() - 1].id << '\n';
+
+    for (const Trade& t :
+        trades | iter::filter([](const Trade& t) { return t.price > 50; })) {
+        std::cout << t.id << ": " << t.price << '\n';
+    }
+}
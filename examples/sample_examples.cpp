@@ -0,0 +1,27 @@
+#include <cppitertools/range.hpp>
+#include <cppitertools/sample.hpp>
+
+#include <iostream>
+#include <random>
+#include <vector>
+
+int main() {
+    std::vector<int> rows;
+    for (auto i : iter::range(1000000)) {
+        rows.push_back(i);
+    }
+    std::mt19937 rng{std::random_device{}()};
+
+    std::cout << "ten uniformly chosen rows: ";
+    for (auto&& i : iter::sample(rows, 10, rng)) {
+        std::cout << i << ' ';
+    }
+    std::cout << '\n';
+
+    int n = 0;
+    for (auto&& i : rows | iter::sample_rate(0.001, rng)) {
+        (void)i;
+        ++n;
+    }
+    std::cout << "about one row in a thousand: " << n << " rows\n";
+}
@@ -0,0 +1,43 @@
+#include <cppitertools/set_operations.hpp>
+
+#include <iostream>
+#include <vector>
+
+int main() {
+    // sorted lists of the documents containing each word
+    std::vector<int> apple{1, 3, 4, 7, 9, 12};
+    std::vector<int> banana{3, 7, 8, 9};
+    std::vector<int> cherry{0, 3, 5, 7, 9, 11};
+
+    std::cout << "documents with all three: { ";
+    for (auto&& d : iter::set_intersection(apple, banana, cherry)) {
+        std::cout << d << ' ';
+    }
+    std::cout << "}\n";
+
+    std::cout << "documents with any: { ";
+    for (auto&& d : iter::set_union(apple, banana, cherry)) {
+        std::cout << d << ' ';
+    }
+    std::cout << "}\n";
+
+    std::cout << "apple but not banana or cherry: { ";
+    for (auto&& d : iter::set_difference(apple, banana, cherry)) {
+        std::cout << d << ' ';
+    }
+    std::cout << "}\n";
+
+    std::cout << "apple or banana but not both: { ";
+    for (auto&& d : iter::set_symmetric_difference(apple, banana)) {
+        std::cout << d << ' ';
+    }
+    std::cout << "}\n";
+
+    // any number of lists, chosen at run time
+    std::vector<std::vector<int>> postings{apple, banana, cherry};
+    std::cout << "from_iterable: { ";
+    for (auto&& d : postings | iter::set_intersection.from_iterable) {
+        std::cout << d << ' ';
+    }
+    std::cout << "}\n";
+}
@@ -0,0 +1,41 @@
+#include <cppitertools/filter.hpp>
+#include <cppitertools/range.hpp>
+#include <cppitertools/shared_source.hpp>
+
+#include <atomic>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+int main() {
+    // four threads sum the multiples of 3 below a million between them
+    auto multiples = iter::filter([](int i) { return i % 3 == 0; },
+                                  iter::range(1000000));
+    auto source = iter::shared_source(multiples, 1024);
+    std::atomic<long long> total{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&] {
+            long long sum = 0;
+            for (auto i : source) {
+                sum += i;
+            }
+            total += sum;
+        });
+    }
+    for (auto&& t : threads) {
+        t.join();
+    }
+    std::cout << "total: " << total << '\n';
+
+    // batches can also be claimed one at a time
+    std::vector<int> v{1, 2, 3, 4, 5};
+    auto batches = iter::shared_source(v, 2);
+    for (auto batch = batches.claim(); !batch.empty();
+         batch = batches.claim()) {
+        for (auto i : batch) {
+            std::cout << i << ' ';
+        }
+        std::cout << '\n';
+    }
+}
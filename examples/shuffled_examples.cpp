@@ -0,0 +1,27 @@
+#include <cppitertools/range.hpp>
+#include <cppitertools/shuffled.hpp>
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+int main() {
+    std::vector<std::string> names{"ann", "bo", "cy", "dee", "ed", "flo"};
+    std::cout << "shuffled: ";
+    for (auto&& name : iter::shuffled(names, 2024)) {
+        std::cout << name << ' ';
+    }
+    std::cout << '\n';
+
+    // a random order over ten billion keys, in constant memory
+    auto keys = iter::shuffled(iter::range(10'000'000'000LL), 7);
+    for (std::size_t worker = 0; worker < 3; ++worker) {
+        auto shard = keys.shard(worker, 3);
+        std::cout << "worker " << worker << " starts with";
+        auto it = shard.begin();
+        for (int i = 0; i < 3; ++i, ++it) {
+            std::cout << ' ' << *it;
+        }
+        std::cout << " of its " << shard.size() << " keys\n";
+    }
+}
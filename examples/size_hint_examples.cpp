@@ -0,0 +1,37 @@
+#include <cppitertools/itertools.hpp>
+
+#include <iostream>
+#include <vector>
+
+namespace {
+    void print(const char* name, iter::SizeHint hint) {
+        std::cout << name << ": at least " << hint.lower;
+        if (hint.upper) {
+            std::cout << ", at most " << *hint.upper;
+        }
+        std::cout << '\n';
+    }
+}
+
+int main() {
+    std::vector<int> v{1, 2, 3, 4, 5, 6, 7};
+    auto odd = [](int i) { return i % 2 == 1; };
+
+    print("enumerate", iter::size_hint(iter::enumerate(v)));
+    print("filter", iter::size_hint(iter::filter(odd, v)));
+    print("chunked by 3", iter::size_hint(iter::chunked(v, 3)));
+    print("combinations of 3", iter::size_hint(iter::combinations(v, 3)));
+    print("zip with range(4)", iter::size_hint(iter::zip(v, iter::range(4))));
+    print("cycle", iter::size_hint(iter::cycle(v)));
+
+    // an exact hint can size a buffer before anything is iterated
+    auto windows = iter::sliding_window(v, 3);
+    std::vector<int> sums;
+    if (auto n = iter::size_hint(windows).exact()) {
+        sums.reserve(*n);
+    }
+    for (auto&& w : windows) {
+        sums.push_back(w[0] + w[1] + w[2]);
+    }
+    std::cout << sums.size() << " window sums\n";
+}
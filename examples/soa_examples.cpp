@@ -0,0 +1,31 @@
+#include <cppitertools/soa.hpp>
+#include <cppitertools/zip.hpp>
+
+#include <iostream>
+#include <numeric>
+#include <string>
+
+int main() {
+    // each column is stored in its own vector
+    iter::soa<int, double, std::string> table;
+    table.reserve(3);
+    table.emplace_back(1, 2.5, "one");
+    table.emplace_back(2, 3.5, "two");
+    table.push_back({3, 4.5, "three"});
+
+    // but rows can be used as a unit
+    for (auto&& [id, x, name] : table) {
+        x *= 2;
+        std::cout << id << ' ' << x << ' ' << name << '\n';
+    }
+
+    // a single column can be processed on its own
+    auto xs = table.column<1>();
+    std::cout << "sum of x: " << std::accumulate(xs.begin(), xs.end(), 0.0)
+              << '\n';
+
+    // and columns can be zipped back together
+    for (auto&& [id, name] : iter::zip(table.column<0>(), table.column<2>())) {
+        std::cout << id << ": " << name << '\n';
+    }
+}
@@ -0,0 +1,28 @@
+#include <cppitertools/sort_zipped.hpp>
+#include <cppitertools/zip.hpp>
+
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+int main() {
+    std::vector<int> ids{3, 1, 2};
+    std::vector<std::string> names{"three", "one", "two"};
+    std::vector<double> prices{3.5, 1.5, 2.5};
+
+    // sorts ids, and moves the other columns along with it
+    iter::sort_zipped(ids, names, prices);
+    std::cout << "sorted by id:\n";
+    for (auto&& [id, name, price] : iter::zip(ids, names, prices)) {
+        std::cout << id << ' ' << name << ' ' << price << '\n';
+    }
+
+    // the order can be computed once and applied to each column
+    auto perm = iter::sort_permutation(prices, std::greater<>{});
+    iter::apply_permutation(perm, ids, names, prices);
+    std::cout << "most expensive first:\n";
+    for (auto&& [id, name, price] : iter::zip(ids, names, prices)) {
+        std::cout << id << ' ' << name << ' ' << price << '\n';
+    }
+}
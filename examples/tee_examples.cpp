@@ -0,0 +1,40 @@
+#include <cppitertools/imap.hpp>
+#include <cppitertools/range.hpp>
+#include <cppitertools/tee.hpp>
+
+#include <iostream>
+#include <thread>
+
+int main() {
+    auto square = [](int i) {
+        std::cout << "(squaring " << i << ") ";
+        return i * i;
+    };
+
+    // each square is computed once, and seen by both branches
+    auto branches = iter::tee(iter::imap(square, iter::range(5)), 2);
+    for (auto i : branches[0]) {
+        std::cout << i << ' ';
+    }
+    std::cout << '\n';
+    for (auto i : branches[1]) {
+        std::cout << i << ' ';
+    }
+    std::cout << '\n';
+
+    // branches can be consumed on different threads
+    long sum = 0;
+    long count = 0;
+    auto parts = iter::range(100000) | iter::tee(2);
+    std::thread summer{[&] {
+        for (auto i : parts[0]) {
+            sum += i;
+        }
+    }};
+    for (auto&& i : parts[1]) {
+        (void)i;
+        ++count;
+    }
+    summer.join();
+    std::cout << "sum " << sum << " of " << count << " numbers\n";
+}
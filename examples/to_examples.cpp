@@ -0,0 +1,44 @@
+#include <cppitertools/enumerate.hpp>
+#include <cppitertools/imap.hpp>
+#include <cppitertools/range.hpp>
+#include <cppitertools/shuffled.hpp>
+#include <cppitertools/to.hpp>
+
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+int main() {
+    std::vector<std::string> words{"apple", "fig", "banana", "kiwi"};
+
+    // the vector's element type is deduced, and the strings made by imap
+    // are moved into it rather than copied
+    auto shouted = iter::imap([](const std::string& w) { return w + "!"; },
+                       words)
+                   | iter::to<std::vector>();
+    for (auto&& w : shouted) {
+        std::cout << w << ' ';
+    }
+    std::cout << '\n';
+
+    // pairs from enumerate become the map's entries
+    auto by_index = iter::enumerate(words) | iter::to<std::map>();
+    std::cout << "word 2 is " << by_index.at(2) << '\n';
+
+    // into appends to a container which already exists
+    std::vector<int> lengths{0};
+    iter::imap([](const std::string& w) { return static_cast<int>(w.size()); },
+        words) | iter::into(lengths);
+    iter::range(3) | iter::into(lengths);
+    for (auto n : lengths) {
+        std::cout << n << ' ';
+    }
+    std::cout << '\n';
+
+    // a random access iterable can be collected on a thread pool
+    iter::thread_pool pool;
+    auto order = iter::shuffled(iter::range(1000000), 42)
+                 | iter::to<std::vector>(pool);
+    std::cout << "first of the shuffled order: " << order.front() << '\n';
+}
@@ -0,0 +1,62 @@
+#include <cppitertools/assume_sorted.hpp>
+
+#include "helpers.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <list>
+#include <vector>
+
+#include "catch.hpp"
+
+using iter::assume_sorted;
+using Vec = const std::vector<int>;
+
+TEST_CASE("assume_sorted: yields the elements unchanged", "[assume_sorted]") {
+  Vec ns{1, 3, 5};
+  auto s = assume_sorted(ns);
+  Vec v(std::begin(s), std::end(s));
+  REQUIRE(v == ns);
+  REQUIRE(std::begin(s) == std::begin(ns));
+}
+
+TEST_CASE("assume_sorted: const iteration", "[assume_sorted][const]") {
+  std::list<int> ls{1, 3, 5};
+  const auto s = ls | assume_sorted;
+  Vec v(std::begin(s), std::end(s));
+  Vec vc{1, 3, 5};
+  REQUIRE(v == vc);
+}
+
+TEST_CASE("assume_sorted: binds to lvalues, moves rvalues",
+    "[assume_sorted]") {
+  itertest::BasicIterable<int> bi{1, 2};
+  SECTION("binds to lvalues") {
+    assume_sorted(bi);
+    REQUIRE_FALSE(bi.was_moved_from());
+  }
+  SECTION("moves rvalues") {
+    assume_sorted(std::move(bi));
+    REQUIRE(bi.was_moved_from());
+  }
+}
+
+TEST_CASE("assume_sorted: galloping search", "[assume_sorted]") {
+  std::vector<int> ns(1000);
+  for (std::size_t i = 0; i < ns.size(); ++i) {
+    ns[i] = static_cast<int>(i);
+  }
+  for (int limit : {0, 1, 2, 3, 7, 8, 500, 999, 1000, 2000}) {
+    int calls = 0;
+    auto pred = [&calls, limit](int n) {
+      ++calls;
+      return n < limit;
+    };
+    auto it = iter::impl::gallop_partition_point(ns.begin(), ns.end(), pred);
+    REQUIRE(it - ns.begin() == std::min(limit, 1000));
+    REQUIRE(calls <= 25);
+  }
+  auto none = [](int) { return true; };
+  REQUIRE(iter::impl::gallop_partition_point(ns.begin(), ns.begin(), none)
+          == ns.begin());
+}
@@ -0,0 +1,105 @@
+#include <cppitertools/buffered.hpp>
+#include <cppitertools/imap.hpp>
+#include <cppitertools/range.hpp>
+
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "catch.hpp"
+#include "helpers.hpp"
+
+using iter::buffered;
+using Vec = const std::vector<int>;
+
+TEST_CASE("buffered: yields the same elements in order", "[buffered]") {
+  Vec ns{1, 2, 3, 4, 5, 6, 7};
+  for (std::size_t buffer_size : {1u, 2u, 3u, 7u, 100u}) {
+    std::vector<int> v;
+    SECTION("Normal call " + std::to_string(buffer_size)) {
+      auto b = buffered(ns, buffer_size);
+      v.assign(std::begin(b), std::end(b));
+      REQUIRE(v == ns);
+    }
+    SECTION("Pipe " + std::to_string(buffer_size)) {
+      auto b = ns | buffered(buffer_size);
+      v.assign(std::begin(b), std::end(b));
+      REQUIRE(v == ns);
+    }
+  }
+}
+
+TEST_CASE("buffered: pulls from the underlying iterable in batches",
+    "[buffered]") {
+  std::vector<std::string> events;
+  auto b = buffered(iter::imap(
+                        [&events](int i) {
+                          events.push_back("pull " + std::to_string(i));
+                          return i;
+                        },
+                        iter::range(5)),
+      2);
+  for (auto i : b) {
+    events.push_back("use " + std::to_string(i));
+  }
+  const std::vector<std::string> expected{"pull 0", "pull 1", "use 0",
+      "use 1", "pull 2", "pull 3", "use 2", "use 3", "pull 4", "use 4"};
+  REQUIRE(events == expected);
+}
+
+TEST_CASE("buffered: empty iterable", "[buffered]") {
+  std::vector<int> ns;
+  auto b = buffered(ns, 3);
+  REQUIRE(std::begin(b) == std::end(b));
+}
+
+TEST_CASE("buffered: postfix ++ keeps the old element", "[buffered]") {
+  std::vector<std::string> strs{"a", "b", "c"};
+  auto b = buffered(strs, 1);
+  auto it = std::begin(b);
+  REQUIRE(*it++ == "a");
+  REQUIRE(*it == "b");
+  REQUIRE(it->size() == 1);
+}
+
+TEST_CASE("buffered: works with different begin and end types",
+    "[buffered]") {
+  CharRange cr{'e'};
+  auto b = buffered(cr, 3);
+  std::string s(std::begin(b), std::end(b));
+  REQUIRE(s == "abcd");
+}
+
+TEST_CASE("buffered: const iteration", "[buffered][const]") {
+  std::vector<int> ns{1, 2, 3};
+  const auto b = buffered(ns, 2);
+  Vec v(std::begin(b), std::end(b));
+  REQUIRE(v == ns);
+}
+
+TEST_CASE("buffered: binds reference to lvalue and moves rvalue",
+    "[buffered]") {
+  itertest::BasicIterable<int> bi{1, 2};
+  SECTION("binds to lvalues") {
+    buffered(bi, 2);
+    REQUIRE_FALSE(bi.was_moved_from());
+  }
+  SECTION("moves rvalues") {
+    buffered(std::move(bi), 2);
+    REQUIRE(bi.was_moved_from());
+  }
+}
+
+TEST_CASE("buffered: iterator meets requirements", "[buffered]") {
+  std::vector<int> ns{};
+  auto b = buffered(ns, 2);
+  REQUIRE(itertest::IsIterator<decltype(std::begin(b))>::value);
+}
+
+template <typename T>
+using ImpT = decltype(buffered(std::declval<T>(), 1));
+TEST_CASE("buffered: has correct ctor and assign ops", "[buffered]") {
+  REQUIRE(itertest::IsMoveConstructibleOnly<ImpT<std::vector<int>&>>::value);
+  REQUIRE(itertest::IsMoveConstructibleOnly<ImpT<std::vector<int>>>::value);
+}
@@ -1,9 +1,13 @@
 #include <cppitertools/chain.hpp>
+#include <cppitertools/imap.hpp>
 #include "helpers.hpp"
 
+#include <algorithm>
+#include <forward_list>
 #include <iterator>
 #include <list>
 #include <string>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -201,6 +205,72 @@ TEST_CASE("chain: iterator meets requirements", "[chain]") {
   REQUIRE(itertest::IsIterator<decltype(std::begin(c))>::value);
 }
 
+TEST_CASE("chain: for_each visits every element in order", "[chain]") {
+  std::string s1{"abc"};
+  std::list<char> li{'m', 'n', 'o'};
+  std::string emp;
+  CharRange cr('c');
+  auto ch = chain(s1, emp, li, cr);
+
+  std::vector<char> v;
+  ch.for_each([&v](char c) { v.push_back(c); });
+  Vec vc{'a', 'b', 'c', 'm', 'n', 'o', 'a', 'b'};
+
+  REQUIRE(v == vc);
+}
+
+TEST_CASE("chain: for_each returns the function", "[chain]") {
+  std::vector<int> a{1, 2, 3};
+  std::vector<int> b{4, 5};
+  const auto ch = chain(a, b);
+  struct Summer {
+    int total = 0;
+    void operator()(int i) {
+      total += i;
+    }
+  };
+  REQUIRE(ch.for_each(Summer{}).total == 15);
+}
+
+TEST_CASE("chain: for_each can modify elements", "[chain]") {
+  std::vector<int> a{1, 2, 3};
+  std::list<int> b{4, 5};
+  chain(a, b).for_each([](int& i) { i *= 10; });
+  REQUIRE(a == std::vector<int>{10, 20, 30});
+  REQUIRE(b == std::list<int>{40, 50});
+}
+
+TEST_CASE("chain: for_each_segment passes each iterable", "[chain]") {
+  std::string s1{"abc"};
+  std::vector<char> vec{'x', 'y'};
+  std::list<char> li{'m'};
+  auto ch = chain(s1, vec, li);
+
+  std::vector<char> v;
+  std::vector<std::size_t> sizes;
+  ch.for_each_segment([&](auto& segment) {
+    sizes.push_back(segment.size());
+    std::copy(std::begin(segment), std::end(segment), std::back_inserter(v));
+  });
+
+  Vec vc{'a', 'b', 'c', 'x', 'y', 'm'};
+  REQUIRE(v == vc);
+  REQUIRE(sizes == std::vector<std::size_t>{3, 2, 1});
+}
+
+TEST_CASE("chain: for_each_segment on a const chain gives const iterables",
+    "[chain][const]") {
+  std::string s1{"abc"};
+  const auto ch = chain(s1, std::string{"de"});
+  std::size_t total = 0;
+  ch.for_each_segment([&total](auto& segment) {
+    static_assert(
+        std::is_const_v<std::remove_reference_t<decltype(segment)>>);
+    total += segment.size();
+  });
+  REQUIRE(total == 5);
+}
+
 template <typename... Ts>
 using ImpT = decltype(chain(std::declval<Ts>()...));
 TEST_CASE("chain: has correct ctor and assign ops", "[chain]") {
@@ -347,6 +417,94 @@ TEST_CASE("chain.from_iterable: iterator meets requirements",
   REQUIRE(itertest::IsIterator<decltype(std::begin(c))>::value);
 }
 
+TEST_CASE("chain.from_iterable: for_each visits every element in order",
+    "[chain.from_iterable]") {
+  std::vector<std::vector<int>> ivv{{}, {2, 4}, {}, {6}, {8, 10}, {}};
+  std::vector<int> v;
+  chain.from_iterable(ivv).for_each([&v](int i) { v.push_back(i); });
+  const std::vector<int> vc = {2, 4, 6, 8, 10};
+  REQUIRE(v == vc);
+}
+
+TEST_CASE("chain.from_iterable: for_each works with sub iterable values",
+    "[chain.from_iterable]") {
+  std::vector<int> ns{2, 0, 3};
+  auto ch = chain.from_iterable(
+      iter::imap([](int n) { return std::string(n, 'a' + n); }, ns));
+  std::string s;
+  ch.for_each([&s](char c) { s.push_back(c); });
+  REQUIRE(s == "ccddd");
+}
+
+TEST_CASE("chain.from_iterable: for_each_segment passes each sub iterable",
+    "[chain.from_iterable]") {
+  std::vector<std::vector<int>> ivv{{1, 2, 3}, {}, {4, 5}};
+  const auto ch = chain.from_iterable(ivv);
+  std::vector<std::size_t> sizes;
+  std::vector<int> v;
+  ch.for_each_segment([&](const std::vector<int>& segment) {
+    sizes.push_back(segment.size());
+    std::copy(segment.begin(), segment.end(), std::back_inserter(v));
+  });
+  REQUIRE(sizes == std::vector<std::size_t>{3, 0, 2});
+  REQUIRE(v == std::vector<int>{1, 2, 3, 4, 5});
+}
+
+TEST_CASE("chain.from_iterable: iterator category depends on both levels",
+    "[chain.from_iterable]") {
+  std::vector<std::vector<int>> ivv;
+  std::list<std::forward_list<int>> lfl;
+  std::vector<int> ns;
+  auto made = chain.from_iterable(
+      iter::imap([](int n) { return std::vector<int>(n); }, ns));
+
+  using VecIt = decltype(chain.from_iterable(ivv).begin());
+  using ForwardIt = decltype(chain.from_iterable(lfl).begin());
+  using MadeIt = decltype(made.begin());
+
+  REQUIRE(std::is_same_v<std::iterator_traits<VecIt>::iterator_category,
+      std::bidirectional_iterator_tag>);
+  REQUIRE(std::is_same_v<std::iterator_traits<ForwardIt>::iterator_category,
+      std::forward_iterator_tag>);
+  REQUIRE(std::is_same_v<std::iterator_traits<MadeIt>::iterator_category,
+      std::input_iterator_tag>);
+}
+
+TEST_CASE("chain.from_iterable: can be iterated backwards",
+    "[chain.from_iterable]") {
+  std::vector<std::vector<int>> ivv{
+      {}, {2, 4, 6}, {}, {}, {8}, {10, 12}, {}};
+  auto ch = chain.from_iterable(ivv);
+
+  std::vector<int> v(std::make_reverse_iterator(std::end(ch)),
+      std::make_reverse_iterator(std::begin(ch)));
+  const std::vector<int> vc = {12, 10, 8, 6, 4, 2};
+  REQUIRE(v == vc);
+
+  auto it = std::begin(ch);
+  ++it;
+  ++it;
+  ++it;
+  REQUIRE(*it == 8);
+  it--;
+  REQUIRE(*it == 6);
+  --it;
+  --it;
+  REQUIRE(it == std::begin(ch));
+}
+
+TEST_CASE("chain.from_iterable: multipass over forward sub iterables",
+    "[chain.from_iterable]") {
+  std::list<std::forward_list<int>> lfl{{1, 2}, {}, {3}};
+  auto ch = chain.from_iterable(lfl);
+  auto it = std::begin(ch);
+  auto it2 = it;
+  ++it;
+  REQUIRE(*it2 == 1);
+  REQUIRE(std::distance(std::begin(ch), std::end(ch)) == 3);
+  REQUIRE(*std::max_element(std::begin(ch), std::end(ch)) == 3);
+}
+
 template <typename T>
 using ImpT2 = decltype(chain.from_iterable(std::declval<T>()));
 TEST_CASE("chain.from_iterable: has correct ctor and assign ops",
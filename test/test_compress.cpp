@@ -1,7 +1,11 @@
 #include <cppitertools/compress.hpp>
 #include "helpers.hpp"
 
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
 #include <iterator>
+#include <list>
 #include <string>
 #include <utility>
 #include <vector>
@@ -168,3 +172,179 @@ TEST_CASE("compress: has correct ctor and assign ops", "[compress]") {
   REQUIRE(itertest::IsMoveConstructibleOnly<T1>::value);
   REQUIRE(itertest::IsMoveConstructibleOnly<T2>::value);
 }
+
+TEST_CASE("compress: bitmask selects set bits", "[compress]") {
+  std::vector<int> ivec(100);
+  for (int i = 0; i < 100; ++i) {
+    ivec[static_cast<std::size_t>(i)] = i;
+  }
+
+  SECTION("64 bit words") {
+    std::vector<std::uint64_t> words{0x5 | std::uint64_t{1} << 63, 0x8};
+    auto c = compress(ivec, iter::bitmask(words));
+    Vec v(std::begin(c), std::end(c));
+    Vec vc = {0, 2, 63, 67};
+    REQUIRE(v == vc);
+  }
+
+  SECTION("8 bit words, including empty ones") {
+    std::vector<std::uint8_t> words{0x81, 0, 0, 0x10};
+    auto c = compress(ivec, iter::bitmask(words));
+    Vec v(std::begin(c), std::end(c));
+    Vec vc = {0, 7, 28};
+    REQUIRE(v == vc);
+  }
+
+  SECTION("32 bit words, all set") {
+    const std::uint32_t words[] = {0xffffffff};
+    auto c = compress(ivec, iter::bitmask(words));
+    Vec v(std::begin(c), std::end(c));
+    Vec vc(ivec.begin(), ivec.begin() + 32);
+    REQUIRE(v == vc);
+  }
+
+  SECTION("all clear") {
+    std::vector<std::uint64_t> words{0, 0};
+    auto c = compress(ivec, iter::bitmask(words));
+    REQUIRE(std::begin(c) == std::end(c));
+  }
+}
+
+TEST_CASE("compress: bitmask matches bool selectors", "[compress]") {
+  std::vector<int> ivec(200);
+  std::vector<bool> bvec(ivec.size());
+  std::vector<std::uint64_t> words((ivec.size() + 63) / 64);
+  for (std::size_t i = 0; i < ivec.size(); ++i) {
+    ivec[i] = static_cast<int>(i * 3);
+    bvec[i] = (i * 7) % 5 == 0 || i % 11 == 0;
+    if (bvec[i]) {
+      words[i / 64] |= std::uint64_t{1} << (i % 64);
+    }
+  }
+  auto expected = compress(ivec, bvec);
+  auto c = compress(ivec, iter::bitmask(words));
+  Vec v(std::begin(c), std::end(c));
+  Vec vc(std::begin(expected), std::end(expected));
+  REQUIRE(v == vc);
+}
+
+TEST_CASE("compress: bitmask stops at the end of the data", "[compress]") {
+  std::vector<int> ivec{1, 2, 3, 4, 5};
+  std::vector<std::uint8_t> words{0xf2, 0xff};
+  auto c = compress(ivec, iter::bitmask(words));
+  Vec v(std::begin(c), std::end(c));
+  Vec vc = {2, 5};
+  REQUIRE(v == vc);
+}
+
+TEST_CASE("compress: bitmask on non-random-access data", "[compress]") {
+  std::list<int> ls{10, 11, 12, 13, 14, 15, 16};
+  std::vector<std::uint8_t> words{0x4a, 0xff};
+  auto c = compress(ls, iter::bitmask(words));
+  Vec v(std::begin(c), std::end(c));
+  Vec vc = {11, 13, 16};
+  REQUIRE(v == vc);
+}
+
+TEST_CASE("compress: const iteration with bitmask", "[compress][const]") {
+  std::vector<int> ivec{1, 2, 3, 4};
+  const auto c = compress(ivec, iter::bitmask(std::vector<unsigned>{0x9}));
+  Vec v(std::begin(c), std::end(c));
+  Vec vc = {1, 4};
+  REQUIRE(v == vc);
+}
+
+TEST_CASE("compress: indices into random access data", "[compress]") {
+  std::vector<std::string> svec{"a", "bb", "ccc", "dddd"};
+  std::vector<int> idx{3, 0, 0, 2, 9};
+  auto c = compress(svec, iter::indices(idx));
+  std::vector<std::string> v(std::begin(c), std::end(c));
+  std::vector<std::string> vc{"dddd", "a", "a", "ccc"};
+  REQUIRE(v == vc);
+
+  auto it = std::begin(c);
+  REQUIRE(it->size() == 4);
+  *it = "x";
+  REQUIRE(svec[3] == "x");
+}
+
+TEST_CASE("compress: ascending indices into a list", "[compress]") {
+  std::list<int> ls{10, 11, 12, 13, 14};
+  SECTION("stops at the end") {
+    auto c = compress(ls, iter::indices(std::vector<std::size_t>{1, 1, 4, 7}));
+    Vec v(std::begin(c), std::end(c));
+    Vec vc = {11, 11, 14};
+    REQUIRE(v == vc);
+  }
+  SECTION("stops at a smaller index") {
+    auto c = compress(ls, iter::indices(std::vector<std::size_t>{2, 3, 0, 4}));
+    Vec v(std::begin(c), std::end(c));
+    Vec vc = {12, 13};
+    REQUIRE(v == vc);
+  }
+}
+
+TEST_CASE("compress: indices with different begin and end types",
+    "[compress]") {
+  CharRange cr{'f'};
+  auto c = compress(cr, iter::indices(std::vector<int>{1, 4}));
+  Vec v(std::begin(c), std::end(c));
+  Vec vc{'b', 'e'};
+  REQUIRE(v == vc);
+}
+
+TEST_CASE("compress: index selectors bind to lvalues, move rvalues",
+    "[compress]") {
+  BasicIterable<char> bi{'x', 'y', 'z'};
+  BasicIterable<int> idx{0, 2};
+  SECTION("binds to lvalues") {
+    compress(bi, iter::indices(idx));
+    REQUIRE_FALSE(bi.was_moved_from());
+    REQUIRE_FALSE(idx.was_moved_from());
+  }
+  SECTION("moves rvalues") {
+    compress(std::move(bi), iter::indices(std::move(idx)));
+    REQUIRE(bi.was_moved_from());
+    REQUIRE(idx.was_moved_from());
+  }
+}
+
+TEST_CASE("compress: named selectors are held by reference", "[compress]") {
+  std::vector<int> ivec{10, 11, 12, 13, 14};
+  std::vector<std::uint8_t> words{0x11};
+  auto m = iter::bitmask(words);
+  auto c = compress(ivec, m);
+  std::vector<int> v(std::begin(c), std::end(c));
+  REQUIRE(v == Vec{10, 14});
+
+  std::vector<int> idx{3, 1};
+  auto ind = iter::indices(idx);
+  auto c2 = compress(ivec, ind);
+  v.assign(std::begin(c2), std::end(c2));
+  REQUIRE(v == Vec{13, 11});
+
+  idx[0] = 2;
+  v.assign(std::begin(c2), std::end(c2));
+  REQUIRE(v == Vec{12, 11});
+}
+
+TEST_CASE("compress: std::bitset selectors", "[compress]") {
+  std::vector<int> ivec(100);
+  for (int i = 0; i < 100; ++i) {
+    ivec[static_cast<std::size_t>(i)] = i;
+  }
+  std::bitset<130> bits;
+  bits.set(1).set(64).set(99).set(120);
+
+  auto c = compress(ivec, bits);
+  std::vector<int> v(std::begin(c), std::end(c));
+  REQUIRE(v == Vec{1, 64, 99});
+
+  std::list<int> ls(ivec.begin(), ivec.begin() + 70);
+  const auto lc = compress(ls, std::bitset<8>{0x81});
+  v.assign(std::begin(lc), std::end(lc));
+  REQUIRE(v == Vec{0, 7});
+
+  bits.reset();
+  REQUIRE(std::begin(c) == std::end(c));
+}
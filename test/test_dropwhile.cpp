@@ -1,3 +1,4 @@
+#include <cppitertools/assume_sorted.hpp>
 #include <cppitertools/dropwhile.hpp>
 #include <iterator>
 #include <string>
@@ -220,3 +221,45 @@ TEST_CASE("dropwhile: has correct ctor and assign ops", "[dropwhile]") {
   REQUIRE(itertest::IsMoveConstructibleOnly<T1>::value);
   REQUIRE(itertest::IsMoveConstructibleOnly<T2>::value);
 }
+
+TEST_CASE("dropwhile: searches a sorted iterable", "[dropwhile]") {
+  std::vector<int> ns(1000);
+  for (std::size_t i = 0; i < ns.size(); ++i) {
+    ns[i] = static_cast<int>(i);
+  }
+  int calls = 0;
+  auto lt = [&calls](int limit) {
+    return [&calls, limit](int n) {
+      ++calls;
+      return n < limit;
+    };
+  };
+
+  SECTION("skips to the first failure") {
+    auto d = dropwhile(lt(990), iter::assume_sorted(ns));
+    Vec v(std::begin(d), std::end(d));
+    Vec vc(ns.begin() + 990, ns.end());
+    REQUIRE(v == vc);
+    REQUIRE(calls < 30);
+  }
+
+  SECTION("all dropped") {
+    auto d = dropwhile(lt(5000), ns | iter::assume_sorted);
+    REQUIRE(std::begin(d) == std::end(d));
+  }
+
+  SECTION("none dropped") {
+    auto d = dropwhile(lt(0), iter::assume_sorted(ns));
+    REQUIRE(std::distance(std::begin(d), std::end(d)) == 1000);
+    REQUIRE(calls == 1);
+  }
+}
+
+TEST_CASE("dropwhile: assume_sorted on non-random-access iterables",
+    "[dropwhile]") {
+  itertest::BasicIterable<int> bi{1, 2, 3, 7, 8};
+  auto d = dropwhile(less_than_five, iter::assume_sorted(bi));
+  Vec v(std::begin(d), std::end(d));
+  Vec vc = {7, 8};
+  REQUIRE(v == vc);
+}
@@ -208,3 +208,78 @@ TEST_CASE("filter: has correct ctor and assign ops", "[filter]") {
   REQUIRE(itertest::IsMoveConstructibleOnly<T1>::value);
   REQUIRE(itertest::IsMoveConstructibleOnly<T2>::value);
 }
+
+TEST_CASE("filter.blocked: matches filter", "[filter]") {
+  std::vector<float> fs;
+  for (int i = 0; i < 1000; ++i) {
+    fs.push_back(static_cast<float>((i * 37) % 101));
+  }
+  auto over_90 = [](float f) { return f > 90.0f; };
+  for (std::size_t size : {0u, 1u, 63u, 64u, 65u, 130u, 1000u}) {
+    std::vector<float> part(fs.begin(), fs.begin() + size);
+    auto expected = filter(over_90, part);
+    auto f = filter.blocked(over_90, part);
+    REQUIRE(std::vector<float>(std::begin(f), std::end(f))
+            == std::vector<float>(std::begin(expected), std::end(expected)));
+  }
+}
+
+TEST_CASE("filter.blocked: yields references to the elements", "[filter]") {
+  std::vector<int> ns = {1, 8, 2, 9};
+  for (auto&& i : filter.blocked(LessThanValue{5}, ns)) {
+    i *= 10;
+  }
+  Vec vc = {10, 8, 20, 9};
+  REQUIRE(ns == vc);
+}
+
+TEST_CASE("filter.blocked: blocks with no survivors", "[filter]") {
+  std::vector<int> ns(300);
+  ns[5] = 1;
+  ns[299] = 2;
+  SECTION("with pipe and the default predicate") {
+    auto f = ns | filter.blocked;
+    Vec v(std::begin(f), std::end(f));
+    REQUIRE(v == Vec{1, 2});
+  }
+  SECTION("none at all") {
+    std::vector<int> zeros(200);
+    auto f = filter.blocked(zeros);
+    REQUIRE(std::begin(f) == std::end(f));
+  }
+}
+
+TEST_CASE("filter.blocked: arrays, const iteration and operator->",
+    "[filter][const]") {
+  std::string strs[] = {"", "ab", "", "abcd"};
+  const auto f = filter.blocked([](const std::string& s) { return !s.empty(); },
+      strs);
+  auto it = std::begin(f);
+  REQUIRE(it->size() == 2);
+  REQUIRE(&*it == &strs[1]);
+  ++it;
+  REQUIRE(it->size() == 4);
+  ++it;
+  REQUIRE(it == std::end(f));
+}
+
+TEST_CASE("filter.blocked: binds to lvalues, moves rvalues", "[filter]") {
+  std::vector<int> ns = {1, 2, 3};
+  SECTION("binds to lvalues") {
+    auto f = filter.blocked(ns);
+    ns[0] = 0;
+    Vec v(std::begin(f), std::end(f));
+    REQUIRE(v == Vec{2, 3});
+  }
+  SECTION("moves rvalues") {
+    auto f = filter.blocked(std::move(ns));
+    Vec v(std::begin(f), std::end(f));
+    REQUIRE(v == Vec{1, 2, 3});
+  }
+}
+
+TEST_CASE("filter.blocked: iterator meets requirements", "[filter]") {
+  std::vector<int> ns{};
+  auto f = filter.blocked(ns);
+  REQUIRE(itertest::IsForwardIterator<decltype(std::begin(f))>::value);
+}
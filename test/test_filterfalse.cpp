@@ -1,4 +1,5 @@
 #include <cppitertools/filterfalse.hpp>
+#include <algorithm>
 #include <iterator>
 #include <string>
 #include <vector>
@@ -160,3 +161,18 @@ TEST_CASE("filterfalse: has correct ctor and assign ops", "[filterfalse]") {
   REQUIRE(itertest::IsMoveConstructibleOnly<T1>::value);
   REQUIRE(itertest::IsMoveConstructibleOnly<T2>::value);
 }
+
+TEST_CASE("filterfalse.blocked: matches filterfalse", "[filterfalse]") {
+  std::vector<int> ns;
+  for (int i = 0; i < 500; ++i) {
+    ns.push_back((i * 13) % 17);
+  }
+  auto expected = filterfalse(LessThanValue{15}, ns);
+  auto f = filterfalse.blocked(LessThanValue{15}, ns);
+  REQUIRE(Vec(std::begin(f), std::end(f))
+          == Vec(std::begin(expected), std::end(expected)));
+
+  auto g = ns | filterfalse.blocked;
+  REQUIRE(std::all_of(
+      std::begin(g), std::end(g), [](int i) { return i == 0; }));
+}
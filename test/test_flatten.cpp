@@ -0,0 +1,182 @@
+#include <cppitertools/flatten.hpp>
+
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "catch.hpp"
+#include "helpers.hpp"
+
+using iter::flatten;
+using Vec = const std::vector<int>;
+
+TEST_CASE("flatten: rows in order", "[flatten]") {
+  std::vector<std::vector<int>> jagged{{1, 2, 3}, {4}, {5, 6}};
+  std::vector<int> v;
+  SECTION("Normal call") {
+    auto f = flatten(jagged);
+    v.assign(std::begin(f), std::end(f));
+  }
+  SECTION("Pipe") {
+    auto f = jagged | flatten;
+    v.assign(std::begin(f), std::end(f));
+  }
+  Vec vc = {1, 2, 3, 4, 5, 6};
+  REQUIRE(v == vc);
+}
+
+TEST_CASE("flatten: skips empty rows", "[flatten]") {
+  std::vector<std::vector<int>> jagged{{}, {}, {1}, {}, {2, 3}, {}, {}};
+  auto f = flatten(jagged);
+  Vec v(std::begin(f), std::end(f));
+  Vec vc = {1, 2, 3};
+  REQUIRE(v == vc);
+  REQUIRE(f.size() == 3);
+}
+
+TEST_CASE("flatten: empty", "[flatten]") {
+  SECTION("No rows") {
+    std::vector<std::vector<int>> jagged;
+    auto f = flatten(jagged);
+    REQUIRE(std::begin(f) == std::end(f));
+    REQUIRE(f.size() == 0);
+  }
+  SECTION("Only empty rows") {
+    std::vector<std::vector<int>> jagged(4);
+    auto f = flatten(jagged);
+    REQUIRE(std::begin(f) == std::end(f));
+    REQUIRE(f.size() == 0);
+  }
+}
+
+TEST_CASE("flatten: random access matches sequential order", "[flatten]") {
+  std::vector<std::vector<int>> jagged;
+  int n = 0;
+  for (int len : {0, 3, 1, 0, 0, 5, 2, 0, 4, 0}) {
+    auto& row = jagged.emplace_back();
+    for (int i = 0; i < len; ++i) {
+      row.push_back(n++);
+    }
+  }
+  auto f = flatten(jagged);
+  REQUIRE(f.size() == static_cast<std::size_t>(n));
+  REQUIRE(std::end(f) - std::begin(f) == n);
+
+  for (int i = 0; i < n; ++i) {
+    REQUIRE(f[static_cast<std::size_t>(i)] == i);
+    REQUIRE(std::begin(f)[i] == i);
+    REQUIRE(*(std::end(f) - (n - i)) == i);
+  }
+
+  auto it = std::begin(f) + 4;
+  REQUIRE(*it == 4);
+  it -= 3;
+  REQUIRE(*it == 1);
+  it += 6;
+  REQUIRE(*it == 7);
+  REQUIRE(std::begin(f) < it);
+  REQUIRE(it <= it);
+  REQUIRE(std::end(f) > it);
+}
+
+TEST_CASE("flatten: can be iterated backwards", "[flatten]") {
+  std::vector<std::vector<int>> jagged{{}, {1, 2}, {}, {3}, {}, {4, 5}, {}};
+  auto f = flatten(jagged);
+  Vec v(std::make_reverse_iterator(std::end(f)),
+      std::make_reverse_iterator(std::begin(f)));
+  Vec vc = {5, 4, 3, 2, 1};
+  REQUIRE(v == vc);
+}
+
+TEST_CASE("flatten: works with standard algorithms", "[flatten]") {
+  std::vector<std::vector<int>> jagged{{9, 3}, {}, {7, 1, 8}, {2}};
+  auto f = flatten(jagged);
+  std::sort(std::begin(f), std::end(f));
+  REQUIRE(jagged == std::vector<std::vector<int>>{{1, 2}, {}, {3, 7, 8}, {9}});
+  REQUIRE(std::binary_search(std::begin(f), std::end(f), 7));
+  REQUIRE(*std::lower_bound(std::begin(f), std::end(f), 4) == 7);
+}
+
+TEST_CASE("flatten: modifies elements through references", "[flatten]") {
+  std::vector<std::vector<int>> jagged{{1}, {2, 3}};
+  for (auto& i : flatten(jagged)) {
+    i *= 10;
+  }
+  auto f = flatten(jagged);
+  f[2] = 0;
+  REQUIRE(jagged == std::vector<std::vector<int>>{{10}, {20, 0}});
+}
+
+TEST_CASE("flatten: const iteration", "[flatten][const]") {
+  std::vector<std::string> rows{"ab", "", "cde"};
+  const auto f = flatten(rows);
+  std::string s(std::begin(f), std::end(f));
+  REQUIRE(s == "abcde");
+  REQUIRE(f[3] == 'd');
+}
+
+TEST_CASE("flatten: const iterators can be compared to non-const iterators",
+    "[flatten][const]") {
+  std::vector<std::vector<int>> jagged{{1}, {2, 3}};
+  auto f = flatten(jagged);
+  const auto& cf = f;
+  REQUIRE(std::begin(f) == std::begin(cf));
+  REQUIRE(std::end(f) == std::end(cf));
+  REQUIRE(std::end(cf) - std::begin(f) == 3);
+}
+
+TEST_CASE("flatten: operator->", "[flatten]") {
+  std::vector<std::vector<std::string>> jagged{{"a"}, {"abc"}};
+  auto f = flatten(jagged);
+  auto it = std::begin(f) + 1;
+  REQUIRE(it->size() == 3);
+}
+
+TEST_CASE("flatten: works with arrays of arrays", "[flatten]") {
+  std::array<int, 2> rows[] = {{{1, 2}}, {{3, 4}}, {{5, 6}}};
+  auto f = flatten(rows);
+  Vec v(std::begin(f), std::end(f));
+  Vec vc = {1, 2, 3, 4, 5, 6};
+  REQUIRE(v == vc);
+}
+
+TEST_CASE("flatten: binds reference to lvalue and moves rvalue", "[flatten]") {
+  std::vector<std::vector<int>> jagged{{1}, {2, 3}};
+  SECTION("binds to lvalues") {
+    auto f = flatten(jagged);
+    *std::begin(f) = 5;
+    REQUIRE(jagged[0][0] == 5);
+  }
+  SECTION("moves rvalues") {
+    auto f = flatten(std::move(jagged));
+    REQUIRE(jagged.empty());
+    REQUIRE(f[1] == 2);
+  }
+}
+
+TEST_CASE("flatten: iterator survives the flatten object being moved",
+    "[flatten]") {
+  auto f = flatten(std::vector<std::vector<int>>{{1, 2}, {3}});
+  auto it = std::begin(f) + 2;
+  auto f2 = std::move(f);
+  REQUIRE(*it == 3);
+  REQUIRE(f2[0] == 1);
+}
+
+TEST_CASE("flatten: iterator meets requirements", "[flatten]") {
+  std::vector<std::vector<int>> jagged;
+  auto f = flatten(jagged);
+  REQUIRE(itertest::IsIterator<decltype(std::begin(f))>::value);
+}
+
+template <typename T>
+using ImpT = decltype(flatten(std::declval<T>()));
+TEST_CASE("flatten: has correct ctor and assign ops", "[flatten]") {
+  using T1 = ImpT<std::vector<std::vector<int>>&>;
+  using T2 = ImpT<std::vector<std::string>>;
+  REQUIRE(itertest::IsMoveConstructibleOnly<T1>::value);
+  REQUIRE(itertest::IsMoveConstructibleOnly<T2>::value);
+}
@@ -1,4 +1,6 @@
+#include <cppitertools/assume_sorted.hpp>
 #include <cppitertools/groupby.hpp>
+#include <cppitertools/imap.hpp>
 
 #include "helpers.hpp"
 
@@ -374,6 +376,30 @@ TEST_CASE("groupby: single argument uses elements as keys", "[groupby]") {
   REQUIRE(groups == gc);
 }
 
+TEST_CASE("groupby: groups values returned by imap", "[groupby]") {
+  std::vector<int> ivec = {1, 1, 2, 2, 2, 3, 1};
+  int calls = 0;
+  auto m = iter::imap(
+      [&calls](int i) {
+        ++calls;
+        return std::to_string(i * 10);
+      },
+      ivec);
+  std::vector<std::string> keys;
+  std::vector<std::vector<std::string>> groups;
+  for (auto&& gb : groupby(m)) {
+    keys.push_back(gb.first);
+    groups.emplace_back(std::begin(gb.second), std::end(gb.second));
+  }
+
+  const std::vector<std::string> kc = {"10", "20", "30", "10"};
+  REQUIRE(keys == kc);
+  const std::vector<std::vector<std::string>> gc = {
+      {"10", "10"}, {"20", "20", "20"}, {"30"}, {"10"}};
+  REQUIRE(groups == gc);
+  REQUIRE(calls == static_cast<int>(ivec.size()));
+}
+
 TEST_CASE("groupby: empty iterable yields nothing", "[groupby]") {
   std::vector<int> ivec{};
   auto g = groupby(ivec);
@@ -462,3 +488,47 @@ TEST_CASE("groupby: has correct ctor and assign ops", "[groupby]") {
   REQUIRE(itertest::IsMoveConstructibleOnly<T1>::value);
   REQUIRE(itertest::IsMoveConstructibleOnly<T2>::value);
 }
+
+TEST_CASE("groupby: searches for group ends in a sorted iterable",
+    "[groupby]") {
+  std::vector<int> ns;
+  for (int k = 0; k < 5; ++k) {
+    ns.insert(ns.end(), static_cast<std::size_t>(100 * (k + 1)), k);
+  }
+  int calls = 0;
+  auto key = [&calls](int n) {
+    ++calls;
+    return n;
+  };
+
+  SECTION("groups are the same as without the hint") {
+    std::vector<int> keys;
+    std::vector<std::size_t> sizes;
+    for (auto&& gb : groupby(iter::assume_sorted(ns), key)) {
+      keys.push_back(gb.first);
+      sizes.push_back(static_cast<std::size_t>(
+          std::distance(std::begin(gb.second), std::end(gb.second))));
+    }
+    REQUIRE(keys == std::vector<int>{0, 1, 2, 3, 4});
+    REQUIRE(sizes == std::vector<std::size_t>{100, 200, 300, 400, 500});
+  }
+
+  SECTION("skipping groups doesn't call the key function on each element") {
+    std::vector<int> keys;
+    for (auto&& gb : groupby(ns | iter::assume_sorted, key)) {
+      keys.push_back(gb.first);
+    }
+    REQUIRE(keys == std::vector<int>{0, 1, 2, 3, 4});
+    REQUIRE(calls < 100);
+  }
+
+  SECTION("partly iterated groups") {
+    std::vector<int> firsts;
+    for (auto&& gb : groupby(iter::assume_sorted(ns), key)) {
+      auto it = std::begin(gb.second);
+      ++it;
+      firsts.push_back(*it);
+    }
+    REQUIRE(firsts == std::vector<int>{0, 1, 2, 3, 4});
+  }
+}
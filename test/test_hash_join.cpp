@@ -0,0 +1,205 @@
+#include <cppitertools/hash_join.hpp>
+#include <cppitertools/imap.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <list>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "catch.hpp"
+#include "helpers.hpp"
+
+using iter::hash_join;
+
+namespace {
+  struct User {
+    int id;
+    std::string name;
+  };
+
+  struct Order {
+    int user_id;
+    int amount;
+  };
+
+  int user_id(const User& u) {
+    return u.id;
+  }
+
+  int order_user(const Order& o) {
+    return o.user_id;
+  }
+
+  template <typename Joined>
+  std::vector<std::pair<std::string, int>> names_and_amounts(Joined&& j) {
+    std::vector<std::pair<std::string, int>> v;
+    for (auto&& [u, o] : j) {
+      v.emplace_back(u.name, o.amount);
+    }
+    return v;
+  }
+
+  using Result = const std::vector<std::pair<std::string, int>>;
+}
+
+TEST_CASE("hash_join: pairs elements with equal keys", "[hash_join]") {
+  const std::vector<User> users = {{1, "ann"}, {2, "bo"}, {3, "cy"}};
+  const std::vector<Order> orders = {{2, 10}, {4, 20}, {1, 30}, {2, 40}};
+  auto j = hash_join(users, orders, user_id, order_user);
+  Result rc = {{"bo", 10}, {"ann", 30}, {"bo", 40}};
+  REQUIRE(names_and_amounts(j) == rc);
+}
+
+TEST_CASE("hash_join: yields every match for repeated build keys",
+    "[hash_join]") {
+  const std::vector<User> users = {{1, "ann"}, {2, "bo"}, {1, "al"}};
+  const std::vector<Order> orders = {{1, 5}, {2, 6}, {1, 7}};
+  auto j = hash_join(users, orders, user_id, order_user);
+  auto v = names_and_amounts(j);
+  Result rc = {{"al", 5}, {"ann", 5}, {"bo", 6}, {"al", 7}, {"ann", 7}};
+  // the order within one probe element's matches is unspecified
+  std::sort(v.begin(), v.begin() + 2);
+  std::sort(v.begin() + 3, v.end());
+  REQUIRE(v == rc);
+}
+
+TEST_CASE("hash_join: many colliding keys", "[hash_join]") {
+  std::vector<int> build;
+  for (int i = 0; i < 1000; ++i) {
+    build.push_back(i * 64);
+  }
+  std::vector<int> probe;
+  for (int i = 0; i < 64000; i += 32) {
+    probe.push_back(i);
+  }
+  auto identity = [](int i) { return i; };
+  std::vector<int> v;
+  for (auto&& [b, p] : hash_join(build, probe, identity, identity)) {
+    REQUIRE(b == p);
+    v.push_back(b);
+  }
+  REQUIRE(v.size() == 1000);
+  REQUIRE(std::is_sorted(v.begin(), v.end()));
+}
+
+TEST_CASE("hash_join: no matches", "[hash_join]") {
+  const std::vector<User> users = {{1, "ann"}};
+  const std::vector<Order> orders = {{2, 10}, {3, 20}};
+  auto j = hash_join(users, orders, user_id, order_user);
+  REQUIRE(std::begin(j) == std::end(j));
+}
+
+TEST_CASE("hash_join: empty iterables", "[hash_join]") {
+  const std::vector<User> users = {};
+  const std::vector<Order> orders = {{2, 10}};
+  SECTION("Empty build") {
+    auto j = hash_join(users, orders, user_id, order_user);
+    REQUIRE(std::begin(j) == std::end(j));
+  }
+  SECTION("Empty probe") {
+    auto j = hash_join(orders, users, order_user, user_id);
+    REQUIRE(std::begin(j) == std::end(j));
+  }
+}
+
+TEST_CASE("hash_join: yields references into the build iterable",
+    "[hash_join]") {
+  std::vector<User> users = {{1, "ann"}, {2, "bo"}};
+  const std::vector<Order> orders = {{2, 10}};
+  for (auto&& [u, o] : hash_join(users, orders, user_id, order_user)) {
+    u.name += "!";
+    (void)o;
+  }
+  REQUIRE(users[1].name == "bo!");
+  REQUIRE(users[0].name == "ann");
+}
+
+TEST_CASE("hash_join: copies a build iterable that yields values",
+    "[hash_join]") {
+  const std::vector<int> ids = {1, 2, 3};
+  auto make_user = [](int i) { return User{i, std::string(i, 'x')}; };
+  const std::vector<Order> orders = {{3, 1}, {1, 2}};
+  auto j = hash_join(iter::imap(make_user, ids), orders, user_id, order_user);
+  Result rc = {{"xxx", 1}, {"x", 2}};
+  REQUIRE(names_and_amounts(j) == rc);
+}
+
+TEST_CASE("hash_join: builds the table once", "[hash_join]") {
+  const std::vector<int> build = {1, 2};
+  const std::vector<int> probe = {2, 1};
+  int calls = 0;
+  auto counted = [&calls](int i) {
+    ++calls;
+    return i;
+  };
+  auto identity = [](int i) { return i; };
+  auto j = hash_join(build, probe, counted, identity);
+  (void)std::distance(std::begin(j), std::end(j));
+  auto first = calls;
+  (void)std::distance(std::begin(j), std::end(j));
+  // again only to compare the keys of matches
+  REQUIRE(calls - first == 2);
+}
+
+TEST_CASE("hash_join: list probe iterable", "[hash_join]") {
+  const std::vector<User> users = {{1, "ann"}, {2, "bo"}};
+  const std::list<Order> orders = {{2, 10}, {1, 30}};
+  Result rc = {{"bo", 10}, {"ann", 30}};
+  REQUIRE(names_and_amounts(hash_join(users, orders, user_id, order_user))
+          == rc);
+}
+
+TEST_CASE("hash_join: pipe", "[hash_join]") {
+  const std::vector<User> users = {{1, "ann"}, {2, "bo"}};
+  const std::vector<Order> orders = {{2, 10}, {1, 30}};
+  Result rc = {{"bo", 10}, {"ann", 30}};
+  SECTION("Temporary partial") {
+    auto j = orders | hash_join(users, user_id, order_user);
+    REQUIRE(names_and_amounts(j) == rc);
+  }
+  SECTION("Reused partial") {
+    auto by_user = hash_join(users, user_id, order_user);
+    REQUIRE(names_and_amounts(orders | by_user) == rc);
+    REQUIRE(names_and_amounts(orders | by_user) == rc);
+  }
+}
+
+TEST_CASE("hash_join: const iteration", "[hash_join][const]") {
+  std::vector<User> users = {{1, "ann"}, {2, "bo"}};
+  std::vector<Order> orders = {{2, 10}, {1, 30}};
+  const auto j = hash_join(users, orders, user_id, order_user);
+  Result rc = {{"bo", 10}, {"ann", 30}};
+  REQUIRE(names_and_amounts(j) == rc);
+}
+
+TEST_CASE("hash_join: operator->", "[hash_join]") {
+  const std::vector<User> users = {{1, "ann"}};
+  const std::vector<Order> orders = {{1, 30}};
+  auto j = hash_join(users, orders, user_id, order_user);
+  auto it = std::begin(j);
+  REQUIRE(it->first.name == "ann");
+  REQUIRE(it->second.amount == 30);
+}
+
+TEST_CASE("hash_join: binds to lvalues and moves rvalues", "[hash_join]") {
+  itertest::BasicIterable<int> bi{1, 2};
+  const std::vector<int> other = {2};
+  auto identity = [](int i) { return i; };
+  SECTION("binds to lvalues") {
+    hash_join(bi, other, identity, identity);
+    REQUIRE_FALSE(bi.was_moved_from());
+  }
+  SECTION("moves rvalues") {
+    hash_join(std::move(bi), other, identity, identity);
+    REQUIRE(bi.was_moved_from());
+  }
+}
+
+TEST_CASE("hash_join: iterator meets requirements", "[hash_join]") {
+  const std::vector<int> v = {1};
+  auto identity = [](int i) { return i; };
+  auto j = hash_join(v, v, identity, identity);
+  REQUIRE(itertest::IsIterator<decltype(std::begin(j))>::value);
+}
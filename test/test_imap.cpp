@@ -4,6 +4,7 @@
 
 #include <cctype>
 #include <iterator>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -196,6 +197,88 @@ TEST_CASE("imap: operator->", "[imap]") {
   }
 }
 
+TEST_CASE("imap: doesn't copy the function's results", "[imap]") {
+  struct Counted {
+    int* copies;
+    Counted(int* c) : copies{c} {}
+    Counted(const Counted& other) : copies{other.copies} {
+      ++*copies;
+    }
+  };
+  int copies = 0;
+  Vec ns = {1, 2, 3};
+  for (auto&& c : imap([&copies](int) { return Counted{&copies}; }, ns)) {
+    (void)c;
+  }
+  REQUIRE(copies == 0);
+}
+
+TEST_CASE("imap: calls the function again for each dereference", "[imap]") {
+  std::vector<std::string> vs = {"ab", "abcd"};
+  int calls = 0;
+  auto m = imap(
+      [&calls](const std::string& s) {
+        ++calls;
+        return s + s;
+      },
+      vs);
+  auto it = std::begin(m);
+  REQUIRE(*it == "abab");
+  REQUIRE(*it == "abab");
+  REQUIRE(calls == 2);
+}
+
+TEST_CASE("imap: cached calls the function once per element", "[imap]") {
+  std::vector<std::string> vs = {"ab", "abcd"};
+  int calls = 0;
+  auto m = imap.cached(
+      [&calls](const std::string& s) {
+        ++calls;
+        return s + s;
+      },
+      vs);
+  auto it = std::begin(m);
+  REQUIRE(*it == "abab");
+  REQUIRE(it->size() == 4);
+  REQUIRE(calls == 1);
+  ++it;
+  REQUIRE(it->size() == 8);
+  REQUIRE(*it == "abcdabcd");
+  REQUIRE(calls == 2);
+}
+
+TEST_CASE("imap: copies of a cached iterator don't share its result",
+    "[imap]") {
+  std::vector<std::string> vs = {"ab", "abcd"};
+  int calls = 0;
+  auto m = imap.cached(
+      [&calls](const std::string& s) {
+        ++calls;
+        return s + s;
+      },
+      vs);
+  auto it = std::begin(m);
+  REQUIRE(*it == "abab");
+  auto it2 = it;
+  REQUIRE(*it2 == "abab");
+  REQUIRE(calls == 2);
+  it2 = it;
+  REQUIRE(*it2 == "abab");
+  REQUIRE(calls == 3);
+  REQUIRE(*it == "abab");
+  REQUIRE(calls == 3);
+}
+
+TEST_CASE("imap: cached results that can't be copied are returned directly",
+    "[imap]") {
+  Vec ns = {1, 2};
+  auto m = imap.cached([](int i) { return std::make_unique<int>(i); }, ns);
+  auto it = std::begin(m);
+  std::unique_ptr<int> p = *it;
+  REQUIRE(*p == 1);
+  REQUIRE(**it == 1);
+}
+
 TEST_CASE("imap: empty sequence gives nothing", "[imap]") {
   Vec v{};
   auto im = imap(plusone, v);
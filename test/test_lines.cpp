@@ -0,0 +1,132 @@
+#include <cppitertools/chunked.hpp>
+#include <cppitertools/enumerate.hpp>
+#include <cppitertools/filter.hpp>
+#include <cppitertools/imap.hpp>
+#include <cppitertools/lines.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "catch.hpp"
+#include "helpers.hpp"
+
+using iter::lines;
+using Vec = const std::vector<std::string_view>;
+
+namespace {
+  // writes contents to a file which is removed when the object goes away
+  class TempFile {
+   private:
+    std::string path_;
+
+   public:
+    TempFile(std::string path, const std::string& contents)
+        : path_{std::move(path)} {
+      std::ofstream out(path_, std::ios::binary);
+      out << contents;
+    }
+
+    ~TempFile() {
+      std::remove(path_.c_str());
+    }
+
+    const std::string& path() const {
+      return path_;
+    }
+  };
+}
+
+TEST_CASE("lines: splits a file into lines", "[lines]") {
+  TempFile f{"test_lines_basic.tmp", "first\nsecond\n\nfourth\n"};
+  auto ls = lines(f.path());
+  REQUIRE_FALSE(ls.error());
+  Vec v(std::begin(ls), std::end(ls));
+  Vec vc = {"first", "second", "", "fourth"};
+  REQUIRE(v == vc);
+}
+
+TEST_CASE("lines: final line without a newline", "[lines]") {
+  TempFile f{"test_lines_final.tmp", "a\nb"};
+  auto ls = lines(f.path());
+  Vec v(std::begin(ls), std::end(ls));
+  Vec vc = {"a", "b"};
+  REQUIRE(v == vc);
+}
+
+TEST_CASE("lines: empty file and single newline", "[lines]") {
+  SECTION("empty file") {
+    TempFile f{"test_lines_empty.tmp", ""};
+    auto ls = lines(f.path());
+    REQUIRE_FALSE(ls.error());
+    REQUIRE(std::begin(ls) == std::end(ls));
+  }
+  SECTION("only a newline") {
+    TempFile f{"test_lines_newline.tmp", "\n"};
+    auto ls = lines(f.path());
+    Vec v(std::begin(ls), std::end(ls));
+    Vec vc = {""};
+    REQUIRE(v == vc);
+  }
+}
+
+TEST_CASE("lines: missing file reports an error", "[lines]") {
+  auto ls = lines("test_lines_does_not_exist.tmp");
+  REQUIRE(ls.error());
+  REQUIRE(std::begin(ls) == std::end(ls));
+}
+
+TEST_CASE("lines: string_views point into the file contents", "[lines]") {
+  TempFile f{"test_lines_views.tmp", "abc\ndef\n"};
+  auto ls = lines(f.path());
+  auto contents = ls.contents();
+  REQUIRE(contents == "abc\ndef\n");
+  auto it = std::begin(ls);
+  ++it;
+  REQUIRE(it->data() == contents.data() + 4);
+  REQUIRE(it->size() == 3);
+
+  auto moved = std::move(ls);
+  REQUIRE(*it == "def");
+  REQUIRE(moved.contents().data() == contents.data());
+}
+
+TEST_CASE("lines: composes with other tools", "[lines]") {
+  TempFile f{"test_lines_compose.tmp", "1 ok\n2 error\n3 ok\n4 error\n5 ok\n"};
+
+  SECTION("filter and imap") {
+    auto errors = lines(f.path()) | iter::filter([](std::string_view l) {
+      return l.find("error") != std::string_view::npos;
+    }) | iter::imap([](std::string_view l) { return l.substr(0, 1); });
+    Vec v(std::begin(errors), std::end(errors));
+    Vec vc = {"2", "4"};
+    REQUIRE(v == vc);
+  }
+
+  SECTION("enumerate") {
+    std::vector<std::size_t> idxs;
+    for (auto&& [i, l] : iter::enumerate(lines(f.path()))) {
+      REQUIRE(l[0] == static_cast<char>('1' + i));
+      idxs.push_back(i);
+    }
+    REQUIRE(idxs == std::vector<std::size_t>{0, 1, 2, 3, 4});
+  }
+
+  SECTION("chunked") {
+    std::vector<std::size_t> sizes;
+    for (auto&& chunk : iter::chunked(lines(f.path()), 2)) {
+      sizes.push_back(chunk.size());
+    }
+    REQUIRE(sizes == std::vector<std::size_t>{2, 2, 1});
+  }
+}
+
+TEST_CASE("lines: iterator meets requirements", "[lines]") {
+  TempFile f{"test_lines_reqs.tmp", "a\n"};
+  auto ls = lines(f.path());
+  REQUIRE(itertest::IsIterator<decltype(std::begin(ls))>::value);
+}
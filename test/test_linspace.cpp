@@ -0,0 +1,77 @@
+#include <cppitertools/linspace.hpp>
+
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+#include "catch.hpp"
+#include "helpers.hpp"
+
+using iter::linspace;
+using Vec = const std::vector<double>;
+
+TEST_CASE("linspace: includes both endpoints", "[linspace]") {
+  auto ls = linspace(0.0, 1.0, 5);
+  Vec v(std::begin(ls), std::end(ls));
+  Vec vc{0.0, 0.25, 0.5, 0.75, 1.0};
+  REQUIRE(v == vc);
+}
+
+TEST_CASE("linspace: last value is exactly stop", "[linspace]") {
+  auto ls = linspace(0.1, 0.7, 7);
+  REQUIRE(ls.size() == 7);
+  REQUIRE(ls[6] == 0.7);
+  REQUIRE(*std::prev(std::end(ls)) == 0.7);
+  REQUIRE(ls[3] == Approx(0.4));
+}
+
+TEST_CASE("linspace: going down", "[linspace]") {
+  auto ls = linspace(2.0, -2.0, 3);
+  Vec v(std::begin(ls), std::end(ls));
+  Vec vc{2.0, 0.0, -2.0};
+  REQUIRE(v == vc);
+}
+
+TEST_CASE("linspace: 0 and 1 values", "[linspace]") {
+  auto ls0 = linspace(1.0, 2.0, 0);
+  REQUIRE(std::begin(ls0) == std::end(ls0));
+  REQUIRE(ls0.empty());
+
+  auto ls1 = linspace(1.0, 2.0, 1);
+  Vec v(std::begin(ls1), std::end(ls1));
+  Vec vc{1.0};
+  REQUIRE(v == vc);
+}
+
+TEST_CASE("linspace: iterator is random access", "[linspace]") {
+  auto ls = linspace(0.0, 10.0, 11);
+  auto it = std::begin(ls);
+  REQUIRE(std::is_same<std::iterator_traits<decltype(it)>::iterator_category,
+      std::random_access_iterator_tag>::value);
+  REQUIRE(std::end(ls) - it == 11);
+  it += 4;
+  REQUIRE(*it == 4.0);
+  REQUIRE(it[2] == 6.0);
+  REQUIRE(itertest::IsForwardIterator<decltype(it)>::value);
+}
+
+TEST_CASE("linspace: can be constexpr", "[linspace]") {
+  constexpr auto ls = linspace(0.0, 4.0, 5);
+  static_assert(ls[2] == 2.0, "linspace computed the wrong value");
+  static_assert(ls.size() == 5, "linspace has the wrong size");
+}
+
+TEST_CASE("linspace: blocks", "[linspace]") {
+  auto ls = linspace(0.0, 9.0, 10);
+  std::vector<double> v;
+  std::vector<std::size_t> sizes;
+  for (auto&& block : ls.blocks<4>()) {
+    sizes.push_back(block.size());
+    for (auto d : block) {
+      v.push_back(d);
+    }
+  }
+  Vec vc(std::begin(ls), std::end(ls));
+  REQUIRE(v == vc);
+  REQUIRE(sizes == std::vector<std::size_t>{4, 4, 2});
+}
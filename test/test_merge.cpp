@@ -0,0 +1,233 @@
+#include <cppitertools/merge.hpp>
+#include <cppitertools/thread_pool.hpp>
+#include <cppitertools/to.hpp>
+
+#include <algorithm>
+#include <deque>
+#include <functional>
+#include <iterator>
+#include <list>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "catch.hpp"
+#include "helpers.hpp"
+
+using iter::merge;
+using Vec = const std::vector<int>;
+
+TEST_CASE("merge: two sorted vectors", "[merge]") {
+  Vec a = {1, 4, 7, 10};
+  Vec b = {2, 3, 8, 11, 12};
+  auto m = merge(a, b);
+  Vec v(std::begin(m), std::end(m));
+  Vec vc = {1, 2, 3, 4, 7, 8, 10, 11, 12};
+  REQUIRE(v == vc);
+}
+
+TEST_CASE("merge: different iterable types", "[merge]") {
+  std::vector<int> a = {5, 9};
+  std::list<int> b = {1, 6, 7};
+  int c[] = {0, 2, 20};
+  auto m = merge(a, b, c);
+  Vec v(std::begin(m), std::end(m));
+  Vec vc = {0, 1, 2, 5, 6, 7, 9, 20};
+  REQUIRE(v == vc);
+}
+
+TEST_CASE("merge: with a custom comparison", "[merge]") {
+  Vec a = {9, 5, 1};
+  Vec b = {8, 6, 2, 0};
+  auto m = merge(std::greater<>{}, a, b);
+  Vec v(std::begin(m), std::end(m));
+  Vec vc = {9, 8, 6, 5, 2, 1, 0};
+  REQUIRE(v == vc);
+}
+
+TEST_CASE("merge: is stable", "[merge]") {
+  using P = std::pair<int, char>;
+  const std::vector<P> a = {{1, 'a'}, {2, 'a'}, {2, 'a'}};
+  const std::vector<P> b = {{1, 'b'}, {2, 'b'}};
+  const std::vector<P> c = {{0, 'c'}, {2, 'c'}};
+  auto by_first = [](const P& lhs, const P& rhs) {
+    return lhs.first < rhs.first;
+  };
+  auto m = merge(by_first, a, b, c);
+  std::vector<P> v(std::begin(m), std::end(m));
+  const std::vector<P> vc = {{0, 'c'}, {1, 'a'}, {1, 'b'}, {2, 'a'},
+      {2, 'a'}, {2, 'b'}, {2, 'c'}};
+  REQUIRE(v == vc);
+}
+
+TEST_CASE("merge: empty iterables", "[merge]") {
+  Vec a = {};
+  Vec b = {3};
+  Vec c = {};
+  auto m = merge(a, b, c);
+  Vec v(std::begin(m), std::end(m));
+  REQUIRE(v == Vec{3});
+
+  auto m2 = merge(a, c);
+  REQUIRE(std::begin(m2) == std::end(m2));
+}
+
+TEST_CASE("merge: yields references into the iterables", "[merge]") {
+  std::vector<int> a = {1, 3};
+  std::vector<int> b = {2};
+  for (auto&& i : merge(a, b)) {
+    i *= 10;
+  }
+  REQUIRE(a == Vec{10, 30});
+  REQUIRE(b == Vec{20});
+}
+
+TEST_CASE("merge: const iteration", "[merge][const]") {
+  Vec a = {1, 3};
+  const auto m = merge(a, Vec{2, 4});
+  Vec v(std::begin(m), std::end(m));
+  REQUIRE(v == Vec{1, 2, 3, 4});
+}
+
+TEST_CASE("merge: binds to lvalues and moves rvalues", "[merge]") {
+  itertest::BasicIterable<int> bi{1, 3};
+  SECTION("binds to lvalues") {
+    merge(bi, Vec{2});
+    REQUIRE_FALSE(bi.was_moved_from());
+  }
+  SECTION("moves rvalues") {
+    merge(std::move(bi), Vec{2});
+    REQUIRE(bi.was_moved_from());
+  }
+}
+
+TEST_CASE("merge.from_iterable: many sorted iterables", "[merge]") {
+  const std::vector<std::vector<int>> shards = {
+      {3, 8, 13}, {}, {0, 1, 2}, {5}, {4, 9, 14, 19}, {6, 7}};
+  std::vector<int> v;
+  SECTION("Normal call") {
+    auto m = merge.from_iterable(shards);
+    v.assign(std::begin(m), std::end(m));
+  }
+  SECTION("Pipe") {
+    auto m = shards | merge.from_iterable;
+    v.assign(std::begin(m), std::end(m));
+  }
+  Vec vc = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 13, 14, 19};
+  REQUIRE(v == vc);
+}
+
+TEST_CASE("merge.from_iterable: with a custom comparison", "[merge]") {
+  const std::vector<std::vector<int>> shards = {{9, 3}, {8, 4, 1}};
+  std::vector<int> v;
+  SECTION("Normal call") {
+    auto m = merge.from_iterable(std::greater<>{}, shards);
+    v.assign(std::begin(m), std::end(m));
+  }
+  SECTION("Pipe") {
+    auto m = shards | merge.from_iterable(std::greater<>{});
+    v.assign(std::begin(m), std::end(m));
+  }
+  REQUIRE(v == Vec{9, 8, 4, 3, 1});
+}
+
+TEST_CASE("merge.from_iterable: sub iterables produced as values",
+    "[merge]") {
+  // each dereference of the outer iterator produces a new vector
+  std::vector<int> sizes = {3, 0, 2};
+  struct Gen {
+    std::vector<int>* sizes;
+    class Iterator {
+     public:
+      std::vector<int>::iterator it;
+      std::vector<int> operator*() const {
+        std::vector<int> v;
+        for (int i = 0; i < *it; ++i) {
+          v.push_back(i * 2 + *it);
+        }
+        return v;
+      }
+      Iterator& operator++() {
+        ++it;
+        return *this;
+      }
+      bool operator!=(const Iterator& other) const {
+        return it != other.it;
+      }
+    };
+    Iterator begin() {
+      return {sizes->begin()};
+    }
+    Iterator end() {
+      return {sizes->end()};
+    }
+  };
+  auto m = merge.from_iterable(Gen{&sizes});
+  Vec v(std::begin(m), std::end(m));
+  Vec vc = {2, 3, 4, 5, 7};
+  REQUIRE(v == vc);
+}
+
+TEST_CASE("merge.from_iterable: matches a full sort", "[merge]") {
+  std::vector<std::vector<int>> shards(37);
+  std::vector<int> all;
+  for (int i = 0; i < 2000; ++i) {
+    auto val = (i * 7919) % 1009;
+    shards[static_cast<std::size_t>((i * 31) % 37)].push_back(val);
+    all.push_back(val);
+  }
+  for (auto& s : shards) {
+    std::sort(std::begin(s), std::end(s));
+  }
+  std::sort(std::begin(all), std::end(all));
+  auto m = merge.from_iterable(shards);
+  Vec v(std::begin(m), std::end(m));
+  REQUIRE(v == all);
+}
+
+TEST_CASE("merge: collected in parallel on a pool", "[merge]") {
+  using P = std::pair<int, int>;
+  std::vector<std::vector<P>> shards(5);
+  for (int i = 0; i < 3000; ++i) {
+    shards[static_cast<std::size_t>((i * 13) % 5)].push_back(
+        {(i * 7919) % 211, i});
+  }
+  shards[3].clear();
+  auto by_first = [](const P& lhs, const P& rhs) {
+    return lhs.first < rhs.first;
+  };
+  for (auto& s : shards) {
+    std::stable_sort(std::begin(s), std::end(s), by_first);
+  }
+  auto m = merge(by_first, shards[0], shards[1], shards[2], shards[3],
+      shards[4]);
+  const std::vector<P> sequential(std::begin(m), std::end(m));
+
+  for (std::size_t n : {1, 2, 3, 7, 64}) {
+    iter::thread_pool pool{n};
+    REQUIRE((m | iter::to<std::vector>(pool)) == sequential);
+  }
+
+  iter::thread_pool pool{4};
+  const std::vector<int> ties(50, 1);
+  auto tm = merge(ties, ties, ties);
+  const std::vector<int> tv(std::begin(tm), std::end(tm));
+  REQUIRE((tm | iter::to<std::deque<int>>(pool))
+          == std::deque<int>(std::begin(tv), std::end(tv)));
+
+  const std::vector<int> a = {1, 4, 7, 10};
+  const std::vector<int> b = {2, 3, 8};
+  const std::vector<int> none;
+  auto collected = merge(a, none, b) | iter::to<std::vector>(pool);
+  Vec vc = {1, 2, 3, 4, 7, 8, 10};
+  REQUIRE(collected == vc);
+  REQUIRE((merge(none, none) | iter::to<std::vector>(pool)).empty());
+}
+
+TEST_CASE("merge: iterator meets requirements", "[merge]") {
+  Vec a = {1};
+  auto m = merge(a, a);
+  REQUIRE(itertest::IsIterator<decltype(std::begin(m))>::value);
+  auto mf = merge.from_iterable(std::vector<std::vector<int>>{});
+  REQUIRE(itertest::IsIterator<decltype(std::begin(mf))>::value);
+}
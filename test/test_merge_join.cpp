@@ -0,0 +1,170 @@
+#include <cppitertools/merge_join.hpp>
+
+#include <algorithm>
+#include <forward_list>
+#include <iterator>
+#include <list>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "catch.hpp"
+#include "helpers.hpp"
+
+using iter::merge_join;
+
+namespace {
+  using P = std::pair<int, char>;
+  using Result = const std::vector<std::pair<char, char>>;
+
+  int first(const P& p) {
+    return p.first;
+  }
+
+  template <typename Joined>
+  std::vector<std::pair<char, char>> tags(Joined&& j) {
+    std::vector<std::pair<char, char>> v;
+    for (auto&& [l, r] : j) {
+      v.emplace_back(l.second, r.second);
+    }
+    return v;
+  }
+
+  // the nested loop join, for comparison
+  std::vector<std::pair<int, int>> nested(
+      const std::vector<int>& left, const std::vector<int>& right) {
+    std::vector<std::pair<int, int>> v;
+    for (auto&& l : left) {
+      for (auto&& r : right) {
+        if (l == r) {
+          v.emplace_back(l, r);
+        }
+      }
+    }
+    return v;
+  }
+}
+
+TEST_CASE("merge_join: pairs elements with equal keys", "[merge_join]") {
+  const std::vector<P> left = {{1, 'a'}, {3, 'b'}, {4, 'c'}, {7, 'd'}};
+  const std::vector<P> right = {{0, 'w'}, {3, 'x'}, {7, 'y'}, {8, 'z'}};
+  auto j = merge_join(left, right, first, first);
+  Result rc = {{'b', 'x'}, {'d', 'y'}};
+  REQUIRE(tags(j) == rc);
+}
+
+TEST_CASE("merge_join: repeated keys on both sides", "[merge_join]") {
+  const std::vector<P> left = {{1, 'a'}, {2, 'b'}, {2, 'c'}, {3, 'd'}};
+  const std::vector<P> right = {{2, 'x'}, {2, 'y'}, {3, 'z'}};
+  auto j = merge_join(left, right, first, first);
+  Result rc = {{'b', 'x'}, {'b', 'y'}, {'c', 'x'}, {'c', 'y'}, {'d', 'z'}};
+  REQUIRE(tags(j) == rc);
+}
+
+TEST_CASE("merge_join: matches the nested loop join", "[merge_join]") {
+  auto identity = [](int i) { return i; };
+  for (int seed = 0; seed < 6; ++seed) {
+    std::vector<int> left;
+    std::vector<int> right;
+    for (int i = 0; i < 200; ++i) {
+      (i % (seed + 2) == 0 ? left : right).push_back((i * 37 + seed) % 29);
+    }
+    std::sort(left.begin(), left.end());
+    std::sort(right.begin(), right.end());
+    std::vector<std::pair<int, int>> v;
+    for (auto&& [l, r] : merge_join(left, right, identity, identity)) {
+      v.emplace_back(l, r);
+    }
+    REQUIRE(v == nested(left, right));
+  }
+}
+
+TEST_CASE("merge_join: no matches or empty iterables", "[merge_join]") {
+  const std::vector<P> left = {{1, 'a'}, {5, 'b'}};
+  const std::vector<P> right = {{2, 'x'}, {6, 'y'}};
+  const std::vector<P> none = {};
+  auto j = merge_join(left, right, first, first);
+  REQUIRE(std::begin(j) == std::end(j));
+  auto j2 = merge_join(none, right, first, first);
+  REQUIRE(std::begin(j2) == std::end(j2));
+  auto j3 = merge_join(left, none, first, first);
+  REQUIRE(std::begin(j3) == std::end(j3));
+}
+
+TEST_CASE("merge_join: run at the end of the right iterable",
+    "[merge_join]") {
+  const std::vector<P> left = {{2, 'a'}, {2, 'b'}, {2, 'c'}};
+  const std::forward_list<P> right = {{1, 'w'}, {2, 'x'}, {2, 'y'}};
+  auto j = merge_join(left, right, first, first);
+  Result rc = {
+      {'a', 'x'}, {'a', 'y'}, {'b', 'x'}, {'b', 'y'}, {'c', 'x'}, {'c', 'y'}};
+  REQUIRE(tags(j) == rc);
+}
+
+TEST_CASE("merge_join: different key types and iterables", "[merge_join]") {
+  const std::list<std::string> words = {"a", "bb", "cc", "dddd"};
+  const std::vector<int> lengths = {1, 2, 3, 4};
+  auto size = [](const std::string& s) { return s.size(); };
+  auto as_size = [](int i) { return static_cast<std::size_t>(i); };
+  std::vector<std::string> v;
+  for (auto&& [w, n] : merge_join(words, lengths, size, as_size)) {
+    REQUIRE(w.size() == static_cast<std::size_t>(n));
+    v.push_back(w);
+  }
+  REQUIRE(v == std::vector<std::string>{"a", "bb", "cc", "dddd"});
+}
+
+TEST_CASE("merge_join: yields references", "[merge_join]") {
+  std::vector<P> left = {{1, 'a'}, {2, 'b'}};
+  std::vector<P> right = {{2, 'x'}};
+  for (auto&& [l, r] : merge_join(left, right, first, first)) {
+    l.second = r.second;
+  }
+  REQUIRE(left[1].second == 'x');
+}
+
+TEST_CASE("merge_join: pipe", "[merge_join]") {
+  const std::vector<P> left = {{1, 'a'}, {3, 'b'}};
+  const std::vector<P> right = {{3, 'x'}};
+  Result rc = {{'b', 'x'}};
+  auto j = left | merge_join(right, first, first);
+  REQUIRE(tags(j) == rc);
+  auto partial = merge_join(right, first, first);
+  REQUIRE(tags(left | partial) == rc);
+}
+
+TEST_CASE("merge_join: const iteration", "[merge_join][const]") {
+  std::vector<P> left = {{1, 'a'}, {3, 'b'}};
+  std::vector<P> right = {{1, 'x'}};
+  const auto j = merge_join(left, right, first, first);
+  Result rc = {{'a', 'x'}};
+  REQUIRE(tags(j) == rc);
+}
+
+TEST_CASE("merge_join: operator->", "[merge_join]") {
+  const std::vector<P> left = {{1, 'a'}};
+  auto j = merge_join(left, left, first, first);
+  auto it = std::begin(j);
+  REQUIRE(it->first.second == 'a');
+}
+
+TEST_CASE("merge_join: binds to lvalues and moves rvalues", "[merge_join]") {
+  itertest::BasicIterable<int> bi{1, 2};
+  const std::vector<int> other = {2};
+  auto identity = [](int i) { return i; };
+  SECTION("binds to lvalues") {
+    merge_join(bi, other, identity, identity);
+    REQUIRE_FALSE(bi.was_moved_from());
+  }
+  SECTION("moves rvalues") {
+    merge_join(std::move(bi), other, identity, identity);
+    REQUIRE(bi.was_moved_from());
+  }
+}
+
+TEST_CASE("merge_join: iterator meets requirements", "[merge_join]") {
+  const std::vector<int> v = {1};
+  auto identity = [](int i) { return i; };
+  auto j = merge_join(v, v, identity, identity);
+  REQUIRE(itertest::IsIterator<decltype(std::begin(j))>::value);
+}
@@ -0,0 +1,90 @@
+#include <cppitertools/pairwise.hpp>
+
+#include <iterator>
+#include <list>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "catch.hpp"
+#include "helpers.hpp"
+
+using iter::pairwise;
+using Vec = const std::vector<int>;
+
+TEST_CASE("pairwise: each two consecutive elements", "[pairwise]") {
+  Vec ns = {1, 4, 9, 16};
+  std::vector<int> deltas;
+  SECTION("Normal call") {
+    for (auto [a, b] : pairwise(ns)) {
+      deltas.push_back(b - a);
+    }
+  }
+  SECTION("Pipe") {
+    for (auto [a, b] : ns | pairwise) {
+      deltas.push_back(b - a);
+    }
+  }
+  REQUIRE(deltas == Vec{3, 5, 7});
+}
+
+TEST_CASE("pairwise: fewer than two elements", "[pairwise]") {
+  Vec one = {1};
+  auto p = pairwise(one);
+  REQUIRE(std::begin(p) == std::end(p));
+  auto p2 = pairwise(Vec{});
+  REQUIRE(std::begin(p2) == std::end(p2));
+}
+
+TEST_CASE("pairwise: yields references", "[pairwise]") {
+  std::list<int> ns = {1, 2, 3};
+  for (auto [a, b] : pairwise(ns)) {
+    b += a;
+  }
+  REQUIRE(ns == std::list<int>{1, 3, 6});
+}
+
+TEST_CASE("pairwise: copies values the iterable yields", "[pairwise]") {
+  std::string s = "abc";
+  std::vector<std::string> v;
+  auto upper = [](char c) { return std::string(1, c); };
+  std::vector<std::string> strs;
+  for (auto c : s) {
+    strs.push_back(upper(c));
+  }
+  for (auto&& [a, b] : pairwise(std::move(strs))) {
+    v.push_back(a + b);
+  }
+  REQUIRE(v == std::vector<std::string>{"ab", "bc"});
+
+  itertest::InputIterable ii;
+  std::vector<int> sums;
+  for (auto [a, b] : pairwise(ii)) {
+    sums.push_back(a + b);
+  }
+  REQUIRE(sums == Vec{1, 3, 5, 7});
+}
+
+TEST_CASE("pairwise: const iteration", "[pairwise][const]") {
+  Vec ns = {1, 2, 3};
+  const auto p = pairwise(ns);
+  REQUIRE(std::distance(std::begin(p), std::end(p)) == 2);
+}
+
+TEST_CASE("pairwise: binds to lvalues and moves rvalues", "[pairwise]") {
+  itertest::BasicIterable<int> bi{1, 2};
+  SECTION("binds to lvalues") {
+    pairwise(bi);
+    REQUIRE_FALSE(bi.was_moved_from());
+  }
+  SECTION("moves rvalues") {
+    pairwise(std::move(bi));
+    REQUIRE(bi.was_moved_from());
+  }
+}
+
+TEST_CASE("pairwise: iterator meets requirements", "[pairwise]") {
+  std::string s{"abcdef"};
+  auto p = pairwise(s);
+  REQUIRE(itertest::IsIterator<decltype(std::begin(p))>::value);
+}
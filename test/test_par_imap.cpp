@@ -0,0 +1,223 @@
+#include <cppitertools/imap.hpp>
+#include <cppitertools/par_imap.hpp>
+#include <cppitertools/range.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "catch.hpp"
+#include "helpers.hpp"
+
+using iter::par_imap;
+using Vec = const std::vector<int>;
+
+namespace {
+  int square(int i) {
+    return i * i;
+  }
+}
+
+TEST_CASE("par_imap: yields results in order", "[par_imap]") {
+  iter::thread_pool pool{4};
+  std::vector<int> ns;
+  Vec vc = [&] {
+    std::vector<int> v;
+    for (int i = 0; i < 1000; ++i) {
+      ns.push_back(i);
+      v.push_back(i * i);
+    }
+    return v;
+  }();
+
+  for (std::size_t window : {0u, 1u, 3u, 100u}) {
+    SECTION("called directly, window " + std::to_string(window)) {
+      auto p = par_imap(square, ns, pool, window);
+      Vec v(std::begin(p), std::end(p));
+      REQUIRE(v == vc);
+    }
+    SECTION("with pipe, window " + std::to_string(window)) {
+      auto p = ns | par_imap(square, pool, window);
+      Vec v(std::begin(p), std::end(p));
+      REQUIRE(v == vc);
+    }
+  }
+}
+
+TEST_CASE("par_imap: calls the function on the pool", "[par_imap]") {
+  iter::thread_pool pool{3};
+  REQUIRE(pool.size() == 3);
+  std::mutex m;
+  std::set<std::thread::id> ids;
+  auto record = [&](int i) {
+    {
+      std::lock_guard<std::mutex> lock{m};
+      ids.insert(std::this_thread::get_id());
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    return i;
+  };
+  auto p = iter::range(30) | par_imap(record, pool);
+  Vec v(std::begin(p), std::end(p));
+  REQUIRE(v.size() == 30);
+  REQUIRE(ids.count(std::this_thread::get_id()) == 0);
+  REQUIRE(ids.size() > 1);
+}
+
+TEST_CASE("par_imap: calls the function once per element", "[par_imap]") {
+  iter::thread_pool pool{2};
+  std::atomic<int> calls{0};
+  auto counted = [&calls](int i) {
+    ++calls;
+    return std::to_string(i);
+  };
+  auto p = iter::range(10) | par_imap(counted, pool, 4);
+  auto it = std::begin(p);
+  REQUIRE(*it == "0");
+  REQUIRE(it->size() == 1);
+  REQUIRE(*it == "0");
+  ++it;
+  REQUIRE(*it++ == "1");
+  REQUIRE(*it == "2");
+  for (; it != std::end(p); ++it) {
+  }
+  REQUIRE(calls.load() == 10);
+}
+
+TEST_CASE("par_imap: passes references to long-lived elements",
+    "[par_imap]") {
+  iter::thread_pool pool{2};
+  std::vector<int> ns{1, 2, 3};
+  auto address = [](const int& i) { return &i; };
+  auto p = ns | par_imap(address, pool);
+  std::vector<const int*> v(std::begin(p), std::end(p));
+  REQUIRE(v == std::vector<const int*>{&ns[0], &ns[1], &ns[2]});
+}
+
+TEST_CASE("par_imap: copies elements of single pass iterables",
+    "[par_imap]") {
+  iter::thread_pool pool{2};
+  std::vector<int> ns{1, 2, 3, 4};
+  auto p = iter::imap([](int i) { return std::make_unique<int>(i); }, ns)
+           | par_imap([](std::unique_ptr<int> up) { return *up * 10; }, pool);
+  Vec v(std::begin(p), std::end(p));
+  Vec vc = {10, 20, 30, 40};
+  REQUIRE(v == vc);
+}
+
+TEST_CASE("par_imap: functions returning references", "[par_imap]") {
+  iter::thread_pool pool{2};
+  std::vector<int> ns{1, 2, 3};
+  auto p = ns | par_imap([](int& i) -> int& { return i; }, pool);
+  for (auto&& i : p) {
+    i *= 2;
+  }
+  Vec vc = {2, 4, 6};
+  REQUIRE(ns == vc);
+}
+
+TEST_CASE("par_imap: empty iterable", "[par_imap]") {
+  iter::thread_pool pool{2};
+  std::vector<int> ns{};
+  auto p = ns | par_imap(square, pool);
+  REQUIRE(std::begin(p) == std::end(p));
+}
+
+TEST_CASE("par_imap: rethrows when the result is reached", "[par_imap]") {
+  iter::thread_pool pool{3};
+  auto fails_on_5 = [](int i) {
+    if (i == 5) {
+      throw std::runtime_error{"bad element"};
+    }
+    return i;
+  };
+  std::vector<int> v;
+  auto p = iter::range(100) | par_imap(fails_on_5, pool, 8);
+  REQUIRE_THROWS_AS(
+      [&] {
+        for (auto i : p) {
+          v.push_back(i);
+        }
+      }(),
+      std::runtime_error);
+  Vec vc = {0, 1, 2, 3, 4};
+  REQUIRE(v == vc);
+}
+
+TEST_CASE("par_imap: stays within the window", "[par_imap]") {
+  iter::thread_pool pool{2};
+  std::atomic<int> calls{0};
+  {
+    auto p = iter::range(1000000) | par_imap([&calls](int i) {
+      ++calls;
+      return i;
+    }, pool, 5);
+    for (auto i : p) {
+      if (i == 9) {
+        break;
+      }
+    }
+  }
+  // 10 used, and at most 5 more submitted
+  REQUIRE(calls.load() <= 15);
+}
+
+TEST_CASE("par_imap: several at once on one pool", "[par_imap]") {
+  iter::thread_pool pool{2};
+  std::vector<int> ns{1, 2, 3, 4, 5};
+  auto p = ns | par_imap(square, pool, 2);
+  auto q = ns | par_imap([](int i) { return -i; }, pool, 2);
+  std::vector<int> v;
+  auto it_p = std::begin(p);
+  auto it_q = std::begin(q);
+  for (; it_p != std::end(p); ++it_p, ++it_q) {
+    v.push_back(*it_p + *it_q);
+  }
+  Vec vc = {0, 2, 6, 12, 20};
+  REQUIRE(v == vc);
+}
+
+TEST_CASE("par_imap: const iteration", "[par_imap][const]") {
+  iter::thread_pool pool{2};
+  std::vector<int> ns{1, 2, 3};
+  const auto p = ns | par_imap(square, pool);
+  Vec v(std::begin(p), std::end(p));
+  Vec vc = {1, 4, 9};
+  REQUIRE(v == vc);
+}
+
+TEST_CASE("par_imap: binds reference to lvalue and moves rvalue",
+    "[par_imap]") {
+  iter::thread_pool pool{1};
+  itertest::BasicIterable<int> bi{1, 2};
+  SECTION("binds to lvalues") {
+    bi | par_imap(square, pool);
+    REQUIRE_FALSE(bi.was_moved_from());
+  }
+  SECTION("moves rvalues") {
+    std::move(bi) | par_imap(square, pool);
+    REQUIRE(bi.was_moved_from());
+  }
+}
+
+TEST_CASE("par_imap: iterator meets requirements", "[par_imap]") {
+  iter::thread_pool pool{1};
+  std::vector<int> ns{};
+  auto p = ns | par_imap(square, pool);
+  REQUIRE(itertest::IsIterator<decltype(std::begin(p))>::value);
+}
+
+template <typename T>
+using ImpT = decltype(std::declval<T>()
+                      | par_imap(square, std::declval<iter::thread_pool&>()));
+TEST_CASE("par_imap: has correct ctor and assign ops", "[par_imap]") {
+  REQUIRE(itertest::IsMoveConstructibleOnly<ImpT<std::vector<int>&>>::value);
+  REQUIRE(itertest::IsMoveConstructibleOnly<ImpT<std::vector<int>>>::value);
+}
@@ -0,0 +1,138 @@
+#include <cppitertools/imap.hpp>
+#include <cppitertools/peekable.hpp>
+#include <cppitertools/range.hpp>
+
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "catch.hpp"
+#include "helpers.hpp"
+
+using iter::peekable;
+using Vec = const std::vector<int>;
+
+TEST_CASE("peekable: yields the same elements", "[peekable]") {
+  Vec ns = {4, 5, 6};
+  SECTION("called directly") {
+    auto p = peekable(ns);
+    Vec v(std::begin(p), std::end(p));
+    REQUIRE(v == ns);
+  }
+  SECTION("with pipe") {
+    auto p = ns | peekable;
+    Vec v(std::begin(p), std::end(p));
+    REQUIRE(v == ns);
+  }
+}
+
+TEST_CASE("peekable: peek looks ahead", "[peekable]") {
+  Vec ns = {4, 5, 6};
+  auto p = peekable(ns);
+  auto it = std::begin(p);
+  REQUIRE(it.peek(0) == &*it);
+  REQUIRE(*it.peek() == 5);
+  REQUIRE(*it.peek(2) == 6);
+  REQUIRE(it.peek(3) == nullptr);
+  REQUIRE(*it == 4);
+  ++it;
+  REQUIRE(*it == 5);
+  REQUIRE(*it.peek() == 6);
+  REQUIRE(it.peek(2) == nullptr);
+  ++it;
+  REQUIRE(it.peek() == nullptr);
+  ++it;
+  REQUIRE(it == std::end(p));
+}
+
+TEST_CASE("peekable: refers to elements with lasting references",
+    "[peekable]") {
+  std::vector<int> ns = {1, 2};
+  auto p = peekable(ns);
+  auto it = std::begin(p);
+  REQUIRE(it.peek() == &ns[1]);
+  *it.peek() = 10;
+  ++it;
+  REQUIRE(*it == 10);
+}
+
+TEST_CASE("peekable: takes each element once from single pass iterables",
+    "[peekable]") {
+  int calls = 0;
+  auto m = iter::imap(
+      [&calls](int i) {
+        ++calls;
+        return std::to_string(i);
+      },
+      iter::range(5));
+  auto p = peekable(m);
+  auto it = std::begin(p);
+  REQUIRE(*it.peek(3) == "3");
+  REQUIRE(calls == 4);
+  std::vector<std::string> v;
+  for (; it != std::end(p); ++it) {
+    v.push_back(*it);
+  }
+  REQUIRE(v == std::vector<std::string>{"0", "1", "2", "3", "4"});
+  REQUIRE(calls == 5);
+}
+
+TEST_CASE("peekable: works with move-only elements", "[peekable]") {
+  auto m = iter::imap([](int i) { return std::make_unique<int>(i); },
+      iter::range(3));
+  auto p = peekable(m);
+  auto it = std::begin(p);
+  REQUIRE(**it.peek(2) == 2);
+  auto up = std::move(*it);
+  REQUIRE(*up == 0);
+}
+
+TEST_CASE("peekable: empty iterable", "[peekable]") {
+  Vec ns{};
+  auto p = peekable(ns);
+  REQUIRE(std::begin(p) == std::end(p));
+}
+
+TEST_CASE("peekable: postfix ++", "[peekable]") {
+  Vec ns = {1, 2};
+  auto p = peekable(ns);
+  auto it = std::begin(p);
+  REQUIRE(*it++ == 1);
+  REQUIRE(*it == 2);
+  it++;
+  REQUIRE(it == std::end(p));
+}
+
+TEST_CASE("peekable: const iteration", "[peekable][const]") {
+  Vec ns = {1, 2};
+  const auto p = peekable(ns);
+  Vec v(std::begin(p), std::end(p));
+  REQUIRE(v == ns);
+}
+
+TEST_CASE("peekable: binds reference to lvalue and moves rvalue",
+    "[peekable]") {
+  itertest::BasicIterable<int> bi{1, 2};
+  SECTION("binds to lvalues") {
+    peekable(bi);
+    REQUIRE_FALSE(bi.was_moved_from());
+  }
+  SECTION("moves rvalues") {
+    peekable(std::move(bi));
+    REQUIRE(bi.was_moved_from());
+  }
+}
+
+TEST_CASE("peekable: iterator meets requirements", "[peekable]") {
+  Vec ns{};
+  auto p = peekable(ns);
+  REQUIRE(itertest::IsIterator<decltype(std::begin(p))>::value);
+}
+
+template <typename T>
+using ImpT = decltype(peekable(std::declval<T>()));
+TEST_CASE("peekable: has correct ctor and assign ops", "[peekable]") {
+  REQUIRE(itertest::IsMoveConstructibleOnly<ImpT<std::vector<int>&>>::value);
+  REQUIRE(itertest::IsMoveConstructibleOnly<ImpT<std::vector<int>>>::value);
+}
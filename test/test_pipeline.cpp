@@ -0,0 +1,244 @@
+#include <cppitertools/chain.hpp>
+#include <cppitertools/filter.hpp>
+#include <cppitertools/imap.hpp>
+#include <cppitertools/pipeline.hpp>
+#include <cppitertools/range.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iterator>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "catch.hpp"
+#include "helpers.hpp"
+
+using iter::stage;
+using iter::unordered_stage;
+using Vec = const std::vector<int>;
+
+namespace {
+  std::vector<int> squares_up_to(int n) {
+    std::vector<int> v;
+    for (int i = 0; i < n; ++i) {
+      v.push_back(i * i);
+    }
+    return v;
+  }
+
+  auto square = [](int i) { return i * i; };
+}
+
+TEST_CASE("stage: ordered output matches the adaptor alone", "[stage]") {
+  std::vector<int> ns(500);
+  for (std::size_t i = 0; i < ns.size(); ++i) {
+    ns[i] = static_cast<int>(i);
+  }
+  for (std::size_t threads : {1u, 2u, 4u}) {
+    for (std::size_t queue_size : {1u, 3u, 64u}) {
+      auto s = ns | stage(iter::imap(square), threads, queue_size);
+      Vec v(std::begin(s), std::end(s));
+      REQUIRE(v == squares_up_to(500));
+    }
+  }
+}
+
+TEST_CASE("stage: filter stages drop elements in order", "[stage]") {
+  auto is_odd = [](int i) { return i % 2 == 1; };
+  for (std::size_t threads : {1u, 3u}) {
+    auto s = iter::range(20) | stage(iter::filter(is_odd), threads, 4);
+    Vec v(std::begin(s), std::end(s));
+    Vec vc = {1, 3, 5, 7, 9, 11, 13, 15, 17, 19};
+    REQUIRE(v == vc);
+  }
+}
+
+TEST_CASE("stage: several stages in a row", "[stage]") {
+  auto s = iter::range(100) | stage(iter::imap(square))
+           | stage(iter::filter([](int i) { return i % 3 == 0; }), 2)
+           | stage(iter::imap([](int i) { return std::to_string(i); }), 4, 8);
+  std::vector<std::string> v(std::begin(s), std::end(s));
+  std::vector<std::string> vc;
+  for (int i = 0; i < 100; ++i) {
+    if (i * i % 3 == 0) {
+      vc.push_back(std::to_string(i * i));
+    }
+  }
+  REQUIRE(v == vc);
+}
+
+TEST_CASE("stage: adaptors with several outputs per element", "[stage]") {
+  std::vector<std::vector<int>> vv{{1, 2}, {}, {3}, {4, 5, 6}};
+  auto s = vv | stage(iter::chain.from_iterable, 3, 2);
+  Vec v(std::begin(s), std::end(s));
+  Vec vc = {1, 2, 3, 4, 5, 6};
+  REQUIRE(v == vc);
+}
+
+TEST_CASE("stage: runs on several threads", "[stage]") {
+  std::mutex m;
+  std::set<std::thread::id> ids;
+  auto record = [&](int i) {
+    {
+      std::lock_guard<std::mutex> lock{m};
+      ids.insert(std::this_thread::get_id());
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    return i;
+  };
+  auto s = iter::range(40) | stage(iter::imap(record), 4);
+  Vec v(std::begin(s), std::end(s));
+  REQUIRE(v.size() == 40);
+  REQUIRE(ids.count(std::this_thread::get_id()) == 0);
+  REQUIRE(ids.size() > 1);
+}
+
+TEST_CASE("unordered_stage: yields every output", "[stage]") {
+  auto s = iter::range(300) | unordered_stage(iter::imap(square), 4, 5);
+  std::vector<int> v(std::begin(s), std::end(s));
+  std::sort(v.begin(), v.end());
+  REQUIRE(v == squares_up_to(300));
+}
+
+TEST_CASE("stage: empty iterable", "[stage]") {
+  std::vector<int> ns;
+  auto s = ns | stage(iter::imap(square), 3);
+  REQUIRE(std::begin(s) == std::end(s));
+  auto u = ns | unordered_stage(iter::imap(square), 3);
+  REQUIRE(std::begin(u) == std::end(u));
+}
+
+TEST_CASE("stage: rethrows exceptions after earlier output", "[stage]") {
+  auto fails_on_5 = [](int i) {
+    if (i == 5) {
+      throw std::runtime_error{"bad element"};
+    }
+    return i;
+  };
+  auto s = iter::range(100) | stage(iter::imap(fails_on_5), 3, 4);
+  std::vector<int> v;
+  REQUIRE_THROWS_AS(
+      [&] {
+        for (auto i : s) {
+          v.push_back(i);
+        }
+      }(),
+      std::runtime_error);
+  Vec vc = {0, 1, 2, 3, 4};
+  REQUIRE(v == vc);
+}
+
+TEST_CASE("stage: an earlier slow element isn't dropped by a later throw",
+    "[stage]") {
+  auto slow_then_fail = [](int i) {
+    if (i == 0) {
+      std::this_thread::sleep_for(std::chrono::milliseconds{50});
+    } else if (i == 1) {
+      throw std::runtime_error{"bad element"};
+    }
+    return i;
+  };
+  auto s = iter::range(10) | stage(iter::imap(slow_then_fail), 2, 4);
+  std::vector<int> v;
+  REQUIRE_THROWS_AS(
+      [&] {
+        for (auto i : s) {
+          v.push_back(i);
+        }
+      }(),
+      std::runtime_error);
+  REQUIRE(v == Vec{0});
+}
+
+TEST_CASE("stage: applies backpressure and stops early", "[stage]") {
+  std::atomic<int> taken{0};
+  {
+    auto s = iter::range(1000000) | iter::imap([&taken](int i) {
+      ++taken;
+      return i;
+    }) | stage(iter::imap(square), 2, 4);
+    for (auto i : s) {
+      if (i == 9) {
+        break;
+      }
+    }
+  }
+  // 4 consumed, at most 4 waiting, and one being worked on per thread
+  REQUIRE(taken.load() <= 4 + 4 + 2 + 1);
+}
+
+TEST_CASE("stage: counts items and busy time", "[stage]") {
+  auto slow_odd = [](int i) {
+    std::this_thread::sleep_for(std::chrono::microseconds(200));
+    return i % 2 == 1;
+  };
+  auto s = iter::range(20) | stage(iter::filter(slow_odd), 2);
+  Vec v(std::begin(s), std::end(s));
+  REQUIRE(v.size() == 10);
+  auto stats = s.stats();
+  REQUIRE(stats.items_in == 20);
+  REQUIRE(stats.items_out == 10);
+  REQUIRE(stats.busy >= std::chrono::microseconds(20 * 200));
+}
+
+TEST_CASE("stage: postfix ++ keeps the old element", "[stage]") {
+  std::vector<std::string> strs{"a", "b", "c"};
+  auto s = strs | stage(iter::imap([](const std::string& x) { return x; }));
+  auto it = std::begin(s);
+  REQUIRE(*it++ == "a");
+  REQUIRE(*it == "b");
+}
+
+TEST_CASE("stage: postfix ++ on the adaptor's source keeps the old element",
+    "[stage]") {
+  // takes the elements of its source with *it++
+  auto postfix_copy = [](auto&& source) {
+    std::vector<std::string> out;
+    for (auto it = std::begin(source); it != std::end(source);) {
+      out.push_back(*it++);
+    }
+    return out;
+  };
+  std::vector<std::string> strs{"a", "b", "c", "d"};
+  auto s = strs | unordered_stage(postfix_copy, 1);
+  std::vector<std::string> v(std::begin(s), std::end(s));
+  REQUIRE(v == strs);
+}
+
+TEST_CASE("stage: const iteration", "[stage][const]") {
+  std::vector<int> ns{1, 2, 3};
+  const auto s = ns | stage(iter::imap(square), 2);
+  Vec v(std::begin(s), std::end(s));
+  Vec vc = {1, 4, 9};
+  REQUIRE(v == vc);
+}
+
+TEST_CASE("stage: binds reference to lvalue and moves rvalue", "[stage]") {
+  itertest::BasicIterable<int> bi{1, 2};
+  SECTION("binds to lvalues") {
+    bi | stage(iter::imap(square));
+    REQUIRE_FALSE(bi.was_moved_from());
+  }
+  SECTION("moves rvalues") {
+    std::move(bi) | stage(iter::imap(square));
+    REQUIRE(bi.was_moved_from());
+  }
+}
+
+TEST_CASE("stage: iterator meets requirements", "[stage]") {
+  std::vector<int> ns{};
+  auto s = ns | stage(iter::imap(square));
+  REQUIRE(itertest::IsIterator<decltype(std::begin(s))>::value);
+}
+
+template <typename T>
+using ImpT = decltype(std::declval<T>() | stage(iter::imap(square)));
+TEST_CASE("stage: has correct ctor and assign ops", "[stage]") {
+  REQUIRE(itertest::IsMoveConstructibleOnly<ImpT<std::vector<int>&>>::value);
+  REQUIRE(itertest::IsMoveConstructibleOnly<ImpT<std::vector<int>>>::value);
+}
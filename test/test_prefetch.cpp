@@ -0,0 +1,166 @@
+#include <cppitertools/imap.hpp>
+#include <cppitertools/prefetch.hpp>
+#include <cppitertools/range.hpp>
+
+#include <atomic>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "catch.hpp"
+#include "helpers.hpp"
+
+using iter::prefetch;
+using Vec = const std::vector<int>;
+
+TEST_CASE("prefetch: yields the same elements in order", "[prefetch]") {
+  std::vector<int> ns(1000);
+  for (std::size_t i = 0; i < ns.size(); ++i) {
+    ns[i] = static_cast<int>(i * 3);
+  }
+  for (std::size_t buffer_size : {1u, 2u, 7u, 64u, 5000u}) {
+    std::vector<int> v;
+    SECTION("Normal call " + std::to_string(buffer_size)) {
+      auto p = prefetch(ns, buffer_size);
+      v.assign(std::begin(p), std::end(p));
+      REQUIRE(v == ns);
+    }
+    SECTION("Pipe " + std::to_string(buffer_size)) {
+      auto p = ns | prefetch(buffer_size);
+      v.assign(std::begin(p), std::end(p));
+      REQUIRE(v == ns);
+    }
+  }
+}
+
+TEST_CASE("prefetch: empty iterable", "[prefetch]") {
+  std::vector<int> ns;
+  auto p = prefetch(ns, 4);
+  REQUIRE(std::begin(p) == std::end(p));
+}
+
+TEST_CASE("prefetch: buffer size of zero acts as one", "[prefetch]") {
+  Vec ns{1, 2, 3};
+  auto p = prefetch(ns, 0);
+  Vec v(std::begin(p), std::end(p));
+  REQUIRE(v == ns);
+}
+
+TEST_CASE("prefetch: runs the underlying iterable on another thread",
+    "[prefetch]") {
+  const auto consumer_id = std::this_thread::get_id();
+  std::vector<std::thread::id> ids;
+  auto p = prefetch(iter::imap(
+                        [&ids](int i) {
+                          ids.push_back(std::this_thread::get_id());
+                          return i;
+                        },
+                        iter::range(10)),
+      4);
+  std::vector<int> v(std::begin(p), std::end(p));
+  REQUIRE(v == Vec{0, 1, 2, 3, 4, 5, 6, 7, 8, 9});
+  REQUIRE(ids.size() == 10);
+  for (auto id : ids) {
+    REQUIRE(id != consumer_id);
+  }
+}
+
+TEST_CASE("prefetch: moves values produced by the underlying iterable",
+    "[prefetch]") {
+  auto p = prefetch(iter::imap([](int i) { return std::make_unique<int>(i); },
+                        iter::range(5)),
+      2);
+  std::vector<int> v;
+  for (auto& ptr : p) {
+    v.push_back(*ptr);
+  }
+  REQUIRE(v == Vec{0, 1, 2, 3, 4});
+}
+
+TEST_CASE("prefetch: rethrows exceptions after earlier elements",
+    "[prefetch]") {
+  auto p = prefetch(iter::imap(
+                        [](int i) {
+                          if (i == 3) {
+                            throw std::runtime_error{"bad element"};
+                          }
+                          return i;
+                        },
+                        iter::range(10)),
+      8);
+  std::vector<int> v;
+  REQUIRE_THROWS_AS(
+      [&] {
+        for (auto i : p) {
+          v.push_back(i);
+        }
+      }(),
+      std::runtime_error);
+  REQUIRE(v == Vec{0, 1, 2});
+}
+
+TEST_CASE("prefetch: stops the producer when the consumer stops early",
+    "[prefetch]") {
+  std::atomic<int> produced{0};
+  {
+    auto p = prefetch(iter::imap(
+                          [&produced](int i) {
+                            ++produced;
+                            return i;
+                          },
+                          iter::range(1000000)),
+        4);
+    for (auto i : p) {
+      if (i == 2) {
+        break;
+      }
+    }
+  }
+  // the consumer took 3, and the producer can't be more than one element
+  // past the 4 that fit in the buffer
+  REQUIRE(produced.load() <= 3 + 4 + 1);
+}
+
+TEST_CASE("prefetch: postfix ++ keeps the old element", "[prefetch]") {
+  std::vector<std::string> strs{"a", "b", "c"};
+  auto p = prefetch(strs, 1);
+  auto it = std::begin(p);
+  REQUIRE(*it++ == "a");
+  REQUIRE(*it == "b");
+}
+
+TEST_CASE("prefetch: const iteration", "[prefetch][const]") {
+  std::vector<int> ns{1, 2, 3};
+  const auto p = prefetch(ns, 2);
+  Vec v(std::begin(p), std::end(p));
+  REQUIRE(v == ns);
+}
+
+TEST_CASE("prefetch: binds reference to lvalue and moves rvalue",
+    "[prefetch]") {
+  itertest::BasicIterable<int> bi{1, 2};
+  SECTION("binds to lvalues") {
+    prefetch(bi, 2);
+    REQUIRE_FALSE(bi.was_moved_from());
+  }
+  SECTION("moves rvalues") {
+    prefetch(std::move(bi), 2);
+    REQUIRE(bi.was_moved_from());
+  }
+}
+
+TEST_CASE("prefetch: iterator meets requirements", "[prefetch]") {
+  std::vector<int> ns{};
+  auto p = prefetch(ns, 2);
+  REQUIRE(itertest::IsIterator<decltype(std::begin(p))>::value);
+}
+
+template <typename T>
+using ImpT = decltype(prefetch(std::declval<T>(), 1));
+TEST_CASE("prefetch: has correct ctor and assign ops", "[prefetch]") {
+  REQUIRE(itertest::IsMoveConstructibleOnly<ImpT<std::vector<int>&>>::value);
+  REQUIRE(itertest::IsMoveConstructibleOnly<ImpT<std::vector<int>>>::value);
+}
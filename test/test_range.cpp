@@ -1,7 +1,12 @@
+#include "cppitertools/chunked.hpp"
 #include "cppitertools/range.hpp"
+#include "cppitertools/reversed.hpp"
+#include "cppitertools/slice.hpp"
 
 #include <algorithm>
 #include <iterator>
+#include <limits>
+#include <type_traits>
 #include <vector>
 
 #include "catch.hpp"
@@ -383,3 +388,242 @@ TEMPLATE_TEST_CASE("range: .size() with unsigned integrals", "[range]",
     }
   }
 }
+
+TEST_CASE("range: integral iterators are random access", "[range]") {
+  auto r = range(3, 20, 4);
+  auto it = std::begin(r);
+  REQUIRE(std::is_same<std::iterator_traits<decltype(it)>::iterator_category,
+      std::random_access_iterator_tag>::value);
+  REQUIRE(std::end(r) - it == 5);
+  REQUIRE(it[2] == 11);
+  it += 3;
+  REQUIRE(*it == 15);
+  REQUIRE(*(it - 2) == 7);
+  --it;
+  REQUIRE(*it == 11);
+  REQUIRE(std::begin(r) < it);
+  REQUIRE(it + 3 == std::end(r));
+
+  Vec v(std::rbegin(r), std::rend(r));
+  Vec vc{19, 15, 11, 7, 3};
+  REQUIRE(v == vc);
+}
+
+TEMPLATE_TEST_CASE("range: .index_of() and .contains() match a linear search",
+    "[range]", signed char, int, long long, unsigned char, unsigned int) {
+  constexpr bool is_signed = std::is_signed<TestType>::value;
+  const int low = is_signed ? -6 : 0;
+  for (int start = low; start < 6; ++start) {
+    for (int stop = low; stop < 6; ++stop) {
+      for (int step = is_signed ? -4 : 1; step < 4; ++step) {
+        if (step == 0) {
+          continue;
+        }
+        auto r = range(static_cast<TestType>(start),
+            static_cast<TestType>(stop), static_cast<TestType>(step));
+        std::vector<TestType> v(std::begin(r), std::end(r));
+        for (int i = low - 2; i < 8; ++i) {
+          auto val = static_cast<TestType>(i);
+          auto pos = std::find(std::begin(v), std::end(v), val);
+          REQUIRE(r.contains(val) == (pos != std::end(v)));
+          if (pos != std::end(v)) {
+            REQUIRE(r.index_of(val)
+                    == static_cast<std::size_t>(pos - std::begin(v)));
+          } else {
+            REQUIRE_FALSE(r.index_of(val));
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST_CASE("range: .contains() with extreme values", "[range]") {
+  auto r = range(-100, 100, 7);
+  REQUIRE(r.contains(-100));
+  REQUIRE(r.contains(96));
+  REQUIRE_FALSE(r.contains(103));
+  REQUIRE_FALSE(r.contains(std::numeric_limits<int>::max()));
+  REQUIRE_FALSE(r.contains(std::numeric_limits<int>::min()));
+}
+
+TEST_CASE("range: slice produces a Range", "[range]") {
+  auto r = range(3, 40, 4);
+  auto s = iter::slice(r, 2, 7, 2);
+  REQUIRE(std::is_same<decltype(s), iter::impl::Range<int>>::value);
+  Vec v(std::begin(s), std::end(s));
+  Vec vc{11, 19, 27};
+  REQUIRE(v == vc);
+
+  auto s2 = r | iter::slice(8);
+  REQUIRE(s2.size() == 8);
+  REQUIRE(s2[7] == 31);
+}
+
+TEST_CASE("range: slice matches slicing the elements", "[range]") {
+  for (int start = -5; start < 5; ++start) {
+    for (int stop = -5; stop < 5; ++stop) {
+      for (int step = -3; step < 4; ++step) {
+        if (step == 0) {
+          continue;
+        }
+        auto r = range(start, stop, step);
+        Vec elems(std::begin(r), std::end(r));
+        for (int s_start = -7; s_start < 7; s_start += 2) {
+          for (int s_stop = -7; s_stop < 7; s_stop += 2) {
+            for (int s_step = -1; s_step < 4; ++s_step) {
+              auto s = iter::slice(r, s_start, s_stop, s_step);
+              auto sv = iter::slice(elems, s_start, s_stop, s_step);
+              Vec v(std::begin(s), std::end(s));
+              Vec vc(std::begin(sv), std::end(sv));
+              REQUIRE(v == vc);
+              REQUIRE(s.size() == vc.size());
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST_CASE("range: reversed produces a Range", "[range]") {
+  for (int start = -5; start < 5; ++start) {
+    for (int stop = -5; stop < 5; ++stop) {
+      for (int step = -3; step < 4; ++step) {
+        if (step == 0) {
+          continue;
+        }
+        auto r = range(start, stop, step);
+        auto rr = iter::reversed(r);
+        REQUIRE(std::is_same<decltype(rr), iter::impl::Range<int>>::value);
+        Vec v(std::begin(rr), std::end(rr));
+        Vec vc(std::rbegin(r), std::rend(r));
+        REQUIRE(v == vc);
+      }
+    }
+  }
+}
+
+TEST_CASE("range: reversed at the ends of the type", "[range]") {
+  constexpr int lo = std::numeric_limits<int>::min();
+  constexpr int hi = std::numeric_limits<int>::max();
+
+  auto down = iter::reversed(range(hi, hi - 3, -1));
+  REQUIRE(down.size() == 3);
+  REQUIRE(Vec(std::begin(down), std::end(down)) == Vec{hi - 2, hi - 1, hi});
+  REQUIRE(down.contains(hi));
+  REQUIRE(down.index_of(hi - 1) == std::size_t{1});
+
+  auto up = iter::reversed(range(lo, lo + 3));
+  REQUIRE(up.size() == 3);
+  REQUIRE(Vec(std::begin(up), std::end(up)) == Vec{lo + 2, lo + 1, lo});
+  REQUIRE(up.contains(lo));
+
+  auto stepped = iter::reversed(range(lo, lo + 10, 4));
+  REQUIRE(Vec(std::begin(stepped), std::end(stepped))
+          == Vec{lo + 8, lo + 4, lo});
+
+  // sub-ranges of these keep their last element too
+  auto part = up.slice(1, 3);
+  REQUIRE(Vec(std::begin(part), std::end(part)) == Vec{lo + 1, lo});
+  auto one = up.slice(2, 3);
+  REQUIRE(Vec(std::begin(one), std::end(one)) == Vec{lo});
+  auto back = iter::reversed(up);
+  REQUIRE(Vec(std::begin(back), std::end(back)) == Vec{lo, lo + 1, lo + 2});
+  auto chunks = up.chunked(2);
+  REQUIRE(chunks.size() == 2);
+  REQUIRE(chunks[1].size() == 1);
+  REQUIRE(*std::begin(chunks[1]) == lo);
+
+  auto small = iter::reversed(range<signed char>(-128, -125));
+  REQUIRE(small.size() == 3);
+  REQUIRE(*std::begin(small) == -126);
+}
+
+TEST_CASE("range: reversed with unsigned ranges", "[range]") {
+  auto r = range(2u, 11u, 3u);
+  std::vector<unsigned> v;
+  for (auto i : r | iter::reversed) {
+    v.push_back(i);
+  }
+  std::vector<unsigned> vc{8, 5, 2};
+  REQUIRE(v == vc);
+}
+
+TEST_CASE("range: chunked produces Ranges", "[range]") {
+  auto r = range(1, 20, 2);
+  auto c = iter::chunked(r, 4);
+  REQUIRE(c.size() == 3);
+  std::vector<std::vector<int>> v;
+  for (auto&& chunk : c) {
+    REQUIRE(std::is_same<std::decay_t<decltype(chunk)>,
+        iter::impl::Range<int>>::value);
+    v.emplace_back(std::begin(chunk), std::end(chunk));
+  }
+  std::vector<std::vector<int>> vc{{1, 3, 5, 7}, {9, 11, 13, 15}, {17, 19}};
+  REQUIRE(v == vc);
+  REQUIRE(c[1].start() == 9);
+  REQUIRE(std::end(c) - std::begin(c) == 3);
+}
+
+TEST_CASE("range: chunked with 0 and with an empty range", "[range]") {
+  auto c = iter::chunked(range(10), 0);
+  REQUIRE(std::begin(c) == std::end(c));
+  auto c2 = range(0) | iter::chunked(3);
+  REQUIRE(std::begin(c2) == std::end(c2));
+}
+
+TEST_CASE("range: chunked with chunks larger than the range", "[range]") {
+  const auto max = std::numeric_limits<std::size_t>::max();
+  auto c = iter::chunked(range(10), max);
+  REQUIRE(c.size() == 1);
+  REQUIRE(std::end(c) - std::begin(c) == 1);
+  REQUIRE(Vec(std::begin(c[0]), std::end(c[0]))
+          == Vec{0, 1, 2, 3, 4, 5, 6, 7, 8, 9});
+
+  auto c2 = iter::chunked(range(10), max - 1);
+  REQUIRE(c2.size() == 1);
+  REQUIRE(c2[0].size() == 10);
+
+  auto c3 = iter::chunked(range(10), 7);
+  REQUIRE(c3.size() == 2);
+  REQUIRE(Vec(std::begin(c3[1]), std::end(c3[1])) == Vec{7, 8, 9});
+}
+
+TEST_CASE("range: blocks of a range near the size limit", "[range]") {
+  const auto max = std::numeric_limits<std::size_t>::max();
+  auto r = range(std::size_t{0}, max);
+  REQUIRE(r.size() == max);
+  auto bl = r.blocks<4>();
+  REQUIRE(bl.size() == max / 4 + 1);
+  auto last = bl[bl.size() - 1];
+  REQUIRE(last.size() == max % 4);
+  REQUIRE(last[0] == max - max % 4);
+}
+
+TEST_CASE("range: blocks", "[range]") {
+  auto r = range(5, 40, 3);
+  std::vector<int> v;
+  std::vector<std::size_t> sizes;
+  auto bl = r.blocks<4>();
+  REQUIRE(bl.size() == 3);
+  for (auto&& block : bl) {
+    sizes.push_back(block.size());
+    REQUIRE(block.lanes() == 4);
+    v.insert(std::end(v), block.data(), block.data() + block.size());
+  }
+  Vec vc(std::begin(r), std::end(r));
+  REQUIRE(v == vc);
+  REQUIRE(sizes == std::vector<std::size_t>{4, 4, 4});
+
+  auto last = *std::prev(std::end(range(10).blocks<4>()));
+  REQUIRE_FALSE(last.full());
+  REQUIRE(last.size() == 2);
+  REQUIRE(last[1] == 9);
+  REQUIRE(last[2] == 0);
+}
+
+TEST_CASE("range: blocks of an empty range", "[range]") {
+  auto bl = range(0).blocks<8>();
+  REQUIRE(std::begin(bl) == std::end(bl));
+}
@@ -0,0 +1,108 @@
+#include <cppitertools/enumerate.hpp>
+#include <cppitertools/filter.hpp>
+#include <cppitertools/records.hpp>
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "catch.hpp"
+
+using iter::records;
+
+namespace {
+  struct Trade {
+    std::int64_t id;
+    double price;
+  };
+
+  template <typename T>
+  void write_file(const std::string& path, const std::vector<T>& items,
+      std::size_t extra_bytes = 0) {
+    std::ofstream out(path, std::ios::binary);
+    out.write(reinterpret_cast<const char*>(items.data()),
+        static_cast<std::streamsize>(items.size() * sizeof(T)));
+    for (std::size_t i = 0; i < extra_bytes; ++i) {
+      out.put('x');
+    }
+  }
+}
+
+TEST_CASE("records: reads fixed size records", "[records]") {
+  const std::string path = "test_records_basic.tmp";
+  write_file(path, std::vector<Trade>{{1, 1.5}, {2, 2.5}, {3, 3.5}});
+  {
+    auto rs = records<Trade>(path);
+    REQUIRE_FALSE(rs.error());
+    REQUIRE(rs.size() == 3);
+    REQUIRE(rs[1].id == 2);
+    REQUIRE(rs[2].price == 3.5);
+
+    std::vector<std::int64_t> ids;
+    for (const Trade& t : rs) {
+      ids.push_back(t.id);
+    }
+    REQUIRE(ids == std::vector<std::int64_t>{1, 2, 3});
+  }
+  std::remove(path.c_str());
+}
+
+TEST_CASE("records: ignores a partial last record", "[records]") {
+  const std::string path = "test_records_partial.tmp";
+  write_file(path, std::vector<std::int32_t>{7, 8}, 3);
+  {
+    auto rs = records<std::int32_t>(path);
+    REQUIRE(rs.size() == 2);
+    REQUIRE(std::accumulate(rs.begin(), rs.end(), 0) == 15);
+  }
+  std::remove(path.c_str());
+}
+
+TEST_CASE("records: empty and missing files", "[records]") {
+  const std::string path = "test_records_empty.tmp";
+  write_file(path, std::vector<int>{});
+  {
+    auto rs = records<int>(path);
+    REQUIRE_FALSE(rs.error());
+    REQUIRE(rs.empty());
+    REQUIRE(rs.begin() == rs.end());
+  }
+  std::remove(path.c_str());
+
+  auto missing = records<int>("test_records_does_not_exist.tmp");
+  REQUIRE(missing.error());
+  REQUIRE(missing.empty());
+}
+
+TEST_CASE("records: references survive a move", "[records]") {
+  const std::string path = "test_records_move.tmp";
+  write_file(path, std::vector<int>{1, 2, 3});
+  {
+    auto rs = records<int>(path);
+    const int* p = &rs[2];
+    auto moved = std::move(rs);
+    REQUIRE(p == &moved[2]);
+    REQUIRE(*p == 3);
+  }
+  std::remove(path.c_str());
+}
+
+TEST_CASE("records: composes with other tools", "[records]") {
+  const std::string path = "test_records_compose.tmp";
+  write_file(path, std::vector<Trade>{{1, 10.0}, {2, 99.0}, {3, 120.0}});
+  {
+    std::vector<std::int64_t> ids;
+    for (auto&& [i, t] : iter::enumerate(records<Trade>(path)
+                                         | iter::filter([](const Trade& t) {
+                                             return t.price > 50;
+                                           }))) {
+      ids.push_back(t.id * 10 + static_cast<std::int64_t>(i));
+    }
+    REQUIRE(ids == std::vector<std::int64_t>{20, 31});
+  }
+  std::remove(path.c_str());
+}
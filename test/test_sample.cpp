@@ -0,0 +1,280 @@
+#include <cppitertools/imap.hpp>
+#include <cppitertools/sample.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <list>
+#include <numeric>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "catch.hpp"
+#include "helpers.hpp"
+
+using iter::sample;
+using iter::sample_rate;
+using Vec = const std::vector<int>;
+
+namespace {
+  // counts the random numbers drawn from it
+  struct CountingEngine {
+    using result_type = std::mt19937::result_type;
+    std::mt19937 engine{12345};
+    long calls = 0;
+
+    static constexpr result_type min() {
+      return std::mt19937::min();
+    }
+
+    static constexpr result_type max() {
+      return std::mt19937::max();
+    }
+
+    result_type operator()() {
+      ++calls;
+      return engine();
+    }
+  };
+
+  std::vector<int> iota(int n) {
+    std::vector<int> v(static_cast<std::size_t>(n));
+    std::iota(v.begin(), v.end(), 0);
+    return v;
+  }
+
+  template <typename T>
+  std::vector<int> to_vec(T&& t) {
+    return {std::begin(t), std::end(t)};
+  }
+}
+
+TEST_CASE("sample: yields k distinct elements", "[sample]") {
+  const auto v = iota(100);
+  std::mt19937 rng{1};
+  auto s = to_vec(sample(v, 10, rng));
+  REQUIRE(s.size() == 10);
+  REQUIRE(std::set<int>(s.begin(), s.end()).size() == 10);
+  for (auto i : s) {
+    REQUIRE(i >= 0);
+    REQUIRE(i < 100);
+  }
+}
+
+TEST_CASE("sample: fewer elements than k", "[sample]") {
+  Vec v = {3, 1, 2};
+  std::mt19937 rng{1};
+  auto s = to_vec(sample(v, 5, rng));
+  std::sort(s.begin(), s.end());
+  REQUIRE(s == Vec{1, 2, 3});
+}
+
+TEST_CASE("sample: k of 0 or an empty iterable", "[sample]") {
+  Vec v = {1, 2};
+  std::mt19937 rng{1};
+  auto s = sample(v, 0, rng);
+  REQUIRE(std::begin(s) == std::end(s));
+  auto s2 = sample(Vec{}, 3, rng);
+  REQUIRE(std::begin(s2) == std::end(s2));
+}
+
+TEST_CASE("sample: each element is equally likely", "[sample]") {
+  const auto v = iota(10);
+  std::mt19937 rng{7};
+  std::vector<int> counts(10);
+  constexpr int trials = 20000;
+  for (int t = 0; t < trials; ++t) {
+    for (auto i : sample(v, 3, rng)) {
+      ++counts[static_cast<std::size_t>(i)];
+    }
+  }
+  // each is expected trials * 3 / 10 times
+  for (auto c : counts) {
+    REQUIRE(c > 5700);
+    REQUIRE(c < 6300);
+  }
+}
+
+TEST_CASE("sample: skips ahead rather than drawing for each element",
+    "[sample]") {
+  const auto v = iota(1000000);
+  CountingEngine rng;
+  auto s = to_vec(sample(v, 10, rng));
+  REQUIRE(s.size() == 10);
+  REQUIRE(rng.calls < 2000);
+
+  const std::list<int> l(v.begin(), v.begin() + 100000);
+  CountingEngine rng2;
+  REQUIRE(to_vec(sample(l, 10, rng2)).size() == 10);
+  REQUIRE(rng2.calls < 2000);
+}
+
+TEST_CASE("sample: copies elements of an iterable that yields values",
+    "[sample]") {
+  const auto v = iota(50);
+  std::mt19937 rng{3};
+  auto s = sample(iter::imap([](int i) { return std::to_string(i); }, v), 4,
+      rng);
+  std::vector<std::string> vs(std::begin(s), std::end(s));
+  REQUIRE(vs.size() == 4);
+}
+
+TEST_CASE("sample: yields references into the iterable", "[sample]") {
+  std::vector<int> v = {1, 2, 3};
+  std::mt19937 rng{3};
+  for (auto&& i : sample(v, 3, rng)) {
+    i *= 10;
+  }
+  REQUIRE(v == Vec{10, 20, 30});
+}
+
+TEST_CASE("sample: the same seed gives the same sample", "[sample]") {
+  const auto v = iota(1000);
+  auto s = to_vec(sample(v, 5, std::mt19937{42}));
+  auto s2 = to_vec(sample(v, 5, std::mt19937{42}));
+  REQUIRE(s == s2);
+}
+
+TEST_CASE("sample: reuses its sample", "[sample]") {
+  const auto v = iota(1000);
+  std::mt19937 rng{5};
+  auto s = sample(v, 5, rng);
+  REQUIRE(to_vec(s) == to_vec(s));
+}
+
+TEST_CASE("sample: an lvalue engine keeps advancing", "[sample]") {
+  const auto v = iota(1000);
+  std::mt19937 rng{5};
+  auto s = to_vec(sample(v, 5, rng));
+  auto s2 = to_vec(sample(v, 5, rng));
+  REQUIRE(s != s2);
+}
+
+TEST_CASE("sample: pipe", "[sample]") {
+  const auto v = iota(100);
+  auto s = to_vec(v | sample(3, std::mt19937{1}));
+  REQUIRE(s == to_vec(sample(v, 3, std::mt19937{1})));
+}
+
+TEST_CASE("sample: const iteration", "[sample][const]") {
+  std::vector<int> v = iota(20);
+  std::mt19937 rng{1};
+  const auto s = sample(v, 4, rng);
+  REQUIRE(to_vec(s).size() == 4);
+  REQUIRE(to_vec(s) == to_vec(s));
+}
+
+TEST_CASE("sample: const and non-const iteration share a sample",
+    "[sample][const]") {
+  const auto v = iota(1000);
+  SECTION("held by position") {
+    std::mt19937 rng{3};
+    auto s = sample(v, 5, rng);
+    const auto& cs = s;
+    auto const_drawn = to_vec(cs);
+    REQUIRE(to_vec(s) == const_drawn);
+    REQUIRE(to_vec(cs) == const_drawn);
+  }
+  SECTION("held by copy") {
+    std::mt19937 rng{3};
+    auto s = sample(iter::imap([](int i) { return i * 2; }, v), 5, rng);
+    const auto& cs = s;
+    auto drawn = to_vec(s);
+    REQUIRE(to_vec(cs) == drawn);
+  }
+  SECTION("of a list") {
+    std::list<int> ns(std::begin(v), std::end(v));
+    std::mt19937 rng{3};
+    auto s = sample(ns, 5, rng);
+    const auto& cs = s;
+    auto drawn = to_vec(s);
+    REQUIRE(to_vec(cs) == drawn);
+    REQUIRE(std::is_sorted(std::begin(drawn), std::end(drawn)));
+  }
+}
+
+TEST_CASE("sample: binds to lvalues and moves rvalues", "[sample]") {
+  itertest::BasicIterable<int> bi{1, 2};
+  std::mt19937 rng{1};
+  SECTION("binds to lvalues") {
+    sample(bi, 1, rng);
+    REQUIRE_FALSE(bi.was_moved_from());
+  }
+  SECTION("moves rvalues") {
+    sample(std::move(bi), 1, rng);
+    REQUIRE(bi.was_moved_from());
+  }
+}
+
+TEST_CASE("sample_rate: p of 0 and 1", "[sample_rate]") {
+  const auto v = iota(100);
+  std::mt19937 rng{1};
+  auto none = sample_rate(v, 0.0, rng);
+  REQUIRE(std::begin(none) == std::end(none));
+  REQUIRE(to_vec(sample_rate(v, 1.0, rng)) == v);
+}
+
+TEST_CASE("sample_rate: yields elements in order at about the rate",
+    "[sample_rate]") {
+  const auto v = iota(100000);
+  std::mt19937 rng{9};
+  auto s = to_vec(sample_rate(v, 0.1, rng));
+  REQUIRE(std::is_sorted(s.begin(), s.end()));
+  REQUIRE(std::adjacent_find(s.begin(), s.end()) == s.end());
+  REQUIRE(s.size() > 9500);
+  REQUIRE(s.size() < 10500);
+}
+
+TEST_CASE("sample_rate: draws about one random number per element yielded",
+    "[sample_rate]") {
+  const auto v = iota(1000000);
+  CountingEngine rng;
+  auto n = to_vec(sample_rate(v, 0.01, rng)).size();
+  REQUIRE(n > 9000);
+  // two 32-bit numbers for each double
+  REQUIRE(rng.calls < static_cast<long>(3 * n));
+}
+
+TEST_CASE("sample_rate: works with lists", "[sample_rate]") {
+  const std::list<int> l = {1, 2, 3, 4, 5};
+  std::mt19937 rng{1};
+  auto s = to_vec(sample_rate(l, 0.5, rng));
+  REQUIRE(std::includes(l.begin(), l.end(), s.begin(), s.end()));
+}
+
+TEST_CASE("sample_rate: yields references and operator->", "[sample_rate]") {
+  std::vector<std::string> v = {"ab", "cd"};
+  std::mt19937 rng{1};
+  auto s = sample_rate(v, 1.0, rng);
+  auto it = std::begin(s);
+  REQUIRE(it->size() == 2);
+  *it = "x";
+  REQUIRE(v[0] == "x");
+}
+
+TEST_CASE("sample_rate: pipe and const iteration", "[sample_rate][const]") {
+  const auto v = iota(10);
+  const auto s = v | sample_rate(1.0, std::mt19937{1});
+  REQUIRE(to_vec(s) == v);
+}
+
+TEST_CASE("sample_rate: binds to lvalues and moves rvalues",
+    "[sample_rate]") {
+  itertest::BasicIterable<int> bi{1, 2};
+  std::mt19937 rng{1};
+  SECTION("binds to lvalues") {
+    sample_rate(bi, 0.5, rng);
+    REQUIRE_FALSE(bi.was_moved_from());
+  }
+  SECTION("moves rvalues") {
+    sample_rate(std::move(bi), 0.5, rng);
+    REQUIRE(bi.was_moved_from());
+  }
+}
+
+TEST_CASE("sample_rate: iterator meets requirements", "[sample_rate]") {
+  std::mt19937 rng{1};
+  auto s = sample_rate(Vec{1}, 0.5, rng);
+  REQUIRE(itertest::IsIterator<decltype(std::begin(s))>::value);
+}
@@ -0,0 +1,363 @@
+#include <cppitertools/set_operations.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <list>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "catch.hpp"
+#include "helpers.hpp"
+
+using iter::set_difference;
+using iter::set_intersection;
+using iter::set_symmetric_difference;
+using iter::set_union;
+using Vec = const std::vector<int>;
+
+namespace {
+  // the std:: algorithm applied from left to right
+  template <typename Algorithm>
+  std::vector<int> fold(
+      Algorithm algorithm, const std::vector<std::vector<int>>& inputs) {
+    auto result = inputs.front();
+    for (std::size_t i = 1; i < inputs.size(); ++i) {
+      std::vector<int> next;
+      algorithm(result.begin(), result.end(), inputs[i].begin(),
+          inputs[i].end(), std::back_inserter(next));
+      result = std::move(next);
+    }
+    return result;
+  }
+
+  // numbers read from a string, which can only be walked once
+  class Numbers {
+   private:
+    std::istringstream in_;
+
+   public:
+    explicit Numbers(const std::string& s) : in_{s} {}
+
+    std::istream_iterator<int> begin() {
+      return std::istream_iterator<int>{in_};
+    }
+
+    std::istream_iterator<int> end() {
+      return {};
+    }
+  };
+
+  template <typename T>
+  std::vector<int> to_vec(T&& t) {
+    return std::vector<int>(std::begin(t), std::end(t));
+  }
+
+  std::vector<std::vector<int>> make_inputs(int seed) {
+    std::vector<std::vector<int>> inputs(3);
+    for (int i = 0; i < 300; ++i) {
+      auto val = (i * 7919 + seed * 31) % 61;
+      inputs[static_cast<std::size_t>((i * (seed + 3)) % 3)].push_back(val);
+    }
+    for (auto& in : inputs) {
+      std::sort(std::begin(in), std::end(in));
+    }
+    return inputs;
+  }
+}
+
+TEST_CASE("set_intersection: two sorted vectors", "[set_operations]") {
+  Vec a = {1, 2, 4, 5, 9};
+  Vec b = {2, 3, 5, 9, 10};
+  auto s = set_intersection(a, b);
+  Vec v(std::begin(s), std::end(s));
+  REQUIRE(v == Vec{2, 5, 9});
+}
+
+TEST_CASE("set_union: two sorted vectors", "[set_operations]") {
+  Vec a = {1, 2, 4};
+  Vec b = {2, 3, 10};
+  auto s = set_union(a, b);
+  Vec v(std::begin(s), std::end(s));
+  REQUIRE(v == Vec{1, 2, 3, 4, 10});
+}
+
+TEST_CASE("set_difference: two sorted vectors", "[set_operations]") {
+  Vec a = {1, 2, 4, 5, 9};
+  Vec b = {2, 3, 5};
+  auto s = set_difference(a, b);
+  Vec v(std::begin(s), std::end(s));
+  REQUIRE(v == Vec{1, 4, 9});
+}
+
+TEST_CASE("set_symmetric_difference: two sorted vectors", "[set_operations]") {
+  Vec a = {1, 2, 4};
+  Vec b = {2, 3, 4, 8};
+  auto s = set_symmetric_difference(a, b);
+  Vec v(std::begin(s), std::end(s));
+  REQUIRE(v == Vec{1, 3, 8});
+}
+
+TEST_CASE("set operations: match the std:: algorithms on multisets",
+    "[set_operations]") {
+  for (int seed = 0; seed < 5; ++seed) {
+    auto in = make_inputs(seed);
+    const auto& a = in[0];
+    const auto& b = in[1];
+    const auto& c = in[2];
+
+    auto i = set_intersection(a, b, c);
+    Vec vi(std::begin(i), std::end(i));
+    REQUIRE(vi == fold([](auto... args) {
+      return std::set_intersection(args...);
+    }, in));
+
+    auto u = set_union(a, b, c);
+    Vec vu(std::begin(u), std::end(u));
+    REQUIRE(vu == fold([](auto... args) {
+      return std::set_union(args...);
+    }, in));
+
+    auto d = set_difference(a, b, c);
+    Vec vd(std::begin(d), std::end(d));
+    REQUIRE(vd == fold([](auto... args) {
+      return std::set_difference(args...);
+    }, in));
+
+    auto sd = set_symmetric_difference(a, b, c);
+    Vec vsd(std::begin(sd), std::end(sd));
+    REQUIRE(vsd == fold([](auto... args) {
+      return std::set_symmetric_difference(args...);
+    }, in));
+
+    // the same, walking lists rather than searching
+    const std::list<int> la(a.begin(), a.end());
+    const std::list<int> lb(b.begin(), b.end());
+    auto li = set_intersection(la, lb, c);
+    REQUIRE(Vec(std::begin(li), std::end(li)) == vi);
+    auto lu = set_union(la, lb, c);
+    REQUIRE(Vec(std::begin(lu), std::end(lu)) == vu);
+    auto ld = set_difference(la, lb, c);
+    REQUIRE(Vec(std::begin(ld), std::end(ld)) == vd);
+  }
+}
+
+TEST_CASE("set operations: different iterable types", "[set_operations]") {
+  std::vector<int> a = {1, 3, 5, 7, 9};
+  std::list<int> b = {3, 4, 5, 9};
+  int c[] = {0, 5, 9, 20};
+  auto s = set_intersection(a, b, c);
+  Vec v(std::begin(s), std::end(s));
+  REQUIRE(v == Vec{5, 9});
+
+  auto u = set_union(b, c);
+  Vec vu(std::begin(u), std::end(u));
+  REQUIRE(vu == Vec{0, 3, 4, 5, 9, 20});
+}
+
+TEST_CASE("set operations: with a custom comparison", "[set_operations]") {
+  Vec a = {9, 5, 3, 1};
+  Vec b = {8, 5, 1, 0};
+  auto s = set_intersection(std::greater<>{}, a, b);
+  Vec v(std::begin(s), std::end(s));
+  REQUIRE(v == Vec{5, 1});
+
+  auto d = set_difference(std::greater<>{}, a, b);
+  Vec vd(std::begin(d), std::end(d));
+  REQUIRE(vd == Vec{9, 3});
+}
+
+TEST_CASE("set operations: equivalent elements come from the first iterable",
+    "[set_operations]") {
+  using P = std::pair<int, char>;
+  const std::vector<P> a = {{1, 'a'}, {2, 'a'}};
+  const std::vector<P> b = {{1, 'b'}, {2, 'b'}, {2, 'b'}, {3, 'b'}};
+  auto by_first = [](const P& lhs, const P& rhs) {
+    return lhs.first < rhs.first;
+  };
+  auto s = set_union(by_first, a, b);
+  std::vector<P> v(std::begin(s), std::end(s));
+  const std::vector<P> vc = {{1, 'a'}, {2, 'a'}, {2, 'b'}, {3, 'b'}};
+  REQUIRE(v == vc);
+
+  auto i = set_intersection(by_first, b, a);
+  std::vector<P> vi(std::begin(i), std::end(i));
+  const std::vector<P> vic = {{1, 'b'}, {2, 'b'}};
+  REQUIRE(vi == vic);
+}
+
+TEST_CASE("set operations: repeated elements come from where std:: takes them",
+    "[set_operations]") {
+  using P = std::pair<int, char>;
+  auto by_first = [](const P& lhs, const P& rhs) {
+    return lhs.first < rhs.first;
+  };
+  const std::vector<P> a = {{1, 'a'}, {2, 'a'}, {2, 'A'}, {2, '@'}};
+  const std::vector<P> b = {{1, 'b'}, {1, 'B'}, {1, '!'}, {2, 'b'}};
+
+  auto check = [&](auto&& ours, auto algorithm) {
+    std::vector<P> v(std::begin(ours), std::end(ours));
+    std::vector<P> expected;
+    algorithm(a.begin(), a.end(), b.begin(), b.end(),
+        std::back_inserter(expected), by_first);
+    REQUIRE(v == expected);
+  };
+  check(set_intersection(by_first, a, b),
+      [](auto... args) { return std::set_intersection(args...); });
+  check(set_union(by_first, a, b),
+      [](auto... args) { return std::set_union(args...); });
+  check(set_difference(by_first, a, b),
+      [](auto... args) { return std::set_difference(args...); });
+  check(set_symmetric_difference(by_first, a, b),
+      [](auto... args) { return std::set_symmetric_difference(args...); });
+
+  auto sd = set_symmetric_difference(by_first, a, b);
+  const std::vector<P> vsd = {{1, 'B'}, {1, '!'}, {2, 'A'}, {2, '@'}};
+  REQUIRE(std::vector<P>(std::begin(sd), std::end(sd)) == vsd);
+}
+
+TEST_CASE("set operations: iterables that can only be walked once",
+    "[set_operations]") {
+  REQUIRE(to_vec(set_intersection(Numbers{"1 2 2 3 5 7"}, Numbers{"2 2 3 4 7"}))
+          == Vec{2, 2, 3, 7});
+  REQUIRE(to_vec(set_union(Numbers{"1 2 2 3 5 7"}, Numbers{"2 3 4 7"}))
+          == Vec{1, 2, 2, 3, 4, 5, 7});
+  REQUIRE(to_vec(set_difference(Numbers{"1 2 2 3 5 7"}, Numbers{"2 7 8"}))
+          == Vec{1, 2, 3, 5});
+  REQUIRE(to_vec(set_symmetric_difference(
+              Numbers{"1 1 2 6"}, Numbers{"1 2 2 2 5"}, Numbers{"2 5 9"}))
+          == Vec{1, 2, 6, 9});
+
+  auto in = make_inputs(3);
+  std::vector<std::string> text(3);
+  for (std::size_t i = 0; i < in.size(); ++i) {
+    for (auto n : in[i]) {
+      text[i] += std::to_string(n) + ' ';
+    }
+  }
+  const std::list<int> b(in[1].begin(), in[1].end());
+  REQUIRE(to_vec(set_union(Numbers{text[0]}, b, Numbers{text[2]}))
+          == to_vec(set_union(in[0], in[1], in[2])));
+  REQUIRE(to_vec(set_intersection(Numbers{text[0]}, b, Numbers{text[2]}))
+          == to_vec(set_intersection(in[0], in[1], in[2])));
+
+  // each element is dereferenced once
+  itertest::InputIterable ii1;
+  itertest::InputIterable ii2;
+  REQUIRE(to_vec(set_union(ii1, ii2)) == Vec{0, 1, 2, 3, 4});
+}
+
+TEST_CASE("set operations: empty iterables", "[set_operations]") {
+  Vec a = {};
+  Vec b = {1, 2};
+  auto i = set_intersection(a, b);
+  REQUIRE(std::begin(i) == std::end(i));
+  auto u = set_union(a, b);
+  REQUIRE(std::distance(std::begin(u), std::end(u)) == 2);
+  auto d = set_difference(a, b);
+  REQUIRE(std::begin(d) == std::end(d));
+  auto d2 = set_difference(b, a);
+  REQUIRE(std::distance(std::begin(d2), std::end(d2)) == 2);
+}
+
+TEST_CASE("set_intersection: gallops through long iterables",
+    "[set_operations]") {
+  std::vector<int> big(100000);
+  for (std::size_t i = 0; i < big.size(); ++i) {
+    big[i] = static_cast<int>(i * 2);
+  }
+  std::vector<int> small = {10, 5000, 5001, 150000, 199998};
+  int comparisons = 0;
+  auto counted_less = [&comparisons](int lhs, int rhs) {
+    ++comparisons;
+    return lhs < rhs;
+  };
+  auto s = set_intersection(counted_less, small, big);
+  Vec v(std::begin(s), std::end(s));
+  REQUIRE(v == Vec{10, 5000, 150000, 199998});
+  REQUIRE(comparisons < 1000);
+}
+
+TEST_CASE("set operations: yield references into the iterables",
+    "[set_operations]") {
+  std::vector<int> a = {1, 3, 5};
+  std::vector<int> b = {3, 4};
+  for (auto&& i : set_difference(a, b)) {
+    i *= 10;
+  }
+  REQUIRE(a == Vec{10, 3, 50});
+}
+
+TEST_CASE("set operations: operator->", "[set_operations]") {
+  std::vector<std::string> a = {"a", "abc"};
+  std::vector<std::string> b = {"abc", "b"};
+  auto s = set_intersection(a, b);
+  auto it = std::begin(s);
+  REQUIRE(it->size() == 3);
+}
+
+TEST_CASE("set operations: const iteration", "[set_operations][const]") {
+  Vec a = {1, 3};
+  const auto s = set_union(a, Vec{2, 3});
+  Vec v(std::begin(s), std::end(s));
+  REQUIRE(v == Vec{1, 2, 3});
+}
+
+TEST_CASE("set operations: bind to lvalues and move rvalues",
+    "[set_operations]") {
+  itertest::BasicIterable<int> bi{1, 3};
+  SECTION("binds to lvalues") {
+    set_intersection(bi, Vec{3});
+    REQUIRE_FALSE(bi.was_moved_from());
+  }
+  SECTION("moves rvalues") {
+    set_intersection(std::move(bi), Vec{3});
+    REQUIRE(bi.was_moved_from());
+  }
+}
+
+TEST_CASE("set operations from_iterable: any number of iterables",
+    "[set_operations]") {
+  const std::vector<std::vector<int>> postings = {
+      {1, 3, 4, 7, 9, 12}, {3, 7, 8, 9}, {0, 3, 5, 7, 9, 11}};
+  std::vector<int> v;
+  SECTION("Normal call") {
+    auto s = set_intersection.from_iterable(postings);
+    v.assign(std::begin(s), std::end(s));
+    REQUIRE(v == Vec{3, 7, 9});
+  }
+  SECTION("Pipe") {
+    auto s = postings | set_union.from_iterable;
+    v.assign(std::begin(s), std::end(s));
+    REQUIRE(v == Vec{0, 1, 3, 4, 5, 7, 8, 9, 11, 12});
+  }
+  SECTION("Pipe with a custom comparison") {
+    auto s = postings | set_difference.from_iterable(std::less<>{});
+    v.assign(std::begin(s), std::end(s));
+    REQUIRE(v == Vec{1, 4, 12});
+  }
+  SECTION("No iterables") {
+    auto s = set_intersection.from_iterable(std::vector<std::vector<int>>{});
+    REQUIRE(std::begin(s) == std::end(s));
+  }
+}
+
+TEST_CASE("set operations from_iterable: match the variadic versions",
+    "[set_operations]") {
+  auto in = make_inputs(7);
+  auto s = set_symmetric_difference.from_iterable(in);
+  Vec v(std::begin(s), std::end(s));
+  auto s2 = set_symmetric_difference(in[0], in[1], in[2]);
+  Vec v2(std::begin(s2), std::end(s2));
+  REQUIRE(v == v2);
+}
+
+TEST_CASE("set operations: iterator meets requirements", "[set_operations]") {
+  Vec a = {1};
+  auto s = set_union(a, a);
+  REQUIRE(itertest::IsIterator<decltype(std::begin(s))>::value);
+  auto sf = set_union.from_iterable(std::vector<std::vector<int>>{});
+  REQUIRE(itertest::IsIterator<decltype(std::begin(sf))>::value);
+}
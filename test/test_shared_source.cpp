@@ -0,0 +1,179 @@
+#include <cppitertools/filter.hpp>
+#include <cppitertools/imap.hpp>
+#include <cppitertools/range.hpp>
+#include <cppitertools/shared_source.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "catch.hpp"
+#include "helpers.hpp"
+
+using iter::shared_source;
+using Vec = const std::vector<int>;
+
+namespace {
+  // runs num_threads loops over source, and returns everything they saw
+  template <typename Source>
+  std::vector<int> consume_on_threads(Source& source, int num_threads) {
+    std::vector<std::vector<int>> seen(num_threads);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < num_threads; ++i) {
+      threads.emplace_back([&source, &seen, i] {
+        for (auto&& n : source) {
+          seen[i].push_back(n);
+        }
+      });
+    }
+    std::vector<int> all;
+    for (int i = 0; i < num_threads; ++i) {
+      threads[i].join();
+      all.insert(all.end(), seen[i].begin(), seen[i].end());
+    }
+    std::sort(all.begin(), all.end());
+    return all;
+  }
+
+  std::vector<int> up_to(int n) {
+    std::vector<int> v;
+    for (int i = 0; i < n; ++i) {
+      v.push_back(i);
+    }
+    return v;
+  }
+}
+
+TEST_CASE("shared_source: one loop sees everything in order",
+    "[shared_source]") {
+  Vec ns = {1, 2, 3, 4, 5, 6, 7};
+  SECTION("random access") {
+    auto s = shared_source(ns, 3);
+    Vec v(std::begin(s), std::end(s));
+    REQUIRE(v == ns);
+  }
+  SECTION("single pass") {
+    auto s = iter::filter([](int) { return true; }, ns) | shared_source(3);
+    Vec v(std::begin(s), std::end(s));
+    REQUIRE(v == ns);
+  }
+}
+
+TEST_CASE("shared_source: claim returns batches", "[shared_source]") {
+  Vec ns = {1, 2, 3, 4, 5};
+  SECTION("random access") {
+    auto s = shared_source(ns, 2);
+    auto b = s.claim();
+    REQUIRE(b.size() == 2);
+    REQUIRE(&*b.begin() == &ns[0]);
+    REQUIRE(s.claim().size() == 2);
+    b = s.claim();
+    Vec v(b.begin(), b.end());
+    REQUIRE(v == Vec{5});
+    REQUIRE(s.claim().empty());
+    REQUIRE(s.claim().empty());
+  }
+  SECTION("lasting references") {
+    std::list<int> ls(ns.begin(), ns.end());
+    auto s = shared_source(ls, 2);
+    auto b = s.claim();
+    REQUIRE(&*b.begin() == &ls.front());
+    *b.begin() = 10;
+    REQUIRE(ls.front() == 10);
+  }
+  SECTION("copies of single pass elements") {
+    auto m = iter::imap([](int i) { return std::to_string(i); }, ns);
+    auto s = shared_source(m, 3);
+    auto b = s.claim();
+    std::vector<std::string> v(b.begin(), b.end());
+    REQUIRE(v == std::vector<std::string>{"1", "2", "3"});
+    REQUIRE(b.end() - b.begin() == 3);
+    REQUIRE(b.begin()[1] == "2");
+    REQUIRE(s.claim().size() == 2);
+    REQUIRE(s.claim().empty());
+  }
+}
+
+TEST_CASE("shared_source: threads share a random access iterable",
+    "[shared_source]") {
+  auto ns = up_to(100000);
+  for (std::size_t batch : {1u, 7u, 1000u, 1000000u}) {
+    auto s = shared_source(ns, batch);
+    REQUIRE(consume_on_threads(s, 4) == ns);
+  }
+}
+
+TEST_CASE("shared_source: threads share a single pass iterable",
+    "[shared_source]") {
+  auto m = iter::imap([](int i) { return i; }, iter::range(20000))
+           | iter::filter([](int i) { return i % 3 != 0; });
+  std::vector<int> vc;
+  for (int i = 0; i < 20000; ++i) {
+    if (i % 3 != 0) {
+      vc.push_back(i);
+    }
+  }
+  for (std::size_t batch : {1u, 64u}) {
+    auto s = shared_source(m, batch);
+    REQUIRE(consume_on_threads(s, 4) == vc);
+  }
+}
+
+TEST_CASE("shared_source: works with move-only elements", "[shared_source]") {
+  auto m = iter::imap(
+      [](int i) { return std::make_unique<int>(i); }, iter::range(5));
+  auto s = shared_source(m, 2);
+  std::vector<int> v;
+  for (auto&& up : s) {
+    v.push_back(*up);
+  }
+  REQUIRE(v == up_to(5));
+}
+
+TEST_CASE("shared_source: empty iterable", "[shared_source]") {
+  Vec ns{};
+  auto s = shared_source(ns, 4);
+  REQUIRE(std::begin(s) == std::end(s));
+  REQUIRE(s.claim().empty());
+}
+
+TEST_CASE("shared_source: postfix ++", "[shared_source]") {
+  Vec ns = {1, 2};
+  auto s = shared_source(ns, 1);
+  auto it = std::begin(s);
+  REQUIRE(*it++ == 1);
+  REQUIRE(*it == 2);
+  it++;
+  REQUIRE(it == std::end(s));
+}
+
+TEST_CASE("shared_source: binds reference to lvalue and moves rvalue",
+    "[shared_source]") {
+  itertest::BasicIterable<int> bi{1, 2};
+  SECTION("binds to lvalues") {
+    shared_source(bi, 2);
+    REQUIRE_FALSE(bi.was_moved_from());
+  }
+  SECTION("moves rvalues") {
+    shared_source(std::move(bi), 2);
+    REQUIRE(bi.was_moved_from());
+  }
+}
+
+TEST_CASE("shared_source: iterator meets requirements", "[shared_source]") {
+  Vec ns{};
+  auto s = shared_source(ns, 1);
+  REQUIRE(itertest::IsIterator<decltype(std::begin(s))>::value);
+}
+
+template <typename T>
+using ImpT = decltype(shared_source(std::declval<T>(), 1));
+TEST_CASE("shared_source: has correct ctor and assign ops",
+    "[shared_source]") {
+  REQUIRE(itertest::IsMoveConstructibleOnly<ImpT<std::vector<int>&>>::value);
+  REQUIRE(itertest::IsMoveConstructibleOnly<ImpT<std::vector<int>>>::value);
+}
@@ -0,0 +1,149 @@
+#include <cppitertools/range.hpp>
+#include <cppitertools/shuffled.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "catch.hpp"
+#include "helpers.hpp"
+
+using iter::shuffled;
+using Vec = const std::vector<int>;
+
+namespace {
+  std::vector<int> iota(int n) {
+    std::vector<int> v(static_cast<std::size_t>(n));
+    std::iota(v.begin(), v.end(), 0);
+    return v;
+  }
+
+  template <typename T>
+  std::vector<int> to_vec(T&& t) {
+    return {std::begin(t), std::end(t)};
+  }
+}
+
+TEST_CASE("shuffled: yields each element once", "[shuffled]") {
+  for (int n = 0; n < 300; n += 7) {
+    const auto v = iota(n);
+    for (std::size_t seed = 0; seed < 5; ++seed) {
+      auto s = to_vec(shuffled(v, seed));
+      std::sort(s.begin(), s.end());
+      REQUIRE(s == v);
+    }
+  }
+}
+
+TEST_CASE("shuffled: the seed chooses the order", "[shuffled]") {
+  const auto v = iota(1000);
+  auto s = to_vec(shuffled(v, 1));
+  REQUIRE(s != v);
+  REQUIRE(to_vec(shuffled(v, 1)) == s);
+  REQUIRE(to_vec(shuffled(v, 2)) != s);
+}
+
+TEST_CASE("shuffled: each position is about equally likely", "[shuffled]") {
+  const auto v = iota(10);
+  std::vector<int> counts(10);
+  constexpr std::size_t trials = 20000;
+  for (std::size_t seed = 0; seed < trials; ++seed) {
+    ++counts[static_cast<std::size_t>(shuffled(v, seed)[0])];
+  }
+  for (auto c : counts) {
+    REQUIRE(c > 1700);
+    REQUIRE(c < 2300);
+  }
+}
+
+TEST_CASE("shuffled: random access", "[shuffled]") {
+  const auto v = iota(100);
+  auto s = shuffled(v, 3);
+  auto it = std::begin(s);
+  REQUIRE(std::end(s) - it == 100);
+  REQUIRE(s.size() == 100);
+  auto all = to_vec(s);
+  REQUIRE(it[40] == all[40]);
+  REQUIRE(*(it + 99) == all[99]);
+  REQUIRE(s[7] == all[7]);
+  it += 10;
+  REQUIRE(*it == all[10]);
+  --it;
+  REQUIRE(*it == all[9]);
+  REQUIRE(std::begin(s) < it);
+}
+
+TEST_CASE("shuffled: shards cover the order once", "[shuffled]") {
+  const auto v = iota(103);
+  auto s = shuffled(v, 11);
+  std::vector<int> joined;
+  for (std::size_t i = 0; i < 7; ++i) {
+    auto shard = s.shard(i, 7);
+    REQUIRE(shard.size() >= 14);
+    REQUIRE(shard.size() <= 15);
+    joined.insert(joined.end(), std::begin(shard), std::end(shard));
+  }
+  REQUIRE(joined == to_vec(s));
+  auto past = s.shard(7, 7);
+  REQUIRE(std::begin(past) == std::end(past));
+}
+
+TEST_CASE("shuffled: a huge range", "[shuffled]") {
+  constexpr long long n = 10'000'000'000;
+  auto s = shuffled(iter::range(n), 99);
+  REQUIRE(s.size() == static_cast<std::size_t>(n));
+  std::set<long long> seen;
+  for (std::size_t i = 0; i < 1000; ++i) {
+    auto k = s[i];
+    REQUIRE(k >= 0);
+    REQUIRE(k < n);
+    seen.insert(k);
+  }
+  REQUIRE(seen.size() == 1000);
+  auto last = s.shard(999, 1000);
+  REQUIRE(last.size() == 10'000'000);
+}
+
+TEST_CASE("shuffled: yields references", "[shuffled]") {
+  std::vector<int> v = {1, 2, 3};
+  for (auto&& i : shuffled(v, 5)) {
+    i *= 10;
+  }
+  REQUIRE(v == Vec{10, 20, 30});
+}
+
+TEST_CASE("shuffled: operator->", "[shuffled]") {
+  const std::vector<std::string> v = {"abc"};
+  auto s = shuffled(v, 0);
+  REQUIRE(std::begin(s)->size() == 3);
+}
+
+TEST_CASE("shuffled: pipe and const iteration", "[shuffled][const]") {
+  const auto v = iota(50);
+  const auto s = v | shuffled(8);
+  REQUIRE(to_vec(s) == to_vec(shuffled(v, 8)));
+  REQUIRE(s[3] == to_vec(s)[3]);
+}
+
+TEST_CASE("shuffled: binds to lvalues and moves rvalues", "[shuffled]") {
+  auto v = iota(5);
+  SECTION("binds to lvalues") {
+    auto s = shuffled(v, 1);
+    v[0] = 100;
+    REQUIRE(std::count(std::begin(s), std::end(s), 100) == 1);
+  }
+  SECTION("moves rvalues") {
+    auto s = shuffled(std::move(v), 1);
+    REQUIRE(v.empty());
+    REQUIRE(to_vec(s).size() == 5);
+  }
+}
+
+TEST_CASE("shuffled: iterator meets requirements", "[shuffled]") {
+  Vec v = {1};
+  auto s = shuffled(v, 0);
+  REQUIRE(itertest::IsIterator<decltype(std::begin(s))>::value);
+}
@@ -0,0 +1,205 @@
+#include <cppitertools/itertools.hpp>
+#include <cppitertools/zip_longest.hpp>
+
+#include <forward_list>
+#include <iterator>
+#include <limits>
+#include <list>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "catch.hpp"
+#include "helpers.hpp"
+
+using iter::size_hint;
+using iter::SizeHint;
+using Vec = const std::vector<int>;
+
+namespace {
+  constexpr auto Max = std::numeric_limits<std::size_t>::max();
+
+  SizeHint exactly(std::size_t n) {
+    return {n, n};
+  }
+
+  SizeHint at_most(std::size_t n) {
+    return {0, n};
+  }
+
+  // the hint must hold for what's actually yielded
+  template <typename T>
+  void check_hint(T&& t) {
+    auto hint = size_hint(t);
+    auto n = static_cast<std::size_t>(
+        std::distance(std::begin(t), std::end(t)));
+    REQUIRE(hint.lower <= n);
+    if (hint.upper) {
+      REQUIRE(n <= *hint.upper);
+    }
+  }
+}
+
+TEST_CASE("size_hint: containers and plain iterables", "[size_hint]") {
+  Vec v = {1, 2, 3};
+  REQUIRE(size_hint(v) == exactly(3));
+  REQUIRE(size_hint(std::list<int>{1, 2}) == exactly(2));
+  int arr[4] = {};
+  REQUIRE(size_hint(arr) == exactly(4));
+  REQUIRE(size_hint(std::string("abcde")) == exactly(5));
+
+  std::forward_list<int> fl = {1, 2, 3};
+  REQUIRE(size_hint(fl) == SizeHint{});
+  REQUIRE_FALSE(size_hint(fl).exact());
+
+  itertest::BasicIterable<int> bi{1, 2, 3};
+  REQUIRE(size_hint(bi) == SizeHint{});
+}
+
+TEST_CASE("size_hint: ranges", "[size_hint]") {
+  REQUIRE(size_hint(iter::range(10)) == exactly(10));
+  REQUIRE(size_hint(iter::range(0, 10, 3)) == exactly(4));
+  REQUIRE(size_hint(iter::range(0.0, 1.0, 0.1)) == SizeHint{});
+}
+
+TEST_CASE("size_hint: one element out for each in", "[size_hint]") {
+  Vec v = {1, 2, 3, 4};
+  auto f = [](int i) { return i; };
+  REQUIRE(size_hint(iter::enumerate(v)) == exactly(4));
+  REQUIRE(size_hint(iter::imap(f, v)) == exactly(4));
+  REQUIRE(size_hint(iter::accumulate(v)) == exactly(4));
+  REQUIRE(size_hint(iter::reversed(v)) == exactly(4));
+  REQUIRE(size_hint(iter::sorted(v)) == exactly(4));
+  REQUIRE(size_hint(iter::peekable(v)) == exactly(4));
+  REQUIRE(size_hint(iter::enumerate(iter::enumerate(v))) == exactly(4));
+}
+
+TEST_CASE("size_hint: adaptors that drop elements", "[size_hint]") {
+  Vec v = {1, 2, 3, 4, 5};
+  auto pred = [](int i) { return i % 2 == 0; };
+  REQUIRE(size_hint(iter::filter(pred, v)) == at_most(5));
+  REQUIRE(size_hint(iter::filterfalse(pred, v)) == at_most(5));
+  REQUIRE(size_hint(iter::takewhile(pred, v)) == at_most(5));
+  REQUIRE(size_hint(iter::dropwhile(pred, v)) == at_most(5));
+  REQUIRE(size_hint(iter::unique_everseen(v)) == at_most(5));
+  REQUIRE(size_hint(iter::unique_justseen(v)) == at_most(5));
+  REQUIRE(size_hint(iter::compress(v, std::vector<bool>(3))) == at_most(3));
+  REQUIRE(size_hint(iter::enumerate(iter::filter(pred, v))) == at_most(5));
+}
+
+TEST_CASE("size_hint: zip and chain", "[size_hint]") {
+  Vec a = {1, 2, 3};
+  Vec b = {1, 2, 3, 4, 5};
+  std::forward_list<int> fl = {1};
+  REQUIRE(size_hint(iter::zip(a, b)) == exactly(3));
+  REQUIRE(size_hint(iter::zip()) == exactly(0));
+  REQUIRE(size_hint(iter::zip(a, fl)) == at_most(3));
+  REQUIRE(size_hint(iter::zip(a, iter::repeat(1))) == exactly(3));
+  REQUIRE(size_hint(iter::zip_longest(a, b)) == exactly(5));
+  REQUIRE(size_hint(iter::zip_longest(a, fl)) == SizeHint{3, {}});
+  REQUIRE(size_hint(iter::chain(a, b)) == exactly(8));
+  REQUIRE(size_hint(iter::chain(a, fl)) == SizeHint{3, {}});
+  std::vector<std::vector<int>> vv = {a, b};
+  REQUIRE(size_hint(iter::chain.from_iterable(vv)) == SizeHint{});
+  REQUIRE(size_hint(iter::merge(a, b)) == exactly(8));
+}
+
+TEST_CASE("size_hint: set operations", "[size_hint]") {
+  Vec a = {1, 2, 3};
+  Vec b = {2, 3, 4, 5};
+  REQUIRE(size_hint(iter::set_intersection(a, b)) == at_most(3));
+  REQUIRE(size_hint(iter::set_union(a, b)) == SizeHint{4, 7});
+  REQUIRE(size_hint(iter::set_difference(a, b)) == at_most(3));
+  REQUIRE(size_hint(iter::set_symmetric_difference(a, b)) == at_most(7));
+  check_hint(iter::set_union(a, b));
+  check_hint(iter::set_symmetric_difference(a, b));
+}
+
+TEST_CASE("size_hint: windows and chunks", "[size_hint]") {
+  Vec v = {1, 2, 3, 4, 5, 6, 7};
+  REQUIRE(size_hint(iter::sliding_window(v, 3)) == exactly(5));
+  REQUIRE(size_hint(iter::sliding_window(v, 8)) == exactly(0));
+  REQUIRE(size_hint(iter::sliding_window(v, 0)) == exactly(0));
+  REQUIRE(size_hint(iter::sliding_window.fixed<2>(v)) == exactly(6));
+  REQUIRE(size_hint(iter::pairwise(v)) == exactly(6));
+  REQUIRE(size_hint(iter::chunked(v, 3)) == exactly(3));
+  REQUIRE(size_hint(iter::chunked(v, 7)) == exactly(1));
+  REQUIRE(size_hint(iter::batched(v, 3)) == exactly(3));
+  REQUIRE(size_hint(iter::batched(v, 10)) == exactly(7));
+  for (std::size_t k = 0; k < 10; ++k) {
+    check_hint(iter::sliding_window(v, k));
+    check_hint(iter::chunked(v, k));
+    check_hint(iter::batched(v, k));
+  }
+}
+
+TEST_CASE("size_hint: slice", "[size_hint]") {
+  Vec v = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+  REQUIRE(size_hint(iter::slice(v, 2, 8, 3)) == exactly(2));
+  REQUIRE(size_hint(iter::slice(v, 5)) == exactly(5));
+  REQUIRE(size_hint(iter::slice(v, 5, 50)) == exactly(5));
+  REQUIRE(size_hint(iter::slice(v, -3, 10)) == exactly(3));
+  REQUIRE(size_hint(iter::slice(v, 8, 2)) == exactly(0));
+  std::forward_list<int> fl(v.begin(), v.end());
+  REQUIRE(size_hint(iter::slice(fl, 3)) == SizeHint{0, {}});
+}
+
+TEST_CASE("size_hint: combinatorics", "[size_hint]") {
+  Vec v = {1, 2, 3, 4, 5};
+  REQUIRE(size_hint(iter::product(v, v, v)) == exactly(125));
+  REQUIRE(size_hint(iter::product()) == exactly(1));
+  REQUIRE(size_hint(iter::combinations(v, 2)) == exactly(10));
+  REQUIRE(size_hint(iter::combinations(v, 0)) == exactly(1));
+  REQUIRE(size_hint(iter::combinations(v, 6)) == exactly(0));
+  REQUIRE(size_hint(iter::combinations_with_replacement(v, 2))
+          == exactly(15));
+  REQUIRE(size_hint(iter::combinations_with_replacement(Vec{}, 0))
+          == exactly(1));
+  REQUIRE(size_hint(iter::combinations_with_replacement(Vec{}, 2))
+          == exactly(0));
+  REQUIRE(size_hint(iter::permutations(v)) == SizeHint{1, 120});
+  REQUIRE(size_hint(iter::permutations(Vec{})) == exactly(0));
+  REQUIRE(size_hint(iter::powerset(v)) == exactly(32));
+
+  check_hint(iter::combinations(v, 3));
+  check_hint(iter::combinations_with_replacement(v, 3));
+  check_hint(iter::permutations(Vec{1, 1, 2}));
+  check_hint(iter::powerset(v));
+}
+
+TEST_CASE("size_hint: huge counts don't overflow", "[size_hint]") {
+  auto r = iter::range(100000000);
+  REQUIRE(size_hint(iter::product(r, r, r)) == SizeHint{Max, {}});
+  REQUIRE(size_hint(iter::combinations(r, 50)) == SizeHint{Max, {}});
+  REQUIRE(size_hint(iter::combinations(iter::range(67), 33))
+          == exactly(14226520737620288370ull));
+  REQUIRE(size_hint(iter::powerset(iter::range(64))) == SizeHint{Max, {}});
+  REQUIRE(size_hint(iter::permutations(iter::range(30)))
+          == SizeHint{1, {}});
+  REQUIRE(size_hint(iter::chain(iter::repeat(1), r)) == SizeHint{Max, {}});
+}
+
+TEST_CASE("size_hint: endless iterables", "[size_hint]") {
+  Vec v = {1, 2};
+  REQUIRE(size_hint(iter::repeat(1)) == SizeHint{Max, {}});
+  REQUIRE(size_hint(iter::repeat(1, 4)) == exactly(4));
+  REQUIRE(size_hint(iter::cycle(v)) == SizeHint{Max, {}});
+  REQUIRE(size_hint(iter::cycle(Vec{})) == exactly(0));
+  std::forward_list<int> fl;
+  REQUIRE(size_hint(iter::cycle(fl)) == SizeHint{});
+}
+
+TEST_CASE("size_hint: sampling", "[size_hint]") {
+  const auto v = std::vector<int>(100);
+  REQUIRE(size_hint(iter::sample(v, 10, std::mt19937{})) == exactly(10));
+  REQUIRE(size_hint(iter::sample(v, 500, std::mt19937{})) == exactly(100));
+  REQUIRE(size_hint(iter::sample_rate(v, 0.5, std::mt19937{}))
+          == at_most(100));
+  REQUIRE(size_hint(iter::shuffled(v, 3)) == exactly(100));
+}
+
+TEST_CASE("size_hint: of a const adaptor", "[size_hint][const]") {
+  Vec v = {1, 2, 3};
+  const auto e = iter::enumerate(v);
+  REQUIRE(size_hint(e) == exactly(3));
+}
@@ -1,6 +1,10 @@
+#include <cppitertools/filter.hpp>
 #include <cppitertools/slice.hpp>
 
+#include <iterator>
+#include <list>
 #include <string>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -10,6 +14,16 @@
 using iter::slice;
 using Vec = const std::vector<int>;
 
+namespace {
+  // can only be walked once, but knows how many elements it has
+  class SizedInput : public itertest::InputIterable {
+   public:
+    std::size_t size() const {
+      return 5;
+    }
+  };
+}
+
 TEST_CASE("slice: take from beginning", "[slice]") {
   Vec ns = {10, 11, 12, 13, 14, 15, 16, 17, 18, 19};
 
@@ -168,3 +182,150 @@ TEST_CASE("slice: has correct ctor and assign ops", "[slice]") {
   REQUIRE(itertest::IsMoveConstructibleOnly<ImpT<std::string&>>::value);
   REQUIRE(itertest::IsMoveConstructibleOnly<ImpT<std::string>>::value);
 }
+
+TEST_CASE("slice: random access iterables give random access iterators",
+    "[slice]") {
+  Vec ns = {10, 11, 12, 13, 14, 15, 16, 17, 18, 19};
+  auto sl = slice(ns, 1, 9, 3);
+  auto it = std::begin(sl);
+  REQUIRE(std::is_same<std::iterator_traits<decltype(it)>::iterator_category,
+      std::random_access_iterator_tag>::value);
+  REQUIRE(sl.size() == 3);
+  REQUIRE(std::end(sl) - it == 3);
+  REQUIRE(it[2] == 17);
+  it += 2;
+  REQUIRE(*it == 17);
+  --it;
+  REQUIRE(*it == 14);
+  REQUIRE(std::begin(sl) < it);
+
+  Vec v(std::make_reverse_iterator(std::end(sl)),
+      std::make_reverse_iterator(std::begin(sl)));
+  Vec vc = {17, 14, 11};
+  REQUIRE(v == vc);
+}
+
+TEST_CASE("slice: size() with stop past the end", "[slice]") {
+  Vec ns = {1, 2, 3, 4, 5};
+  REQUIRE(slice(ns, 1, 100, 2).size() == 2);
+  REQUIRE(slice(ns, 7, 100).size() == 0);
+  REQUIRE(slice(ns, 3, 1).size() == 0);
+}
+
+TEST_CASE("slice: negative indices count from the end", "[slice]") {
+  Vec ns = {10, 11, 12, 13, 14, 15};
+  std::vector<int> v;
+  SECTION("negative start") {
+    auto sl = slice(ns, -2, 10);
+    v.assign(std::begin(sl), std::end(sl));
+    REQUIRE(v == Vec{14, 15});
+  }
+  SECTION("negative stop") {
+    auto sl = ns | slice(-2);
+    v.assign(std::begin(sl), std::end(sl));
+    REQUIRE(v == Vec{10, 11, 12, 13});
+  }
+  SECTION("negative start and stop") {
+    auto sl = ns | slice(-5, -1, 2);
+    v.assign(std::begin(sl), std::end(sl));
+    REQUIRE(v == Vec{11, 13});
+  }
+  SECTION("negative start before the beginning") {
+    auto sl = slice(ns, -100, 2);
+    v.assign(std::begin(sl), std::end(sl));
+    REQUIRE(v == Vec{10, 11});
+  }
+  SECTION("without random access") {
+    std::list<int> lst(std::begin(ns), std::end(ns));
+    auto sl = slice(lst, -4, -1);
+    v.assign(std::begin(sl), std::end(sl));
+    REQUIRE(v == Vec{12, 13, 14});
+  }
+  SECTION("single pass with a known size") {
+    SizedInput in;
+    auto sl = slice(in, -3, -1);
+    v.assign(std::begin(sl), std::end(sl));
+    REQUIRE(v == Vec{2, 3});
+  }
+}
+
+TEST_CASE("slice: matches python slicing", "[slice]") {
+  Vec ns = {0, 1, 2, 3, 4, 5, 6};
+  const int len = static_cast<int>(ns.size());
+  std::list<int> lst(std::begin(ns), std::end(ns));
+  auto normalize = [len](int i) {
+    if (i < 0) {
+      i += len;
+    }
+    return i < 0 ? 0 : (i > len ? len : i);
+  };
+  for (int start = -9; start < 9; ++start) {
+    for (int stop = -9; stop < 9; ++stop) {
+      for (int step = 1; step < 4; ++step) {
+        std::vector<int> expected;
+        for (int i = normalize(start); i < normalize(stop); i += step) {
+          expected.push_back(ns[static_cast<std::size_t>(i)]);
+        }
+        auto sl = slice(ns, start, stop, step);
+        Vec v(std::begin(sl), std::end(sl));
+        REQUIRE(v == expected);
+        REQUIRE(sl.size() == expected.size());
+
+        auto lsl = slice(lst, start, stop, step);
+        Vec lv(std::begin(lsl), std::end(lsl));
+        REQUIRE(lv == expected);
+      }
+    }
+  }
+}
+
+TEST_CASE("slice: single pass iterables sliced from the end", "[slice]") {
+  const int len = 5;
+  auto normalize = [len](int i) {
+    if (i < 0) {
+      i += len;
+    }
+    return i < 0 ? 0 : (i > len ? len : i);
+  };
+  for (int start = -7; start < 7; ++start) {
+    for (int stop = -7; stop < 7; ++stop) {
+      for (int step = 1; step < 4; ++step) {
+        std::vector<int> expected;
+        for (int i = normalize(start); i < normalize(stop); i += step) {
+          expected.push_back(i);
+        }
+        // throws if an element is dereferenced twice
+        itertest::InputIterable in;
+        auto sl = slice(in, start, stop, step);
+        Vec v(std::begin(sl), std::end(sl));
+        REQUIRE(v == expected);
+      }
+    }
+  }
+
+  Vec ns = {1, 2, 3, 4, 5, 6, 7};
+  auto odd = [](int i) { return i % 2 == 1; };
+  auto sl = slice(iter::filter(odd, ns), -2);
+  std::vector<int> v(std::begin(sl), std::end(sl));
+  REQUIRE(v == Vec{1, 3});
+
+  auto sl1 = slice(iter::filter(odd, ns), -2, 10);
+  v.assign(std::begin(sl1), std::end(sl1));
+  REQUIRE(v == Vec{5, 7});
+
+  auto sl2 = iter::filter(odd, ns) | slice(1, -1);
+  v.assign(std::begin(sl2), std::end(sl2));
+  REQUIRE(v == Vec{3, 5});
+}
+
+#ifdef __cpp_lib_span
+TEST_CASE("slice: span of contiguous elements", "[slice]") {
+  std::vector<int> ns = {10, 11, 12, 13, 14};
+  auto sl = slice(ns, 1, -1);
+  auto sp = sl.span();
+  REQUIRE(sp.size() == 3);
+  REQUIRE(sp.data() == ns.data() + 1);
+  sp[0] = 100;
+  REQUIRE(ns[1] == 100);
+}
+#endif
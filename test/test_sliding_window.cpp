@@ -2,6 +2,7 @@
 
 #include <array>
 #include <string>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -132,3 +133,79 @@ TEST_CASE(
   REQUIRE(itertest::IsMoveConstructibleOnly<ImpT<std::string&>>::value);
   REQUIRE(itertest::IsMoveConstructibleOnly<ImpT<std::string>>::value);
 }
+
+TEST_CASE("sliding_window.fixed: yields tuples of references",
+    "[sliding_window]") {
+  std::vector<int> ns = {10, 20, 30, 40};
+  std::vector<std::tuple<int, int, int>> v;
+  SECTION("Normal call") {
+    for (auto [a, b, c] : sliding_window.fixed<3>(ns)) {
+      v.emplace_back(a, b, c);
+    }
+  }
+  SECTION("Pipe") {
+    for (auto [a, b, c] : ns | sliding_window.fixed<3>) {
+      v.emplace_back(a, b, c);
+    }
+  }
+  const std::vector<std::tuple<int, int, int>> vc = {
+      {10, 20, 30}, {20, 30, 40}};
+  REQUIRE(v == vc);
+
+  for (auto [a, b, c] : sliding_window.fixed<3>(ns)) {
+    c += a + b;
+  }
+  REQUIRE(ns == Vec{10, 20, 60, 120});
+}
+
+TEST_CASE("sliding_window.fixed: matches sliding_window", "[sliding_window]") {
+  Vec ns = {1, 2, 3, 4, 5, 6, 7};
+  std::vector<std::vector<int>> v;
+  for (auto&& t : sliding_window.fixed<4>(ns)) {
+    v.push_back({std::get<0>(t), std::get<1>(t), std::get<2>(t),
+        std::get<3>(t)});
+  }
+  std::vector<std::vector<int>> vc;
+  for (auto&& win : sliding_window(ns, 4)) {
+    vc.emplace_back(std::begin(win), std::end(win));
+  }
+  REQUIRE(v == vc);
+}
+
+TEST_CASE("sliding_window.fixed: short iterables are empty",
+    "[sliding_window]") {
+  Vec ns = {1, 2};
+  auto sw = sliding_window.fixed<3>(ns);
+  REQUIRE(std::begin(sw) == std::end(sw));
+  auto sw2 = sliding_window.fixed<1>(Vec{});
+  REQUIRE(std::begin(sw2) == std::end(sw2));
+  auto sw3 = sliding_window.fixed<2>(ns);
+  REQUIRE(std::distance(std::begin(sw3), std::end(sw3)) == 1);
+}
+
+TEST_CASE("sliding_window.fixed: copies values from input iterators",
+    "[sliding_window]") {
+  itertest::InputIterable ii;
+  std::vector<std::pair<int, int>> v;
+  for (auto [a, b] : sliding_window.fixed<2>(ii)) {
+    v.emplace_back(a, b);
+  }
+  REQUIRE(v.size() == 4);
+  for (auto&& [a, b] : v) {
+    REQUIRE(b == a + 1);
+  }
+}
+
+TEST_CASE("sliding_window.fixed: const iteration, binding and requirements",
+    "[sliding_window][const]") {
+  Vec ns = {1, 2, 3};
+  const auto sw = sliding_window.fixed<2>(ns);
+  REQUIRE(std::distance(std::begin(sw), std::end(sw)) == 2);
+  REQUIRE(itertest::IsIterator<decltype(std::begin(sw))>::value);
+
+  itertest::BasicIterable<int> bi{1, 2};
+  sliding_window.fixed<2>(bi);
+  REQUIRE_FALSE(bi.was_moved_from());
+  sliding_window.fixed<2>(std::move(bi));
+  REQUIRE(bi.was_moved_from());
+}
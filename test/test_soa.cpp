@@ -0,0 +1,281 @@
+#include <cppitertools/soa.hpp>
+#include <cppitertools/zip.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "catch.hpp"
+#include "helpers.hpp"
+
+using iter::soa;
+using Table = soa<int, double, std::string>;
+
+namespace {
+  // Throws when made from a negative number, and when copied or default
+  // constructed while fail is set
+  struct Picky {
+    static bool fail;
+    int value{0};
+
+    Picky() {
+      if (fail) {
+        throw std::runtime_error{"default"};
+      }
+    }
+
+    Picky(int i) : value{i} {
+      if (i < 0) {
+        throw std::runtime_error{"negative"};
+      }
+    }
+
+    Picky(const Picky& other) : value{other.value} {
+      if (fail) {
+        throw std::runtime_error{"copy"};
+      }
+    }
+
+    Picky& operator=(const Picky&) = default;
+  };
+  bool Picky::fail = false;
+}
+
+TEST_CASE("soa: push_back and iterate rows", "[soa]") {
+  Table t;
+  t.push_back({1, 1.5, "a"});
+  t.emplace_back(2, 2.5, "bb");
+  t.push_back(std::make_tuple(3, 3.5, std::string{"ccc"}));
+
+  REQUIRE(t.size() == 3);
+  REQUIRE_FALSE(t.empty());
+
+  std::vector<int> ids;
+  std::vector<std::string> names;
+  for (auto&& [id, x, name] : t) {
+    ids.push_back(id);
+    names.push_back(name);
+    REQUIRE(x == id + 0.5);
+  }
+  REQUIRE(ids == std::vector<int>{1, 2, 3});
+  REQUIRE(names == std::vector<std::string>{"a", "bb", "ccc"});
+}
+
+TEST_CASE("soa: columns are contiguous", "[soa]") {
+  soa<int, char> t{{1, 'a'}, {2, 'b'}, {3, 'c'}};
+  auto ids = t.column<0>();
+  auto chars = t.column<1>();
+  REQUIRE(ids.size() == 3);
+  REQUIRE(std::accumulate(ids.begin(), ids.end(), 0) == 6);
+  REQUIRE(std::string(chars.begin(), chars.end()) == "abc");
+  REQUIRE(&ids[1] == ids.data() + 1);
+  REQUIRE(&std::get<0>(t[2]) == ids.data() + 2);
+
+  ids[1] = 20;
+  REQUIRE(std::get<0>(t[1]) == 20);
+}
+
+TEST_CASE("soa: const access", "[soa][const]") {
+  const soa<int, char> t{{1, 'a'}, {2, 'b'}};
+  auto chars = t.column<1>();
+  static_assert(std::is_same_v<decltype(chars.data()), const char*>);
+  static_assert(std::is_same_v<decltype(*t.begin()),
+      std::tuple<const int&, const char&>>);
+  REQUIRE(chars[1] == 'b');
+  REQUIRE(std::get<0>(t.back()) == 2);
+  REQUIRE(std::get<1>(t.front()) == 'a');
+}
+
+TEST_CASE("soa: writes through row references", "[soa]") {
+  soa<int, std::string> t{{1, "a"}, {2, "b"}};
+  for (auto&& [n, s] : t) {
+    n *= 10;
+    s += "!";
+  }
+  t[0] = std::make_tuple(5, std::string{"five"});
+  REQUIRE(t == soa<int, std::string>{{5, "five"}, {20, "b!"}});
+}
+
+TEST_CASE("soa: reserve, resize, pop_back and clear", "[soa]") {
+  soa<int, double> t;
+  t.reserve(10);
+  REQUIRE(t.capacity() >= 10);
+  REQUIRE(t.empty());
+
+  t.resize(4);
+  REQUIRE(t.size() == 4);
+  REQUIRE(t.column<0>().size() == 4);
+  REQUIRE(t.column<1>().size() == 4);
+  REQUIRE(std::get<1>(t[3]) == 0.0);
+
+  t.pop_back();
+  REQUIRE(t.size() == 3);
+  REQUIRE(t.column<1>().size() == 3);
+
+  t.clear();
+  REQUIRE(t.empty());
+  REQUIRE(t.column<1>().empty());
+}
+
+TEST_CASE("soa: columns keep the same length when a column throws",
+    "[soa]") {
+  soa<int, Picky, std::string> t;
+  t.emplace_back(1, 1, "a");
+  auto same_lengths = [&t] {
+    return t.column<0>().size() == t.size()
+           && t.column<1>().size() == t.size()
+           && t.column<2>().size() == t.size();
+  };
+
+  REQUIRE_THROWS(t.emplace_back(2, -2, "b"));
+  REQUIRE(t.size() == 1);
+  REQUIRE(same_lengths());
+
+  const std::tuple<int, Picky, std::string> row{3, Picky{3}, "c"};
+  Picky::fail = true;
+  REQUIRE_THROWS(t.push_back(row));
+  REQUIRE(t.size() == 1);
+  REQUIRE(same_lengths());
+
+  REQUIRE_THROWS(t.resize(5));
+  REQUIRE(t.size() == 1);
+  REQUIRE(same_lengths());
+  Picky::fail = false;
+
+  t.push_back(row);
+  REQUIRE(t.size() == 2);
+  REQUIRE(std::get<1>(t[1]).value == 3);
+  REQUIRE(same_lengths());
+}
+
+TEST_CASE("soa: iterator is random access", "[soa]") {
+  soa<int, char> t{{0, 'a'}, {1, 'b'}, {2, 'c'}, {3, 'd'}};
+  auto it = t.begin();
+  REQUIRE(std::end(t) - it == 4);
+  REQUIRE(std::get<0>(it[2]) == 2);
+  it += 3;
+  REQUIRE(std::get<1>(*it) == 'd');
+  --it;
+  REQUIRE(std::get<0>(*it) == 2);
+  REQUIRE(std::get<0>(*(it - 2)) == 0);
+  REQUIRE(t.begin() < it);
+
+  auto found = std::find_if(t.begin(), t.end(),
+      [](const auto& row) { return std::get<1>(row) == 'c'; });
+  REQUIRE(found - t.begin() == 2);
+}
+
+TEST_CASE("soa: const iterators compare with non-const", "[soa][const]") {
+  soa<int> t{{1}, {2}};
+  const auto& ct = t;
+  soa<int>::const_iterator it = t.begin();
+  REQUIRE(it == ct.begin());
+  REQUIRE(t.end() == ct.end());
+  REQUIRE(ct.end() - t.begin() == 2);
+}
+
+TEST_CASE("soa: rows match zip over the columns", "[soa]") {
+  soa<int, char> t{{1, 'a'}, {2, 'b'}};
+  std::vector<int> ids{1, 2};
+  std::vector<char> chars{'a', 'b'};
+  using ZipDeref = decltype(*iter::zip(ids, chars).begin());
+  static_assert(std::is_same_v<ZipDeref, decltype(*t.begin())>);
+
+  std::vector<std::tuple<int, char>> from_soa(t.begin(), t.end());
+  std::vector<std::tuple<int, char>> from_zip;
+  for (auto&& [i, c] : iter::zip(t.column<0>(), t.column<1>())) {
+    from_zip.emplace_back(i, c);
+  }
+  REQUIRE(from_soa == from_zip);
+
+  std::vector<int> sums;
+  for (auto&& [row, extra] : iter::zip(t, ids)) {
+    sums.push_back(std::get<0>(row) + extra);
+  }
+  REQUIRE(sums == std::vector<int>{2, 4});
+}
+
+TEST_CASE("soa: sorts rows by a column", "[soa]") {
+  Table t{{3, 3.5, "c"}, {1, 1.5, "a"}, {4, 4.5, "d"}, {2, 2.5, "b"}};
+  SECTION("by the first column") {
+    t.sort_by<0>();
+  }
+  SECTION("by the last column") {
+    t.sort_by<2>();
+  }
+  SECTION("as whole rows") {
+    t.sort();
+  }
+
+  auto ids = t.column<0>();
+  auto xs = t.column<1>();
+  auto names = t.column<2>();
+  REQUIRE(std::vector<int>(ids.begin(), ids.end())
+          == std::vector<int>{1, 2, 3, 4});
+  REQUIRE(std::vector<double>(xs.begin(), xs.end())
+          == std::vector<double>{1.5, 2.5, 3.5, 4.5});
+  REQUIRE(std::vector<std::string>(names.begin(), names.end())
+          == std::vector<std::string>{"a", "b", "c", "d"});
+}
+
+TEST_CASE("soa: sorts rows by a column with a comparison", "[soa]") {
+  Table t{{3, 3.5, "c"}, {1, 1.5, "a"}, {4, 4.5, "d"}, {2, 2.5, "b"}};
+  t.sort_by<1>(std::greater<>{});
+  Table expected{{4, 4.5, "d"}, {3, 3.5, "c"}, {2, 2.5, "b"}, {1, 1.5, "a"}};
+  REQUIRE(t == expected);
+}
+
+TEST_CASE("soa: sorting keeps the order of equal rows", "[soa]") {
+  soa<int, char> t{{2, 'a'}, {1, 'b'}, {2, 'c'}, {1, 'd'}};
+  t.sort_by<0>();
+  soa<int, char> expected{{1, 'b'}, {1, 'd'}, {2, 'a'}, {2, 'c'}};
+  REQUIRE(t == expected);
+
+  t.sort([](const auto& a, const auto& b) {
+    return std::get<1>(a) > std::get<1>(b);
+  });
+  soa<int, char> by_char{{1, 'd'}, {2, 'c'}, {1, 'b'}, {2, 'a'}};
+  REQUIRE(t == by_char);
+}
+
+TEST_CASE("soa: permute moves whole rows", "[soa]") {
+  soa<int, std::string> t{{0, "zero"}, {1, "one"}, {2, "two"}};
+  t.permute(std::vector<std::size_t>{2, 0, 1});
+  soa<int, std::string> expected{{2, "two"}, {0, "zero"}, {1, "one"}};
+  REQUIRE(t == expected);
+
+  REQUIRE_THROWS_AS(
+      t.permute(std::vector<std::size_t>{0, 0, 1}), std::invalid_argument);
+  REQUIRE(t == expected);
+}
+
+TEST_CASE("soa: is a regular value", "[soa]") {
+  soa<int, std::string> t{{1, "a"}};
+  auto t2 = t;
+  REQUIRE(t2 == t);
+  t2.emplace_back(2, "b");
+  REQUIRE(t2 != t);
+  auto t3 = std::move(t2);
+  REQUIRE(t3.size() == 2);
+}
+
+#ifdef __cpp_lib_span
+TEST_CASE("soa: columns convert to std::span", "[soa]") {
+  soa<int, char> t{{1, 'a'}, {2, 'b'}};
+  std::span<int> ids = t.column<0>();
+  REQUIRE(ids.size() == 2);
+  REQUIRE(ids[1] == 2);
+}
+#endif
+
+TEST_CASE("soa: iterator meets requirements", "[soa]") {
+  soa<int> t;
+  REQUIRE(itertest::IsIterator<decltype(std::begin(t))>::value);
+}
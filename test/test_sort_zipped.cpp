@@ -0,0 +1,162 @@
+#include <cppitertools/soa.hpp>
+#include <cppitertools/sort_zipped.hpp>
+
+#include <algorithm>
+#include <array>
+#include <deque>
+#include <functional>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "catch.hpp"
+
+using iter::apply_permutation;
+using iter::sort_permutation;
+using iter::sort_zipped;
+
+TEST_CASE("sort_zipped: sorts every column by the keys", "[sort_zipped]") {
+  std::vector<int> keys{3, 1, 2};
+  std::vector<std::string> names{"three", "one", "two"};
+  std::deque<double> xs{3.5, 1.5, 2.5};
+  char cs[] = {'c', 'a', 'b'};
+
+  sort_zipped(keys, names, xs, cs);
+
+  REQUIRE(keys == std::vector<int>{1, 2, 3});
+  REQUIRE(names == std::vector<std::string>{"one", "two", "three"});
+  REQUIRE(xs == std::deque<double>{1.5, 2.5, 3.5});
+  REQUIRE(std::string(std::begin(cs), std::end(cs)) == "abc");
+}
+
+TEST_CASE("sort_zipped: with a custom comparison", "[sort_zipped]") {
+  std::vector<int> keys{1, 3, 2};
+  std::vector<char> vals{'a', 'c', 'b'};
+  sort_zipped(std::greater<>{}, keys, vals);
+  REQUIRE(keys == std::vector<int>{3, 2, 1});
+  REQUIRE(vals == std::vector<char>{'c', 'b', 'a'});
+}
+
+TEST_CASE("sort_zipped: is stable", "[sort_zipped]") {
+  std::vector<int> keys{2, 1, 2, 1, 2};
+  std::vector<char> order{'a', 'b', 'c', 'd', 'e'};
+  sort_zipped(keys, order);
+  REQUIRE(keys == std::vector<int>{1, 1, 2, 2, 2});
+  REQUIRE(order == std::vector<char>{'b', 'd', 'a', 'c', 'e'});
+}
+
+TEST_CASE("sort_zipped: empty and single element", "[sort_zipped]") {
+  std::vector<int> keys;
+  std::vector<std::string> vals;
+  sort_zipped(keys, vals);
+  REQUIRE(keys.empty());
+
+  keys = {5};
+  vals = {"five"};
+  sort_zipped(keys, vals);
+  REQUIRE(vals == std::vector<std::string>{"five"});
+}
+
+TEST_CASE("sort_zipped: moves elements without copying", "[sort_zipped]") {
+  std::vector<int> keys{2, 0, 1};
+  std::vector<std::string> vals{
+      std::string(100, 'c'), std::string(100, 'a'), std::string(100, 'b')};
+  std::vector<const char*> buffers;
+  for (auto&& s : vals) {
+    buffers.push_back(s.data());
+  }
+  sort_zipped(keys, vals);
+  REQUIRE(vals[0].data() == buffers[1]);
+  REQUIRE(vals[1].data() == buffers[2]);
+  REQUIRE(vals[2].data() == buffers[0]);
+}
+
+TEST_CASE("sort_zipped: sorts the columns of an soa", "[sort_zipped]") {
+  iter::soa<int, char> t{{3, 'c'}, {1, 'a'}, {2, 'b'}};
+  sort_zipped(t.column<0>(), t.column<1>());
+  REQUIRE(t == iter::soa<int, char>{{1, 'a'}, {2, 'b'}, {3, 'c'}});
+}
+
+TEST_CASE("sort_zipped: works with vector<bool> columns", "[sort_zipped]") {
+  std::vector<int> keys{2, 0, 1};
+  std::vector<bool> flags{true, false, false};
+  sort_zipped(keys, flags);
+  REQUIRE(flags == std::vector<bool>{false, false, true});
+}
+
+TEST_CASE("sort_zipped: matches sorting rows", "[sort_zipped]") {
+  std::mt19937 gen{1234};
+  std::uniform_int_distribution<int> dist{0, 20};
+  for (int n : {2, 7, 50, 300}) {
+    std::vector<int> keys(static_cast<std::size_t>(n));
+    std::vector<int> ids(keys.size());
+    std::generate(keys.begin(), keys.end(), [&] { return dist(gen); });
+    std::iota(ids.begin(), ids.end(), 0);
+
+    std::vector<std::pair<int, int>> rows;
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+      rows.emplace_back(keys[i], ids[i]);
+    }
+    std::stable_sort(rows.begin(), rows.end(),
+        [](auto& a, auto& b) { return a.first < b.first; });
+
+    sort_zipped(keys, ids);
+    for (std::size_t i = 0; i < rows.size(); ++i) {
+      REQUIRE(keys[i] == rows[i].first);
+      REQUIRE(ids[i] == rows[i].second);
+    }
+  }
+}
+
+TEST_CASE("sort_permutation: gives the sorted order", "[sort_zipped]") {
+  const std::array<std::string, 4> keys{{"d", "b", "a", "b"}};
+  auto perm = sort_permutation(keys);
+  REQUIRE(perm == std::vector<std::size_t>{2, 1, 3, 0});
+  REQUIRE(keys[0] == "d");
+
+  auto desc = sort_permutation(keys, std::greater<>{});
+  REQUIRE(desc == std::vector<std::size_t>{0, 1, 3, 2});
+}
+
+TEST_CASE("apply_permutation: rearranges columns in place", "[sort_zipped]") {
+  std::vector<std::size_t> perm{3, 0, 4, 1, 2};
+  std::vector<char> a{'a', 'b', 'c', 'd', 'e'};
+  std::vector<int> b{0, 1, 2, 3, 4};
+  apply_permutation(perm, a, b);
+  REQUIRE(a == std::vector<char>{'d', 'a', 'e', 'b', 'c'});
+  REQUIRE(b == std::vector<int>{3, 0, 4, 1, 2});
+}
+
+TEST_CASE("apply_permutation: the same permutation for several calls",
+    "[sort_zipped]") {
+  std::vector<double> prices{9.5, 1.25, 4.0};
+  std::vector<std::string> names{"c", "a", "b"};
+  auto perm = sort_permutation(prices);
+  apply_permutation(perm, prices);
+  apply_permutation(perm, names);
+  REQUIRE(prices == std::vector<double>{1.25, 4.0, 9.5});
+  REQUIRE(names == std::vector<std::string>{"a", "b", "c"});
+}
+
+TEST_CASE("apply_permutation: rejects bad permutations untouched",
+    "[sort_zipped]") {
+  std::vector<int> a{0, 1, 2};
+  std::vector<int> shorter{0, 1};
+  using Perm = std::vector<std::size_t>;
+  REQUIRE_THROWS_AS(
+      apply_permutation(Perm{1, 1, 0}, a), std::invalid_argument);
+  REQUIRE_THROWS_AS(
+      apply_permutation(Perm{0, 3, 1}, a), std::invalid_argument);
+  REQUIRE_THROWS_AS(
+      apply_permutation(Perm{2, 0, 1}, a, shorter), std::invalid_argument);
+  REQUIRE(a == std::vector<int>{0, 1, 2});
+  REQUIRE(shorter == std::vector<int>{0, 1});
+
+  // longer iterables only have their first elements rearranged
+  std::vector<int> longer{0, 1, 2, 3};
+  apply_permutation(Perm{1, 0}, longer);
+  REQUIRE(longer == std::vector<int>{1, 0, 2, 3});
+}
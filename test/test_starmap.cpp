@@ -280,6 +280,30 @@ TEST_CASE("starmap: iterator dereference type matches 'reference' type alias",
   }
 }
 
+TEST_CASE("starmap: cached calls the function once per element",
+    "[starmap]") {
+  const std::vector<std::pair<long, int>> v1 = {{1l, 2}, {3l, 11}};
+  int calls = 0;
+  auto sm = starmap.cached(
+      [&calls](long a, int b) {
+        ++calls;
+        return a * b;
+      },
+      v1);
+  auto it = std::begin(sm);
+  REQUIRE(*it == 2);
+  REQUIRE(*it == 2);
+  REQUIRE(calls == 1);
+  ++it;
+  REQUIRE(*it == 33);
+  REQUIRE(calls == 2);
+  REQUIRE(itertest::ReferenceMatchesDeref<decltype(it)>::value);
+
+  auto piped = v1 | starmap.cached(Adder{});
+  std::vector<long> v(std::begin(piped), std::end(piped));
+  REQUIRE(v == std::vector<long>{3l, 14l});
+}
+
 TEST_CASE("starmap: iterator has correct 'value' type alias", "[starmap]") {
   std::vector<std::pair<int, int>> input;
   SECTION("with reference return type") {
@@ -1,4 +1,5 @@
 #include <array>
+#include <cppitertools/assume_sorted.hpp>
 #include <cppitertools/takewhile.hpp>
 #include <string>
 #include <utility>
@@ -190,3 +191,42 @@ TEST_CASE("takewhile: has correct ctor and assign ops", "[takewhile]") {
   REQUIRE(itertest::IsMoveConstructibleOnly<T1>::value);
   REQUIRE(itertest::IsMoveConstructibleOnly<T2>::value);
 }
+
+TEST_CASE("takewhile: searches a sorted iterable", "[takewhile]") {
+  std::vector<int> ns(1000);
+  for (std::size_t i = 0; i < ns.size(); ++i) {
+    ns[i] = static_cast<int>(i);
+  }
+  int calls = 0;
+  auto lt = [&calls](int limit) {
+    return [&calls, limit](int n) {
+      ++calls;
+      return n < limit;
+    };
+  };
+
+  SECTION("stops at the first failure") {
+    auto t = takewhile(lt(700), iter::assume_sorted(ns));
+    Vec v(std::begin(t), std::end(t));
+    Vec vc(ns.begin(), ns.begin() + 700);
+    REQUIRE(v == vc);
+    REQUIRE(calls < 30);
+  }
+
+  SECTION("takes everything") {
+    auto t = takewhile(lt(5000), ns | iter::assume_sorted);
+    REQUIRE(std::distance(std::begin(t), std::end(t)) == 1000);
+  }
+
+  SECTION("takes nothing") {
+    auto t = takewhile(lt(0), iter::assume_sorted(ns));
+    REQUIRE(std::begin(t) == std::end(t));
+  }
+
+  SECTION("const iteration") {
+    const auto t = takewhile(lt(3), iter::assume_sorted(ns));
+    Vec v(std::begin(t), std::end(t));
+    Vec vc = {0, 1, 2};
+    REQUIRE(v == vc);
+  }
+}
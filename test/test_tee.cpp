@@ -0,0 +1,188 @@
+#include <cppitertools/imap.hpp>
+#include <cppitertools/range.hpp>
+#include <cppitertools/tee.hpp>
+
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "catch.hpp"
+#include "helpers.hpp"
+
+using iter::tee;
+using Vec = const std::vector<int>;
+
+TEST_CASE("tee: every branch yields every element", "[tee]") {
+  Vec ns = {1, 2, 3, 4, 5};
+  auto t = tee(ns, 3);
+  REQUIRE(t.size() == 3);
+  for (auto&& branch : t) {
+    Vec v(std::begin(branch), std::end(branch));
+    REQUIRE(v == ns);
+  }
+}
+
+TEST_CASE("tee: with pipe", "[tee]") {
+  auto t = iter::range(4) | tee(2);
+  Vec v0(std::begin(t[0]), std::end(t[0]));
+  Vec v1(std::begin(t[1]), std::end(t[1]));
+  Vec vc = {0, 1, 2, 3};
+  REQUIRE(v0 == vc);
+  REQUIRE(v1 == vc);
+}
+
+TEST_CASE("tee: takes each element once", "[tee]") {
+  int calls = 0;
+  auto m = iter::imap(
+      [&calls](int i) {
+        ++calls;
+        return std::to_string(i);
+      },
+      iter::range(200));
+  auto t = tee(m, 2);
+  auto it0 = std::begin(t[0]);
+  auto it1 = std::begin(t[1]);
+  std::vector<std::string> v0;
+  std::vector<std::string> v1;
+  // interleave with one branch running ahead across several chunks
+  for (int i = 0; i < 150; ++i) {
+    v0.push_back(*it0++);
+  }
+  for (; it1 != std::end(t[1]); ++it1) {
+    v1.push_back(*it1);
+  }
+  for (; it0 != std::end(t[0]); ++it0) {
+    v0.push_back(*it0);
+  }
+  REQUIRE(calls == 200);
+  REQUIRE(v0 == v1);
+  REQUIRE(v0.size() == 200);
+  REQUIRE(v0.back() == "199");
+}
+
+namespace {
+  struct Counted {
+    static int alive;
+    int value;
+    Counted(int i) : value{i} {
+      ++alive;
+    }
+    Counted(const Counted& other) : value{other.value} {
+      ++alive;
+    }
+    Counted& operator=(const Counted&) = default;
+    ~Counted() {
+      --alive;
+    }
+  };
+  int Counted::alive = 0;
+}
+
+TEST_CASE("tee: frees chunks that every branch has passed", "[tee]") {
+  {
+    auto m = iter::imap([](int i) { return Counted{i}; }, iter::range(1000));
+    auto t = tee(m, 2);
+    auto it0 = std::begin(t[0]);
+    auto it1 = std::begin(t[1]);
+    for (int i = 0; i < 900; ++i) {
+      REQUIRE(it0->value == i);
+      REQUIRE(it1->value == i);
+      ++it0;
+      ++it1;
+      REQUIRE(Counted::alive <= 2 * 64 + 1);
+    }
+  }
+  REQUIRE(Counted::alive == 0);
+}
+
+TEST_CASE("tee: refers to elements with lasting references", "[tee]") {
+  Vec ns = {1, 2, 3};
+  auto t = tee(ns, 2);
+  REQUIRE(&*std::begin(t[0]) == &ns[0]);
+  REQUIRE(&*std::begin(t[1]) == &ns[0]);
+}
+
+TEST_CASE("tee: branches continue where they stopped", "[tee]") {
+  Vec ns = {1, 2, 3};
+  auto t = tee(ns, 1);
+  auto it = std::begin(t[0]);
+  ++it;
+  Vec v(std::begin(t[0]), std::end(t[0]));
+  Vec vc = {2, 3};
+  REQUIRE(v == vc);
+  REQUIRE(std::begin(t[0]) == std::end(t[0]));
+}
+
+TEST_CASE("tee: empty iterable", "[tee]") {
+  Vec ns{};
+  auto t = tee(ns, 2);
+  REQUIRE(std::begin(t[0]) == std::end(t[0]));
+  REQUIRE(std::begin(t[1]) == std::end(t[1]));
+}
+
+TEST_CASE("tee: zero branches", "[tee]") {
+  auto t = tee(iter::range(3), 0);
+  REQUIRE(t.size() == 0);
+  REQUIRE(std::begin(t) == std::end(t));
+}
+
+TEST_CASE("tee: branches on different threads", "[tee]") {
+  auto m = iter::imap([](int i) { return i * 2; }, iter::range(10000));
+  auto t = tee(m, 4);
+  std::vector<std::vector<int>> results(4);
+  std::vector<std::thread> threads;
+  for (std::size_t i = 0; i < 4; ++i) {
+    threads.emplace_back([&t, &results, i] {
+      for (auto&& n : t[i]) {
+        results[i].push_back(n);
+      }
+    });
+  }
+  for (auto&& th : threads) {
+    th.join();
+  }
+  std::vector<int> vc;
+  for (int i = 0; i < 10000; ++i) {
+    vc.push_back(i * 2);
+  }
+  for (auto&& v : results) {
+    REQUIRE(v == vc);
+  }
+}
+
+TEST_CASE("tee: moving keeps branches valid", "[tee]") {
+  Vec ns = {1, 2, 3};
+  auto t = tee(ns, 2);
+  auto it = std::begin(t[0]);
+  auto t2 = std::move(t);
+  ++it;
+  REQUIRE(*it == 2);
+  Vec v(std::begin(t2[1]), std::end(t2[1]));
+  REQUIRE(v == ns);
+}
+
+TEST_CASE("tee: binds reference to lvalue and moves rvalue", "[tee]") {
+  itertest::BasicIterable<int> bi{1, 2};
+  SECTION("binds to lvalues") {
+    tee(bi, 2);
+    REQUIRE_FALSE(bi.was_moved_from());
+  }
+  SECTION("moves rvalues") {
+    tee(std::move(bi), 2);
+    REQUIRE(bi.was_moved_from());
+  }
+}
+
+TEST_CASE("tee: iterator meets requirements", "[tee]") {
+  Vec ns{};
+  auto t = tee(ns, 1);
+  REQUIRE(itertest::IsIterator<decltype(std::begin(t[0]))>::value);
+}
+
+template <typename T>
+using ImpT = decltype(tee(std::declval<T>(), 1));
+TEST_CASE("tee: has correct ctor and assign ops", "[tee]") {
+  REQUIRE(itertest::IsMoveConstructibleOnly<ImpT<std::vector<int>&>>::value);
+  REQUIRE(itertest::IsMoveConstructibleOnly<ImpT<std::vector<int>>>::value);
+}
@@ -0,0 +1,204 @@
+#include <cppitertools/chain.hpp>
+#include <cppitertools/enumerate.hpp>
+#include <cppitertools/filter.hpp>
+#include <cppitertools/imap.hpp>
+#include <cppitertools/range.hpp>
+#include <cppitertools/shuffled.hpp>
+#include <cppitertools/to.hpp>
+#include <cppitertools/zip.hpp>
+
+#include <deque>
+#include <list>
+#include <map>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "catch.hpp"
+#include "helpers.hpp"
+
+using iter::into;
+using iter::to;
+using Vec = const std::vector<int>;
+
+namespace {
+  // counts its copies
+  struct Counted {
+    static int copies;
+    int value;
+
+    Counted(int i) : value{i} {}
+    Counted(const Counted& other) : value{other.value} {
+      ++copies;
+    }
+    Counted(Counted&&) = default;
+    Counted& operator=(const Counted& other) {
+      value = other.value;
+      ++copies;
+      return *this;
+    }
+    Counted& operator=(Counted&&) = default;
+  };
+  int Counted::copies = 0;
+}
+
+TEST_CASE("to: a named container", "[to]") {
+  Vec v = {1, 2, 3};
+  auto l = v | to<std::list<int>>();
+  REQUIRE(l == std::list<int>{1, 2, 3});
+  auto d = to<std::deque<long>>(v);
+  REQUIRE(d == std::deque<long>{1, 2, 3});
+}
+
+TEST_CASE("to: a deduced container", "[to]") {
+  Vec v = {3, 1, 2, 1};
+  auto v2 = v | to<std::vector>();
+  static_assert(std::is_same_v<decltype(v2), std::vector<int>>);
+  REQUIRE(v2 == v);
+  auto s = to<std::set>(v);
+  static_assert(std::is_same_v<decltype(s), std::set<int>>);
+  REQUIRE(s == std::set<int>{1, 2, 3});
+}
+
+TEST_CASE("to: pairs and tuples collect values", "[to]") {
+  Vec v = {5, 6, 7};
+  auto zipped = iter::zip(v, v) | to<std::vector>();
+  static_assert(
+      std::is_same_v<decltype(zipped), std::vector<std::tuple<int, int>>>);
+  REQUIRE(zipped[1] == std::make_tuple(6, 6));
+
+  auto m = iter::enumerate(v) | to<std::map>();
+  static_assert(std::is_same_v<decltype(m), std::map<std::size_t, int>>);
+  REQUIRE(m == std::map<std::size_t, int>{{0, 5}, {1, 6}, {2, 7}});
+
+  auto um = iter::zip(v, iter::range(3)) | to<std::unordered_map>();
+  static_assert(std::is_same_v<decltype(um), std::unordered_map<int, int>>);
+  REQUIRE(um.at(7) == 2);
+
+  auto m2 = iter::zip(v, v) | to<std::map<int, long>>();
+  REQUIRE(m2.at(6) == 6);
+}
+
+TEST_CASE("to: reserves from the size hint", "[to]") {
+  auto v = iter::range(1000) | to<std::vector>();
+  REQUIRE(v.size() == 1000);
+  REQUIRE(v.capacity() == 1000);
+
+  Vec src = {1, 2, 3, 4, 5};
+  auto sq = iter::imap([](int i) { return i * i; }, src) | to<std::vector>();
+  REQUIRE(sq.capacity() == 5);
+  REQUIRE(sq == Vec{1, 4, 9, 16, 25});
+
+  auto odd = iter::filter([](int i) { return i % 2; }, src)
+             | to<std::vector>();
+  REQUIRE(odd == Vec{1, 3, 5});
+}
+
+TEST_CASE("to: moves values yielded by value", "[to]") {
+  Vec v = {1, 2, 3};
+  Counted::copies = 0;
+  auto c = iter::imap([](int i) { return Counted{i}; }, v)
+           | to<std::vector<Counted>>();
+  REQUIRE(c.size() == 3);
+  REQUIRE(c[2].value == 3);
+  REQUIRE(Counted::copies == 0);
+}
+
+TEST_CASE("to: contiguous elements and strings", "[to]") {
+  std::string s = "hello";
+  REQUIRE((s | to<std::string>()) == "hello");
+  REQUIRE((s | to<std::vector<char>>()).size() == 5);
+  int arr[] = {4, 5, 6};
+  REQUIRE((arr | to<std::vector>()) == Vec{4, 5, 6});
+  REQUIRE((iter::range(3) | to<std::string>()).size() == 3);
+}
+
+TEST_CASE("to: chain is walked with for_each", "[to]") {
+  Vec a = {1, 2};
+  const std::list<int> b = {3};
+  REQUIRE((iter::chain(a, b, a) | to<std::vector>()) == Vec{1, 2, 3, 1, 2});
+}
+
+TEST_CASE("to: input iterables and const adaptors", "[to]") {
+  itertest::InputIterable ii;
+  REQUIRE((ii | to<std::vector>()) == Vec{0, 1, 2, 3, 4});
+  itertest::BasicIterable<int> bi = {1, 2, 3};
+  REQUIRE((bi | to<std::vector<int>>()) == Vec{1, 2, 3});
+  Vec v = {1, 2};
+  const auto e = iter::enumerate(v);
+  REQUIRE((e | to<std::map>()).size() == 2);
+}
+
+TEST_CASE("into: appends to an existing container", "[into]") {
+  std::vector<int> v = {1};
+  auto& result = iter::range(2, 5) | into(v);
+  REQUIRE(&result == &v);
+  REQUIRE(v == Vec{1, 2, 3, 4});
+
+  std::set<int> s = {3};
+  Vec{1, 3, 5} | into(s);
+  REQUIRE(s == std::set<int>{1, 3, 5});
+}
+
+TEST_CASE("into: reserves geometrically when appending pieces", "[into]") {
+  std::vector<int> v;
+  for (int i = 0; i < 100; ++i) {
+    iter::range(10) | into(v);
+  }
+  REQUIRE(v.size() == 1000);
+  REQUIRE(v.capacity() < 2000);
+  v.shrink_to_fit();
+  std::size_t reallocations = 0;
+  auto capacity = v.capacity();
+  for (int i = 0; i < 100; ++i) {
+    iter::range(10) | into(v);
+    if (v.capacity() != capacity) {
+      ++reallocations;
+      capacity = v.capacity();
+    }
+  }
+  REQUIRE(reallocations < 10);
+}
+
+TEST_CASE("to: parallel collection", "[to]") {
+  iter::thread_pool pool{4};
+  auto par = iter::range(100000) | to<std::vector>(pool);
+  static_assert(std::is_same_v<decltype(par), std::vector<int>>);
+  REQUIRE(par == (iter::range(100000) | to<std::vector>()));
+
+  const auto order = iter::shuffled(par, 7) | to<std::vector<long>>(pool);
+  REQUIRE(order == (iter::shuffled(par, 7) | to<std::vector<long>>()));
+
+  std::vector<std::string> strs = {"a", "b", "c"};
+  auto copied = strs | to<std::deque<std::string>>(pool);
+  REQUIRE(copied == std::deque<std::string>{"a", "b", "c"});
+
+  auto empty = iter::range(0) | to<std::vector<int>>(pool);
+  REQUIRE(empty.empty());
+  auto few = iter::range(2) | to<std::vector<int>>(pool);
+  REQUIRE(few == Vec{0, 1});
+}
+
+TEST_CASE("to: parallel collection rethrows an element's exception", "[to]") {
+  struct Picky {
+    int value{};
+    Picky() = default;
+    Picky(int i) : value{i} {
+      if (i == 5000) {
+        throw std::runtime_error{"picky"};
+      }
+    }
+  };
+  iter::thread_pool pool{4};
+  REQUIRE_THROWS_AS(
+      iter::range(10000) | to<std::vector<Picky>>(pool), std::runtime_error);
+
+  // the pool is still usable afterwards
+  auto v = iter::range(10) | to<std::vector<Picky>>(pool);
+  REQUIRE(v.size() == 10);
+  REQUIRE(v[9].value == 9);
+}
@@ -1,3 +1,4 @@
+#include <cppitertools/imap.hpp>
 #include <cppitertools/unique_justseen.hpp>
 
 #include "helpers.hpp"
@@ -146,3 +147,31 @@ TEST_CASE("unique_justseen: works with key function", "[unique_justseen]") {
 
   REQUIRE(v == vc);
 }
+
+TEST_CASE("unique justseen: values returned by imap", "[unique_justseen]") {
+  Vec ns = {1, 1, 2, 2, 2, 3, 1};
+  int calls = 0;
+  auto m = iter::imap(
+      [&calls](int i) {
+        ++calls;
+        return i * 10;
+      },
+      ns);
+  auto uj = unique_justseen(m);
+  Vec v(std::begin(uj), std::end(uj));
+  Vec vc = {10, 20, 30, 10};
+  REQUIRE(v == vc);
+  REQUIRE(calls == static_cast<int>(ns.size()));
+
+  calls = 0;
+  auto ujs = unique_justseen(iter::imap(
+      [&calls](int i) {
+        ++calls;
+        return std::to_string(i);
+      },
+      ns));
+  std::vector<std::string> vs(std::begin(ujs), std::end(ujs));
+  std::vector<std::string> vsc = {"1", "2", "3", "1"};
+  REQUIRE(vs == vsc);
+  REQUIRE(calls == static_cast<int>(ns.size()));
+}